@@ -0,0 +1,104 @@
+#include <bench/bench.hpp>
+#include <djson/json.hpp>
+#include <fmt/format.h>
+#include <algorithm>
+#include <cstdio>
+#include <filesystem>
+#include <numeric>
+
+namespace bench {
+namespace {
+using Clock = std::chrono::steady_clock;
+
+// calibration never grows the batch by more than this factor at once.
+constexpr std::uint64_t max_growth_v{10};
+
+auto time_batch(std::function<void(std::uint64_t)> const& batch, std::uint64_t const iterations) -> std::chrono::duration<double> {
+	auto const start = Clock::now();
+	batch(iterations);
+	return Clock::now() - start;
+}
+} // namespace
+
+#if defined(_MSC_VER)
+#pragma optimize("", off)
+void escape(void const* ptr) { static_cast<void>(ptr); }
+#pragma optimize("", on)
+#else
+void escape(void const* ptr) { asm volatile("" : : "g"(ptr) : "memory"); }
+#endif
+
+auto Result::get_mib_per_second() const -> double {
+	if (bytes_per_op == 0 || median_ns <= 0.0) { return 0.0; }
+	return static_cast<double>(bytes_per_op) / (median_ns * 1e-9) / (1024.0 * 1024.0);
+}
+
+auto Runner::data_path(std::string_view const uri) const -> std::string { return (std::filesystem::path{m_options.data_dir} / uri).generic_string(); }
+
+auto Runner::is_selected(std::string_view const label) const -> bool {
+	if (m_options.filter.empty()) { return true; }
+	return fmt::format("{}/{}", m_bench, label).find(m_options.filter) != std::string::npos;
+}
+
+void Runner::run(std::string_view const label, Batch const& batch, std::uint64_t const bytes_per_op) {
+	auto result = Result{.name = fmt::format("{}/{}", m_bench, label), .bytes_per_op = bytes_per_op};
+
+	// calibrate: grow the batch until a single batch takes at least min_sample_time (this also warms up caches).
+	auto const target = m_options.min_sample_time.count();
+	auto iterations = std::uint64_t{1};
+	for (auto elapsed = time_batch(batch, iterations).count(); elapsed < target; elapsed = time_batch(batch, iterations).count()) {
+		auto const scale = elapsed > 0.0 ? static_cast<std::uint64_t>(1.2 * target / elapsed) + 1 : max_growth_v;
+		iterations *= std::clamp(scale, std::uint64_t{2}, max_growth_v);
+	}
+	result.iterations = iterations;
+
+	auto samples = std::vector<double>{};
+	samples.reserve(static_cast<std::size_t>(std::max(m_options.samples, 1)));
+	for (int i = 0; i < std::max(m_options.samples, 1); ++i) {
+		auto const elapsed = std::chrono::duration<double, std::nano>{time_batch(batch, iterations)};
+		samples.push_back(elapsed.count() / static_cast<double>(iterations));
+	}
+
+	std::sort(samples.begin(), samples.end());
+	auto const mid = samples.size() / 2;
+	result.min_ns = samples.front();
+	result.max_ns = samples.back();
+	result.median_ns = samples.size() % 2 == 0 ? 0.5 * (samples[mid - 1] + samples[mid]) : samples[mid];
+	result.mean_ns = std::accumulate(samples.begin(), samples.end(), 0.0) / static_cast<double>(samples.size());
+
+	if (bytes_per_op > 0) {
+		fmt::print(stderr, "  {:<48} {:>14.1f} ns/op {:>10.1f} MiB/s\n", result.name, result.median_ns, result.get_mib_per_second());
+	} else {
+		fmt::print(stderr, "  {:<48} {:>14.1f} ns/op\n", result.name, result.median_ns);
+	}
+	m_results.push_back(std::move(result));
+}
+
+auto Runner::to_json_string() const -> std::string {
+	auto json = dj::Json{};
+	json["samples"] = m_options.samples;
+	json["min_sample_time_ms"] = m_options.min_sample_time.count() * 1000.0;
+	auto& out_results = json["results"];
+	for (auto const& result : m_results) {
+		auto& out_result = out_results.push_back({});
+		out_result["name"] = result.name;
+		out_result["iterations"] = result.iterations;
+		out_result["min_ns"] = result.min_ns;
+		out_result["median_ns"] = result.median_ns;
+		out_result["mean_ns"] = result.mean_ns;
+		out_result["max_ns"] = result.max_ns;
+		if (result.bytes_per_op > 0) {
+			out_result["bytes_per_op"] = result.bytes_per_op;
+			out_result["mib_per_s"] = result.get_mib_per_second();
+		}
+	}
+	return to_string(json);
+}
+
+Bench::Bench() { get_benches().push_back(this); }
+
+auto Bench::get_benches() -> std::vector<Bench*>& {
+	static auto ret = std::vector<Bench*>{};
+	return ret;
+}
+} // namespace bench
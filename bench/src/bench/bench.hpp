@@ -0,0 +1,126 @@
+#pragma once
+#include <bave/core/ptr.hpp>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace bave {
+class DataStore;
+class RenderDevice;
+} // namespace bave
+
+namespace bench {
+/// \brief Opaque sink: prevents the compiler from eliding computation of a value.
+void escape(void const* ptr);
+
+template <typename Type>
+void do_not_optimize(Type const& value) {
+	escape(&value);
+}
+
+struct Options {
+	/// \brief Only measure benchmarks whose "<bench>/<label>" contains this string.
+	std::string filter{};
+	/// \brief Directory to load assets from.
+	std::string data_dir{};
+	/// \brief Minimum duration of each sample.
+	std::chrono::duration<double> min_sample_time{std::chrono::milliseconds{20}};
+	/// \brief Number of samples per benchmark.
+	int samples{10};
+};
+
+struct Result {
+	std::string name{};
+	std::uint64_t iterations{};
+	double min_ns{};
+	double median_ns{};
+	double mean_ns{};
+	double max_ns{};
+	std::uint64_t bytes_per_op{};
+
+	[[nodiscard]] auto get_mib_per_second() const -> double;
+};
+
+/// \brief Calibrates, samples and records measurements.
+class Runner {
+  public:
+	explicit Runner(Options options) : m_options(std::move(options)) {}
+
+	/// \brief Measure a callable.
+	/// \param label Label of measurement (unique within a bench).
+	/// \param func Callable to invoke once per iteration.
+	/// \param bytes_per_op Bytes processed per invocation, for throughput (0 to omit).
+	template <typename F>
+	void measure(std::string_view const label, F func, std::uint64_t const bytes_per_op = 0) {
+		if (!is_selected(label)) { return; }
+		run(label, [&func](std::uint64_t const iterations) {
+			for (std::uint64_t i = 0; i < iterations; ++i) { func(); }
+		}, bytes_per_op);
+	}
+
+	[[nodiscard]] auto get_options() const -> Options const& { return m_options; }
+	[[nodiscard]] auto get_results() const -> std::vector<Result> const& { return m_results; }
+
+	/// \brief Obtain the full path of an asset.
+	[[nodiscard]] auto data_path(std::string_view uri) const -> std::string;
+	/// \brief Obtain the RenderDevice (only set for device benches).
+	[[nodiscard]] auto get_render_device() const -> bave::Ptr<bave::RenderDevice> { return m_render_device; }
+	/// \brief Obtain the DataStore (only set for device benches).
+	[[nodiscard]] auto get_data_store() const -> bave::Ptr<bave::DataStore const> { return m_data_store; }
+
+	void set_bench(std::string_view name) { m_bench = name; }
+	void set_render_device(bave::Ptr<bave::RenderDevice> render_device) { m_render_device = render_device; }
+	void set_data_store(bave::Ptr<bave::DataStore const> data_store) { m_data_store = data_store; }
+
+	/// \brief Serialize results as JSON.
+	[[nodiscard]] auto to_json_string() const -> std::string;
+
+  private:
+	using Batch = std::function<void(std::uint64_t)>;
+
+	[[nodiscard]] auto is_selected(std::string_view label) const -> bool;
+	void run(std::string_view label, Batch const& batch, std::uint64_t bytes_per_op);
+
+	Options m_options{};
+	std::vector<Result> m_results{};
+	std::string_view m_bench{};
+	bave::Ptr<bave::RenderDevice> m_render_device{};
+	bave::Ptr<bave::DataStore const> m_data_store{};
+};
+
+/// \brief Base class for benches: instances register themselves on construction.
+class Bench {
+  public:
+	Bench();
+	Bench(Bench const&) = default;
+	Bench(Bench&&) = default;
+	auto operator=(Bench const&) -> Bench& = default;
+	auto operator=(Bench&&) -> Bench& = default;
+
+	virtual ~Bench() = default;
+
+	[[nodiscard]] virtual auto get_name() const -> std::string_view = 0;
+	/// \brief Whether this bench needs a RenderDevice (run inside a HeadlessApp).
+	[[nodiscard]] virtual auto needs_device() const -> bool { return false; }
+	virtual void run(Runner& runner) const = 0;
+
+	[[nodiscard]] static auto get_benches() -> std::vector<Bench*>&;
+};
+} // namespace bench
+
+// NOLINTNEXTLINE(cppcoreguidelines-macro-usage)
+#define ADD_BENCH_IMPL(Class, device)                                                                                                                          \
+	struct Bench_##Class : ::bench::Bench {                                                                                                                    \
+		void run(::bench::Runner& runner) const final;                                                                                                         \
+		auto get_name() const -> std::string_view final { return #Class; }                                                                                     \
+		auto needs_device() const -> bool final { return device; }                                                                                             \
+	};                                                                                                                                                         \
+	inline Bench_##Class const g_bench_##Class{};                                                                                                              \
+	inline void Bench_##Class::run([[maybe_unused]] ::bench::Runner& runner) const
+
+#define ADD_BENCH(Class) ADD_BENCH_IMPL(Class, false)		 // NOLINT(cppcoreguidelines-macro-usage)
+#define ADD_DEVICE_BENCH(Class) ADD_BENCH_IMPL(Class, true) // NOLINT(cppcoreguidelines-macro-usage)
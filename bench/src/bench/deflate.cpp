@@ -0,0 +1,126 @@
+#include <bench/deflate.hpp>
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <utility>
+
+namespace bench {
+namespace {
+constexpr std::size_t min_match_v{3};
+constexpr std::size_t max_match_v{258};
+constexpr std::size_t window_v{32 * 1024};
+constexpr std::size_t hash_bits_v{15};
+
+// RFC 1951 3.2.5: base values and extra bits of length / distance codes.
+constexpr auto length_base_v = std::array<std::uint16_t, 29>{
+	3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31, 35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258,
+};
+constexpr auto length_extra_v = std::array<std::uint8_t, 29>{0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2, 3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0};
+constexpr auto distance_base_v = std::array<std::uint16_t, 30>{
+	1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193, 257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145, 8193, 12289, 16385, 24577,
+};
+constexpr auto distance_extra_v = std::array<std::uint8_t, 30>{0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6, 7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13};
+
+class BitWriter {
+  public:
+	// LSB first.
+	void put_bits(std::uint32_t const value, std::uint32_t const count) {
+		m_buffer |= value << m_count;
+		m_count += count;
+		while (m_count >= 8) {
+			m_bytes.push_back(static_cast<std::byte>(m_buffer & 0xff));
+			m_buffer >>= 8;
+			m_count -= 8;
+		}
+	}
+
+	// Huffman codes are packed MSB first.
+	void put_code(std::uint32_t const code, std::uint32_t const length) {
+		auto reversed = std::uint32_t{};
+		for (std::uint32_t i = 0; i < length; ++i) { reversed |= ((code >> i) & 1u) << (length - 1 - i); }
+		put_bits(reversed, length);
+	}
+
+	void put_symbol(std::uint32_t const symbol) {
+		if (symbol < 144) {
+			put_code(0x30 + symbol, 8);
+		} else if (symbol < 256) {
+			put_code(0x190 + symbol - 144, 9);
+		} else if (symbol < 280) {
+			put_code(symbol - 256, 7);
+		} else {
+			put_code(0xc0 + symbol - 280, 8);
+		}
+	}
+
+	[[nodiscard]] auto finish() -> std::vector<std::byte> {
+		if (m_count > 0) { m_bytes.push_back(static_cast<std::byte>(m_buffer & 0xff)); }
+		m_buffer = m_count = 0;
+		return std::move(m_bytes);
+	}
+
+  private:
+	std::vector<std::byte> m_bytes{};
+	std::uint32_t m_buffer{};
+	std::uint32_t m_count{};
+};
+
+template <std::size_t Size>
+auto find_code(std::array<std::uint16_t, Size> const& base, std::size_t const value) -> std::size_t {
+	auto const it = std::upper_bound(base.begin(), base.end(), value);
+	return static_cast<std::size_t>(it - base.begin()) - 1;
+}
+
+auto hash(std::span<std::byte const> data, std::size_t const index) -> std::size_t {
+	auto const value = std::to_integer<std::uint32_t>(data[index]) | std::to_integer<std::uint32_t>(data[index + 1]) << 8 |
+					   std::to_integer<std::uint32_t>(data[index + 2]) << 16;
+	return (value * 2654435761u) >> (32 - hash_bits_v);
+}
+} // namespace
+
+auto deflate(std::span<std::byte const> data) -> std::vector<std::byte> {
+	auto writer = BitWriter{};
+	writer.put_bits(1, 1); // final block
+	writer.put_bits(1, 2); // fixed Huffman codes
+
+	// most recent position + 1 of each hash (0: none).
+	auto heads = std::vector<std::size_t>(std::size_t{1} << hash_bits_v);
+	auto const insert = [&](std::size_t const index) {
+		if (index + min_match_v > data.size()) { return std::size_t{}; }
+		auto& head = heads[hash(data, index)];
+		auto const ret = head;
+		head = index + 1;
+		return ret;
+	};
+
+	for (std::size_t i = 0; i < data.size();) {
+		auto length = std::size_t{};
+		auto const candidate = insert(i);
+		if (candidate > 0 && i - (candidate - 1) <= window_v) {
+			auto const match = candidate - 1;
+			auto const max_length = std::min(max_match_v, data.size() - i);
+			while (length < max_length && data[match + length] == data[i + length]) { ++length; }
+		}
+
+		if (length < min_match_v) {
+			writer.put_symbol(std::to_integer<std::uint32_t>(data[i]));
+			++i;
+			continue;
+		}
+
+		auto const length_code = find_code(length_base_v, length);
+		writer.put_symbol(static_cast<std::uint32_t>(257 + length_code));
+		writer.put_bits(static_cast<std::uint32_t>(length - length_base_v[length_code]), length_extra_v[length_code]);
+		auto const distance = i - (candidate - 1);
+		auto const distance_code = find_code(distance_base_v, distance);
+		writer.put_code(static_cast<std::uint32_t>(distance_code), 5);
+		writer.put_bits(static_cast<std::uint32_t>(distance - distance_base_v[distance_code]), distance_extra_v[distance_code]);
+
+		for (std::size_t j = 1; j < length; ++j) { insert(i + j); }
+		i += length;
+	}
+
+	writer.put_symbol(256); // end of block
+	return writer.finish();
+}
+} // namespace bench
@@ -0,0 +1,11 @@
+#pragma once
+#include <cstddef>
+#include <span>
+#include <vector>
+
+namespace bench {
+/// \brief Compress data into a raw DEFLATE stream (RFC 1951), for generating bench inputs.
+///
+/// Single block with fixed Huffman codes and greedy LZ77 matching: fast and simple rather than small.
+[[nodiscard]] auto deflate(std::span<std::byte const> data) -> std::vector<std::byte>;
+} // namespace bench
@@ -0,0 +1,42 @@
+#include <bave/core/timer.hpp>
+#include <bave/graphics/rgba.hpp>
+#include <bench/bench.hpp>
+#include <fmt/format.h>
+
+namespace {
+using namespace bave;
+
+ADD_BENCH(Rgba) {
+	auto srgb = glm::vec4{0.5f, 0.25f, 0.75f, 1.0f};
+	runner.measure("to_linear", [&] {
+		srgb.x = srgb.x > 0.99f ? 0.0f : srgb.x + 0.001f;
+		auto const linear = Rgba::to_linear(srgb);
+		bench::do_not_optimize(linear);
+	});
+	runner.measure("to_srgb", [&] {
+		srgb.x = srgb.x > 0.99f ? 0.0f : srgb.x + 0.001f;
+		auto const ret = Rgba::to_srgb(srgb);
+		bench::do_not_optimize(ret);
+	});
+}
+
+ADD_BENCH(Timer) {
+	auto fired = std::size_t{};
+	auto const callback = [&fired] { ++fired; };
+
+	// steady state: N pending entries, none of which fire.
+	for (auto const count : {10, 1000}) {
+		auto timer = Timer{};
+		for (int i = 0; i < count; ++i) { timer.schedule_after(Seconds{1e9f}, callback); }
+		runner.measure(fmt::format("tick_pending_x{}", count), [&] { timer.tick(Seconds{1.0f / 60.0f}); });
+	}
+
+	// churn: schedule and fire one callback per tick.
+	auto timer = Timer{};
+	runner.measure("schedule_tick_fire", [&] {
+		timer.schedule_after(1, callback);
+		timer.tick(Seconds{1.0f / 60.0f});
+	});
+	bench::do_not_optimize(fired);
+}
+} // namespace
@@ -0,0 +1,74 @@
+#include <bave/graphics/geometry.hpp>
+#include <bave/graphics/render_instance.hpp>
+#include <bench/bench.hpp>
+#include <fmt/format.h>
+
+namespace {
+using namespace bave;
+
+template <typename ShapeT>
+void measure_append(bench::Runner& runner, std::string_view const label, ShapeT const& shape) {
+	auto vertex_array = VertexArray{};
+	runner.measure(label, [&] {
+		vertex_array.vertices.clear();
+		vertex_array.indices.clear();
+		vertex_array.append(shape);
+		bench::do_not_optimize(vertex_array.vertices.data());
+	});
+}
+
+ADD_BENCH(VertexArray) {
+	measure_append(runner, "append_quad", Quad{});
+	measure_append(runner, "append_circle", Circle{});
+	measure_append(runner, "append_circle_16", Circle{.resolution = 16});
+	measure_append(runner, "append_rounded_quad", RoundedQuad{});
+	measure_append(runner, "append_nine_quad", NineQuad{});
+	measure_append(runner, "append_line_rect", LineRect{});
+
+	// batching: many shapes into one array, as a tile map / text mesh would.
+	auto vertex_array = VertexArray{};
+	runner.measure("append_quad_x1000", [&] {
+		vertex_array.vertices.clear();
+		vertex_array.indices.clear();
+		for (int i = 0; i < 1000; ++i) { vertex_array.append(Quad{.origin = {static_cast<float>(i), 0.0f}}); }
+		bench::do_not_optimize(vertex_array.vertices.data());
+	});
+}
+
+ADD_BENCH(Geometry) {
+	runner.measure("from_circle", [] {
+		auto const geometry = Circle{}.to_geometry();
+		bench::do_not_optimize(geometry);
+	});
+	runner.measure("from_rounded_quad", [] {
+		auto const geometry = RoundedQuad{}.to_geometry();
+		bench::do_not_optimize(geometry);
+	});
+}
+
+ADD_BENCH(Transform) {
+	auto transform = Transform{.position = {100.0f, -50.0f}, .rotation = Degrees{30.0f}, .scale = {2.0f, 0.5f}};
+	runner.measure("matrix", [&] {
+		transform.rotation.value += 0.001f;
+		auto const matrix = transform.matrix();
+		bench::do_not_optimize(matrix);
+	});
+}
+
+ADD_BENCH(RenderInstance) {
+	for (auto const count : {std::size_t{1}, std::size_t{100}, std::size_t{10'000}}) {
+		auto instances = std::vector<RenderInstance>(count);
+		for (std::size_t i = 0; i < count; ++i) {
+			instances[i].transform.position = {static_cast<float>(i), 0.0f};
+			instances[i].tint = Rgba{.channels = {0xff, 0x80, static_cast<std::uint8_t>(i), 0xff}};
+		}
+		auto baked = std::vector<RenderInstance::Baked>{};
+		auto const parent = glm::identity<glm::mat4>();
+		runner.measure(fmt::format("fill_baked_x{}", count), [&] {
+			baked.clear();
+			RenderInstance::fill_baked(baked, instances, parent);
+			bench::do_not_optimize(baked.data());
+		}, count * sizeof(RenderInstance::Baked));
+	}
+}
+} // namespace
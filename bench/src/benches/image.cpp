@@ -0,0 +1,318 @@
+#include <bave/graphics/image_decoder.hpp>
+#include <bave/graphics/image_file.hpp>
+#include <bave/io/file_io.hpp>
+#include <bench/bench.hpp>
+#include <bench/deflate.hpp>
+#include <fmt/format.h>
+#include <algorithm>
+#include <array>
+#include <cstdlib>
+#include <filesystem>
+#include <memory>
+
+namespace {
+using namespace bave;
+
+// encodes RGBA pixels as QOI, so QoiDecoder can be measured on the same images as the PNG decoders.
+auto encode_qoi(BitmapView const& bitmap) -> std::vector<std::byte> {
+	struct Pixel {
+		std::uint8_t r{};
+		std::uint8_t g{};
+		std::uint8_t b{};
+		std::uint8_t a{};
+
+		auto operator==(Pixel const&) const -> bool = default;
+		[[nodiscard]] auto hash() const -> std::uint8_t { return static_cast<std::uint8_t>((r * 3 + g * 5 + b * 7 + a * 11) % 64); }
+	};
+
+	auto ret = std::vector<std::byte>{};
+	auto const put = [&ret](int const value) { ret.push_back(static_cast<std::byte>(value)); };
+	auto const put_u32_be = [&put](std::uint32_t const value) {
+		for (int shift = 24; shift >= 0; shift -= 8) { put(static_cast<int>((value >> shift) & 0xff)); }
+	};
+
+	for (auto const c : std::string_view{"qoif"}) { put(c); }
+	put_u32_be(static_cast<std::uint32_t>(bitmap.extent.x));
+	put_u32_be(static_cast<std::uint32_t>(bitmap.extent.y));
+	put(4);
+	put(0);
+
+	auto index = std::array<Pixel, 64>{};
+	auto prev = Pixel{.a = 0xff};
+	auto run = 0;
+	auto const count = bitmap.bytes.size() / 4;
+	for (std::size_t i = 0; i < count; ++i) {
+		auto const in = bitmap.bytes.subspan(i * 4, 4);
+		auto const pixel = Pixel{std::to_integer<std::uint8_t>(in[0]), std::to_integer<std::uint8_t>(in[1]), std::to_integer<std::uint8_t>(in[2]),
+								 std::to_integer<std::uint8_t>(in[3])};
+		if (pixel == prev) {
+			if (++run == 62 || i + 1 == count) {
+				put(0xc0 | (run - 1));
+				run = 0;
+			}
+			continue;
+		}
+		if (run > 0) {
+			put(0xc0 | (run - 1));
+			run = 0;
+		}
+
+		auto const hash = pixel.hash();
+		if (index.at(hash) == pixel) {
+			put(hash);
+			prev = pixel;
+			continue;
+		}
+
+		index.at(hash) = pixel;
+		if (pixel.a != prev.a) {
+			put(0xff);
+			put(pixel.r);
+			put(pixel.g);
+			put(pixel.b);
+			put(pixel.a);
+		} else {
+			auto const dr = static_cast<std::int8_t>(pixel.r - prev.r);
+			auto const dg = static_cast<std::int8_t>(pixel.g - prev.g);
+			auto const db = static_cast<std::int8_t>(pixel.b - prev.b);
+			auto const dr_dg = dr - dg;
+			auto const db_dg = db - dg;
+			if (dr >= -2 && dr <= 1 && dg >= -2 && dg <= 1 && db >= -2 && db <= 1) {
+				put(0x40 | (dr + 2) << 4 | (dg + 2) << 2 | (db + 2));
+			} else if (dg >= -32 && dg <= 31 && dr_dg >= -8 && dr_dg <= 7 && db_dg >= -8 && db_dg <= 7) {
+				put(0x80 | (dg + 32));
+				put((dr_dg + 8) << 4 | (db_dg + 8));
+			} else {
+				put(0xfe);
+				put(pixel.r);
+				put(pixel.g);
+				put(pixel.b);
+			}
+		}
+		prev = pixel;
+	}
+
+	for (int i = 0; i < 7; ++i) { put(0); }
+	put(1);
+	return ret;
+}
+
+auto crc32(std::span<std::byte const> bytes, std::uint32_t crc = 0) -> std::uint32_t {
+	static auto const table = [] {
+		auto ret = std::array<std::uint32_t, 256>{};
+		for (std::uint32_t i = 0; i < ret.size(); ++i) {
+			auto value = i;
+			for (int k = 0; k < 8; ++k) { value = (value & 1u) != 0 ? 0xedb88320u ^ (value >> 1) : value >> 1; }
+			ret.at(i) = value;
+		}
+		return ret;
+	}();
+	crc = ~crc;
+	for (auto const byte : bytes) { crc = table.at((crc ^ std::to_integer<std::uint32_t>(byte)) & 0xff) ^ (crc >> 8); }
+	return ~crc;
+}
+
+auto adler32(std::span<std::byte const> bytes) -> std::uint32_t {
+	auto a = std::uint32_t{1};
+	auto b = std::uint32_t{};
+	for (auto const byte : bytes) {
+		a = (a + std::to_integer<std::uint32_t>(byte)) % 65521;
+		b = (b + a) % 65521;
+	}
+	return b << 16 | a;
+}
+
+auto paeth(int const a, int const b, int const c) -> int {
+	auto const p = a + b - c;
+	auto const pa = std::abs(p - a);
+	auto const pb = std::abs(p - b);
+	auto const pc = std::abs(p - c);
+	if (pa <= pb && pa <= pc) { return a; }
+	if (pb <= pc) { return b; }
+	return c;
+}
+
+// encodes 8-bit RGBA (or palette indices if palette is not empty) as a non-interlaced PNG.
+// rows cycle through all filter types, so every unfilter kernel is measured.
+auto encode_png(std::span<std::byte const> pixels, glm::ivec2 const extent, std::span<std::byte const> palette = {}) -> std::vector<std::byte> {
+	auto const channels = palette.empty() ? std::size_t{4} : std::size_t{1};
+	auto const width = static_cast<std::size_t>(extent.x);
+	auto const height = static_cast<std::size_t>(extent.y);
+	auto const stride = width * channels;
+
+	auto filtered = std::vector<std::byte>{};
+	filtered.reserve(height * (stride + 1));
+	auto const zeroes = std::vector<std::byte>(stride);
+	for (std::size_t y = 0; y < height; ++y) {
+		auto const row = pixels.subspan(y * stride, stride);
+		auto const prev = y == 0 ? std::span<std::byte const>{zeroes} : pixels.subspan((y - 1) * stride, stride);
+		auto const filter = static_cast<int>(y % 5);
+		filtered.push_back(static_cast<std::byte>(filter));
+		for (std::size_t i = 0; i < stride; ++i) {
+			auto const x = std::to_integer<int>(row[i]);
+			auto const a = i >= channels ? std::to_integer<int>(row[i - channels]) : 0;
+			auto const b = std::to_integer<int>(prev[i]);
+			auto const c = i >= channels ? std::to_integer<int>(prev[i - channels]) : 0;
+			auto predicted = 0;
+			switch (filter) {
+			case 1: predicted = a; break;
+			case 2: predicted = b; break;
+			case 3: predicted = (a + b) / 2; break;
+			case 4: predicted = paeth(a, b, c); break;
+			default: break;
+			}
+			filtered.push_back(static_cast<std::byte>((x - predicted) & 0xff));
+		}
+	}
+
+	auto ret = std::vector<std::byte>{};
+	auto const put = [&ret](int const value) { ret.push_back(static_cast<std::byte>(value)); };
+	auto const put_u32_be = [&put](std::uint32_t const value) {
+		for (int shift = 24; shift >= 0; shift -= 8) { put(static_cast<int>((value >> shift) & 0xff)); }
+	};
+	auto const put_chunk = [&](std::string_view const type, std::span<std::byte const> data) {
+		put_u32_be(static_cast<std::uint32_t>(data.size()));
+		auto const start = ret.size();
+		for (auto const c : type) { put(c); }
+		ret.insert(ret.end(), data.begin(), data.end());
+		put_u32_be(crc32(std::span{ret}.subspan(start)));
+	};
+
+	for (auto const c : std::string_view{"\x89PNG\r\n\x1a\n"}) { put(c); }
+
+	auto header = std::vector<std::byte>{};
+	for (auto const value : {extent.x, extent.y}) {
+		for (int shift = 24; shift >= 0; shift -= 8) { header.push_back(static_cast<std::byte>((value >> shift) & 0xff)); }
+	}
+	// bit depth, colour type, compression, filter, interlace.
+	for (auto const value : {8, palette.empty() ? 6 : 3, 0, 0, 0}) { header.push_back(static_cast<std::byte>(value)); }
+	put_chunk("IHDR", header);
+	if (!palette.empty()) { put_chunk("PLTE", palette); }
+
+	// zlib stream: header (deflate, 32K window, fastest), raw deflate, adler32 of uncompressed data.
+	auto idat = std::vector<std::byte>{std::byte{0x78}, std::byte{0x01}};
+	auto const deflated = bench::deflate(filtered);
+	idat.insert(idat.end(), deflated.begin(), deflated.end());
+	auto const checksum = adler32(filtered);
+	for (int shift = 24; shift >= 0; shift -= 8) { idat.push_back(static_cast<std::byte>((checksum >> shift) & 0xff)); }
+	put_chunk("IDAT", idat);
+	put_chunk("IEND", {});
+	return ret;
+}
+
+struct Input {
+	std::string name{};
+	std::vector<std::byte> png{};
+	std::vector<std::byte> qoi{};
+	// throughput is reported in decoded (RGBA) bytes.
+	std::size_t decoded_bytes{};
+};
+
+constexpr auto generated_extent_v = glm::ivec2{3840, 2160};
+
+// cheap deterministic noise.
+auto noise(std::size_t const x, std::size_t const y) -> std::uint32_t {
+	auto ret = static_cast<std::uint32_t>(x * 374761393u + y * 668265263u);
+	ret = (ret ^ (ret >> 13)) * 1274126177u;
+	return ret ^ (ret >> 16);
+}
+
+// gradients with noise in the low bits and a few alpha regions: somewhere between flat art and photos.
+auto make_rgba_4k() -> Input {
+	auto const width = static_cast<std::size_t>(generated_extent_v.x);
+	auto const height = static_cast<std::size_t>(generated_extent_v.y);
+	auto pixels = std::vector<std::byte>(width * height * 4);
+	for (std::size_t y = 0; y < height; ++y) {
+		for (std::size_t x = 0; x < width; ++x) {
+			auto const n = noise(x, y);
+			auto const pixel = std::span{pixels}.subspan((y * width + x) * 4, 4);
+			pixel[0] = static_cast<std::byte>((x * 255 / width) ^ (n & 0x07));
+			pixel[1] = static_cast<std::byte>((y * 255 / height) ^ ((n >> 3) & 0x07));
+			pixel[2] = static_cast<std::byte>(((x + y) / 8) & 0xff);
+			pixel[3] = static_cast<std::byte>(((x / 256 + y / 256) % 4 == 0) ? 0x80 : 0xff);
+		}
+	}
+	auto const bitmap = BitmapView{.bytes = pixels, .extent = generated_extent_v};
+	return Input{.name = "rgba_4k", .png = encode_png(pixels, generated_extent_v), .qoi = encode_qoi(bitmap), .decoded_bytes = pixels.size()};
+}
+
+// 256 colour tiles with noisy edges, like pixel art / indexed sprite sheets.
+auto make_paletted_4k() -> Input {
+	auto const width = static_cast<std::size_t>(generated_extent_v.x);
+	auto const height = static_cast<std::size_t>(generated_extent_v.y);
+	auto palette = std::vector<std::byte>(256 * 3);
+	for (std::size_t i = 0; i < palette.size(); ++i) { palette[i] = static_cast<std::byte>(noise(i, 0) & 0xff); }
+
+	auto indices = std::vector<std::byte>(width * height);
+	auto rgba = std::vector<std::byte>(width * height * 4);
+	for (std::size_t y = 0; y < height; ++y) {
+		for (std::size_t x = 0; x < width; ++x) {
+			auto const n = noise(x, y);
+			auto const index = (x / 16 + (y / 16) * 7 + ((n & 0x0f) == 0 ? 1 : 0)) & 0xff;
+			indices[y * width + x] = static_cast<std::byte>(index);
+			auto const pixel = std::span{rgba}.subspan((y * width + x) * 4, 4);
+			std::copy_n(palette.begin() + static_cast<std::ptrdiff_t>(index * 3), 3, pixel.begin());
+			pixel[3] = std::byte{0xff};
+		}
+	}
+	auto const bitmap = BitmapView{.bytes = rgba, .extent = generated_extent_v};
+	return Input{.name = "paletted_4k", .png = encode_png(indices, generated_extent_v, palette), .qoi = encode_qoi(bitmap), .decoded_bytes = rgba.size()};
+}
+
+// all PNGs in images/, sorted by name.
+auto load_inputs(bench::Runner const& runner) -> std::vector<Input> {
+	auto ret = std::vector<Input>{};
+	auto const dir = std::filesystem::path{runner.data_path("images")};
+	auto ec = std::error_code{};
+	if (!std::filesystem::is_directory(dir, ec)) {
+		fmt::print(stderr, "  skipped: '{}' not found\n", dir.generic_string());
+		return ret;
+	}
+
+	auto paths = std::vector<std::filesystem::path>{};
+	for (auto const& entry : std::filesystem::directory_iterator{dir, ec}) {
+		if (entry.is_regular_file() && entry.path().extension() == ".png") { paths.push_back(entry.path()); }
+	}
+	std::sort(paths.begin(), paths.end());
+
+	for (auto const& path : paths) {
+		auto input = Input{.name = path.stem().string()};
+		if (!file::read_bytes(input.png, path.string().c_str())) { continue; }
+		auto image = ImageFile{};
+		if (!image.load_from_bytes(std::span<std::byte const>{input.png})) { continue; }
+		auto const bitmap = image.get_bitmap_view();
+		input.qoi = encode_qoi(bitmap);
+		input.decoded_bytes = bitmap.bytes.size();
+		ret.push_back(std::move(input));
+	}
+	return ret;
+}
+
+ADD_BENCH(ImageDecoder) {
+	auto const png = PngDecoder{};
+	auto const qoi = QoiDecoder{};
+	auto const stb = StbDecoder{};
+
+	auto inputs = load_inputs(runner);
+	inputs.push_back(make_rgba_4k());
+	inputs.push_back(make_paletted_4k());
+
+	for (auto const& input : inputs) {
+		auto const measure = [&](IImageDecoder const& decoder, std::span<std::byte const> encoded) {
+			if (!decoder.can_decode(encoded)) { return; }
+			if (!decoder.decode(encoded)) {
+				fmt::print(stderr, "  {}: failed to decode '{}'\n", decoder.get_name(), input.name);
+				return;
+			}
+			runner.measure(fmt::format("{}_{}", decoder.get_name(), input.name), [&] {
+				auto const result = decoder.decode(encoded);
+				bench::do_not_optimize(result.get());
+			}, input.decoded_bytes);
+		};
+		measure(png, input.png);
+		measure(stb, input.png);
+		measure(qoi, input.qoi);
+		fmt::print(stderr, "    {}: png: {} KiB, qoi: {} KiB\n", input.name, input.png.size() / 1024, input.qoi.size() / 1024);
+	}
+}
+} // namespace
@@ -0,0 +1,264 @@
+#include <bave/io/bundle.hpp>
+#include <bave/io/file_io.hpp>
+#include <bave/io/file_loader.hpp>
+#include <bave/io/zip_io.hpp>
+#include <bench/bench.hpp>
+#include <bench/deflate.hpp>
+#include <fmt/format.h>
+#include <algorithm>
+#include <array>
+#include <filesystem>
+#include <thread>
+
+namespace {
+using namespace bave;
+namespace fs = std::filesystem;
+
+constexpr std::size_t entry_count_v{64};
+constexpr std::size_t entry_size_v{64 * 1024};
+// roughly the size of a game's asset archive: small JSON / shaders and larger images.
+constexpr std::size_t zip_entry_count_v{500};
+
+auto make_payload(std::size_t const size, std::size_t const seed) -> std::vector<std::byte> {
+	auto ret = std::vector<std::byte>(size);
+	for (std::size_t i = 0; i < size; ++i) { ret[i] = static_cast<std::byte>((i * 31 + seed) & 0xff); }
+	return ret;
+}
+
+// compressible, text-like payload (JSON, GLSL, etc).
+auto make_text(std::size_t const size, std::size_t const seed) -> std::vector<std::byte> {
+	static constexpr auto words_v = std::array<std::string_view, 8>{"\"name\": ", "\"value\", ", "1.0, ", "vec4 ", "uniform ", "texture", "{\n\t", "}\n"};
+	auto ret = std::vector<std::byte>{};
+	ret.reserve(size);
+	auto state = static_cast<std::uint32_t>(seed);
+	while (ret.size() < size) {
+		state = state * 1664525u + 1013904223u;
+		for (auto const c : words_v.at((state >> 16) % words_v.size())) { ret.push_back(static_cast<std::byte>(c)); }
+	}
+	ret.resize(size);
+	return ret;
+}
+
+auto make_uri(std::size_t const index) -> std::string { return fmt::format("bench/entry_{:03}.bin", index); }
+
+/// \brief Minimal writer for ZIP archives with stored or deflated entries (CRCs are not verified by bave::zip).
+class ZipWriter {
+  public:
+	void add(std::string_view const name, std::span<std::byte const> data, bool const compress) {
+		auto const compressed = compress ? bench::deflate(data) : std::vector<std::byte>{};
+		auto const payload = compress ? std::span<std::byte const>{compressed} : data;
+		auto const method = compress ? std::uint16_t{8} : std::uint16_t{0};
+
+		auto const local_offset = m_bytes.size();
+		put_u32(m_bytes, 0x04034b50);
+		put_u16(m_bytes, 20); // version needed
+		put_u16(m_bytes, 0);  // flags
+		put_u16(m_bytes, method);
+		put_u32(m_bytes, 0); // time, date
+		put_u32(m_bytes, 0); // crc
+		put_u32(m_bytes, static_cast<std::uint32_t>(payload.size()));
+		put_u32(m_bytes, static_cast<std::uint32_t>(data.size()));
+		put_u16(m_bytes, static_cast<std::uint16_t>(name.size()));
+		put_u16(m_bytes, 0); // extra
+		put_string(m_bytes, name);
+		m_bytes.insert(m_bytes.end(), payload.begin(), payload.end());
+
+		put_u32(m_central, 0x02014b50);
+		put_u16(m_central, 20); // version made by
+		put_u16(m_central, 20); // version needed
+		put_u16(m_central, 0);	// flags
+		put_u16(m_central, method);
+		put_u32(m_central, 0); // time, date
+		put_u32(m_central, 0); // crc
+		put_u32(m_central, static_cast<std::uint32_t>(payload.size()));
+		put_u32(m_central, static_cast<std::uint32_t>(data.size()));
+		put_u16(m_central, static_cast<std::uint16_t>(name.size()));
+		put_u16(m_central, 0); // extra
+		put_u16(m_central, 0); // comment
+		put_u16(m_central, 0); // disk
+		put_u16(m_central, 0); // internal attributes
+		put_u32(m_central, 0); // external attributes
+		put_u32(m_central, static_cast<std::uint32_t>(local_offset));
+		put_string(m_central, name);
+		++m_count;
+	}
+
+	[[nodiscard]] auto build() const -> std::vector<std::byte> {
+		auto ret = m_bytes;
+		ret.insert(ret.end(), m_central.begin(), m_central.end());
+		put_u32(ret, 0x06054b50);
+		put_u16(ret, 0); // disk
+		put_u16(ret, 0); // central directory disk
+		put_u16(ret, m_count);
+		put_u16(ret, m_count);
+		put_u32(ret, static_cast<std::uint32_t>(m_central.size()));
+		put_u32(ret, static_cast<std::uint32_t>(m_bytes.size()));
+		put_u16(ret, 0); // comment
+		return ret;
+	}
+
+  private:
+	static void put_u16(std::vector<std::byte>& out, std::uint16_t const value) {
+		out.push_back(static_cast<std::byte>(value & 0xff));
+		out.push_back(static_cast<std::byte>(value >> 8));
+	}
+
+	static void put_u32(std::vector<std::byte>& out, std::uint32_t const value) {
+		for (std::uint32_t i = 0; i < 4; ++i) { out.push_back(static_cast<std::byte>((value >> (i * 8)) & 0xff)); }
+	}
+
+	static void put_string(std::vector<std::byte>& out, std::string_view const str) {
+		for (auto const c : str) { out.push_back(static_cast<std::byte>(c)); }
+	}
+
+	std::vector<std::byte> m_bytes{};
+	std::vector<std::byte> m_central{};
+	std::uint16_t m_count{};
+};
+
+// reads count entries, split across thread_count threads.
+template <typename F>
+void read_all(std::size_t const thread_count, std::size_t const count, F const& read_entry) {
+	if (thread_count <= 1) {
+		for (std::size_t i = 0; i < count; ++i) { read_entry(i); }
+		return;
+	}
+	auto threads = std::vector<std::thread>{};
+	threads.reserve(thread_count);
+	for (std::size_t t = 0; t < thread_count; ++t) {
+		threads.emplace_back([t, thread_count, count, &read_entry] {
+			for (std::size_t i = t; i < count; i += thread_count) { read_entry(i); }
+		});
+	}
+	for (auto& thread : threads) { thread.join(); }
+}
+
+ADD_BENCH(FileLoader) {
+	auto const dir = fs::temp_directory_path() / "bave-bench";
+	auto const sizes = std::array{std::size_t{4 * 1024}, std::size_t{256 * 1024}, std::size_t{16 * 1024 * 1024}};
+	for (auto const size : sizes) {
+		auto const uri = fmt::format("file_{}k.bin", size / 1024);
+		if (!file::write_bytes((dir / uri).string().c_str(), make_payload(size, size))) {
+			fmt::print(stderr, "  skipped: failed to write '{}'\n", (dir / uri).string());
+			return;
+		}
+	}
+
+	auto const file_loader = FileLoader{dir.string()};
+	auto const& loader = static_cast<IDataLoader const&>(file_loader);
+	for (auto const size : sizes) {
+		auto const uri = fmt::format("file_{}k.bin", size / 1024);
+		auto bytes = std::vector<std::byte>{};
+		runner.measure(fmt::format("read_bytes_{}k", size / 1024), [&] {
+			bytes.clear();
+			static_cast<void>(loader.read_bytes(bytes, uri));
+			bench::do_not_optimize(bytes.data());
+		}, size);
+		// touch every page, so mapping isn't measured as free.
+		runner.measure(fmt::format("map_{}k", size / 1024), [&] {
+			auto const view = loader.map(uri);
+			auto sum = std::byte{};
+			for (std::size_t i = 0; i < view.get_size(); i += 4096) { sum ^= view.get_bytes()[i]; }
+			bench::do_not_optimize(sum);
+		}, size);
+	}
+
+	std::error_code ec{};
+	fs::remove_all(dir, ec);
+}
+
+ADD_BENCH(Zip) {
+	// every third entry is stored (already compressed images, etc), the rest are deflated; sizes range from 1 to 32 KiB.
+	auto zip = ZipWriter{};
+	auto stored = std::vector<std::string>{};
+	auto deflated = std::vector<std::string>{};
+	auto stored_bytes = std::size_t{};
+	auto deflated_bytes = std::size_t{};
+	for (std::size_t i = 0; i < zip_entry_count_v; ++i) {
+		auto const size = std::size_t{1024} << (i % 6);
+		auto uri = make_uri(i);
+		if (i % 3 == 0) {
+			zip.add(uri, make_payload(size, i), false);
+			stored.push_back(std::move(uri));
+			stored_bytes += size;
+		} else {
+			zip.add(uri, make_text(size, i), true);
+			deflated.push_back(std::move(uri));
+			deflated_bytes += size;
+		}
+	}
+	auto const bytes = zip.build();
+
+	runner.measure("mount_index", [&] {
+		auto const mounted = zip::mount("bench_index", DataView{{}, bytes});
+		bench::do_not_optimize(mounted);
+		static_cast<void>(zip::unmount("bench_index"));
+	});
+
+	if (!zip::mount("bench", DataView{{}, bytes})) {
+		fmt::print(stderr, "  skipped: failed to mount ZIP\n");
+		return;
+	}
+
+	runner.measure("exists", [&] {
+		auto const found = zip::exists(deflated[deflated.size() / 2].c_str());
+		bench::do_not_optimize(found);
+	});
+
+	auto const max_threads = std::clamp(std::size_t{std::thread::hardware_concurrency()}, std::size_t{1}, std::size_t{8});
+	for (auto const threads : {std::size_t{1}, max_threads}) {
+		runner.measure(fmt::format("read_stored_{}t", threads), [&] {
+			read_all(threads, stored.size(), [&stored](std::size_t const index) {
+				auto out = std::vector<std::byte>{};
+				static_cast<void>(zip::read_bytes(out, stored[index].c_str()));
+				bench::do_not_optimize(out.data());
+			});
+		}, stored_bytes);
+		// lookup + inflate: the path of loading most assets from an archive.
+		runner.measure(fmt::format("read_deflated_{}t", threads), [&] {
+			read_all(threads, deflated.size(), [&deflated](std::size_t const index) {
+				auto out = std::vector<std::byte>{};
+				static_cast<void>(zip::read_bytes(out, deflated[index].c_str()));
+				bench::do_not_optimize(out.data());
+			});
+		}, deflated_bytes);
+		runner.measure(fmt::format("map_stored_{}t", threads), [&] {
+			read_all(threads, stored.size(), [&stored](std::size_t const index) {
+				auto const view = zip::map(stored[index].c_str());
+				bench::do_not_optimize(view.get_bytes().data());
+			});
+		}, stored_bytes);
+		if (max_threads == 1) { break; }
+	}
+
+	static_cast<void>(zip::unmount("bench"));
+}
+
+ADD_BENCH(Bundle) {
+	auto builder = Bundle::Builder{};
+	for (std::size_t i = 0; i < entry_count_v; ++i) { builder.add(make_uri(i), make_payload(entry_size_v, i)); }
+
+	runner.measure("build", [&] {
+		auto const bytes = builder.build();
+		bench::do_not_optimize(bytes.data());
+	}, entry_count_v * entry_size_v);
+
+	auto const bytes = DataView::from(builder.build());
+	// cold start: validating the header and index of an already loaded bundle.
+	runner.measure("open", [&] {
+		auto const bundle = Bundle{bytes};
+		bench::do_not_optimize(bundle.is_valid());
+	});
+
+	auto const bundle = Bundle{bytes};
+	auto const uri = make_uri(entry_count_v / 2);
+	runner.measure("find", [&] {
+		auto const view = bundle.find(uri);
+		bench::do_not_optimize(view.get_bytes().data());
+	});
+	runner.measure("find_missing", [&] {
+		auto const view = bundle.find("bench/missing.bin");
+		bench::do_not_optimize(view.get_bytes().data());
+	});
+}
+} // namespace
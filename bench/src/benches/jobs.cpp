@@ -0,0 +1,66 @@
+#include <bave/graphics/render_instance.hpp>
+#include <bave/job_system.hpp>
+#include <bench/bench.hpp>
+#include <fmt/format.h>
+#include <algorithm>
+#include <thread>
+
+namespace {
+using namespace bave;
+
+constexpr std::size_t fan_out_v{1000};
+constexpr std::size_t chain_v{64};
+constexpr std::size_t instance_count_v{100'000};
+
+auto make_instances() -> std::vector<RenderInstance> {
+	auto ret = std::vector<RenderInstance>(instance_count_v);
+	for (std::size_t i = 0; i < ret.size(); ++i) {
+		ret[i].transform.position = {static_cast<float>(i), 0.0f};
+		ret[i].transform.rotation = Degrees{static_cast<float>(i % 360)};
+	}
+	return ret;
+}
+
+// scheduling overhead (per job) with 1-7 workers.
+ADD_BENCH(JobSystem) {
+	for (auto const workers : {std::size_t{1}, std::size_t{3}, std::size_t{7}}) {
+		auto job_system = JobSystem{workers};
+		runner.measure(fmt::format("schedule_wait_{}w", workers), [&] { job_system.wait(job_system.schedule([] {})); });
+		runner.measure(fmt::format("fan_out_x{}_{}w", fan_out_v, workers), [&] {
+			for (std::size_t i = 0; i < fan_out_v; ++i) { job_system.schedule([] {}); }
+			job_system.wait_idle();
+		});
+		runner.measure(fmt::format("chain_x{}_{}w", chain_v, workers), [&] {
+			auto previous = JobSystem::Handle{};
+			for (std::size_t i = 0; i < chain_v; ++i) { previous = job_system.schedule([] {}, std::span{&previous, 1}); }
+			job_system.wait(previous);
+		});
+	}
+}
+
+// throughput of parallel_for (via batched instance baking) on 1-8 threads (including the calling thread).
+ADD_BENCH(ParallelFor) {
+	auto const instances = make_instances();
+	auto const parent = glm::identity<glm::mat4>();
+	auto baked = std::vector<RenderInstance::Baked>{};
+	baked.reserve(instances.size());
+	auto const bytes = instances.size() * sizeof(RenderInstance::Baked);
+
+	runner.measure(fmt::format("fill_baked_x{}_1t", instance_count_v), [&] {
+		baked.clear();
+		RenderInstance::fill_baked(baked, instances, parent);
+		bench::do_not_optimize(baked.data());
+	}, bytes);
+
+	auto const max_threads = std::max(std::size_t{std::thread::hardware_concurrency()}, std::size_t{2});
+	for (auto const threads : {std::size_t{2}, std::size_t{4}, std::size_t{8}}) {
+		if (threads > max_threads) { break; }
+		auto job_system = JobSystem{threads - 1};
+		runner.measure(fmt::format("fill_baked_x{}_{}t", instance_count_v, threads), [&] {
+			baked.clear();
+			RenderInstance::fill_baked(baked, instances, parent, job_system);
+			bench::do_not_optimize(baked.data());
+		}, bytes);
+	}
+}
+} // namespace
@@ -0,0 +1,41 @@
+#include <bave/io/file_io.hpp>
+#include <bave/io/json_io.hpp>
+#include <bench/bench.hpp>
+#include <fmt/format.h>
+
+namespace {
+using namespace bave;
+
+ADD_BENCH(Json) {
+	auto text = std::string{};
+	if (!file::read_string(text, runner.data_path("images/explode_atlas.json").c_str())) {
+		fmt::print(stderr, "  skipped: images/explode_atlas.json not found\n");
+		return;
+	}
+
+	runner.measure("parse_atlas", [&] {
+		auto const json = dj::Json::parse(text);
+		bench::do_not_optimize(json);
+	}, text.size());
+
+	auto const atlas_json = dj::Json::parse(text);
+	runner.measure("from_json_tile_sheet", [&] {
+		auto tile_sheet = TileSheet{};
+		from_json(atlas_json["tile_sheet"], tile_sheet);
+		bench::do_not_optimize(tile_sheet);
+	});
+	runner.measure("to_string_atlas", [&] {
+		auto const str = to_string(atlas_json);
+		bench::do_not_optimize(str.data());
+	});
+
+	auto particle_json = dj::Json{};
+	to_json(particle_json, ParticleConfig{});
+	auto const particle_text = to_string(particle_json);
+	runner.measure("parse_from_json_particle_config", [&] {
+		auto config = ParticleConfig{};
+		from_json(dj::Json::parse(particle_text), config);
+		bench::do_not_optimize(config);
+	}, particle_text.size());
+}
+} // namespace
@@ -0,0 +1,90 @@
+#include <bave/data_store.hpp>
+#include <bave/graphics/image_file.hpp>
+#include <bave/graphics/raw_image.hpp>
+#include <bave/io/bundle_loader.hpp>
+#include <bave/io/file_io.hpp>
+#include <bave/io/file_loader.hpp>
+#include <bave/loader.hpp>
+#include <bench/bench.hpp>
+#include <fmt/format.h>
+#include <algorithm>
+#include <array>
+#include <filesystem>
+
+namespace {
+using namespace bave;
+namespace fs = std::filesystem;
+
+constexpr auto image_extensions_v = std::array<std::string_view, 6>{".png", ".qoi", ".jpg", ".jpeg", ".bmp", ".tga"};
+
+// packs an assets directory the way `bave-tools bundle` does: images pre-decoded into RawImages, everything else as-is.
+auto build_bundle(fs::path const& root) -> std::vector<std::byte> {
+	auto builder = Bundle::Builder{};
+	auto ec = std::error_code{};
+	for (auto const& it : fs::recursive_directory_iterator{root, ec}) {
+		if (!it.is_regular_file()) { continue; }
+		auto bytes = std::vector<std::byte>{};
+		if (!file::read_bytes(bytes, it.path().string().c_str())) { continue; }
+		auto const extension = it.path().extension().string();
+		if (std::find(image_extensions_v.begin(), image_extensions_v.end(), extension) != image_extensions_v.end()) {
+			auto image = ImageFile{};
+			if (image.load_from_bytes(std::span<std::byte const>{bytes})) { bytes = RawImage::encode(image.get_bitmap_view()); }
+		}
+		builder.add(fs::relative(it.path(), root).generic_string(), std::move(bytes));
+	}
+	return builder.build();
+}
+
+// the assets the example (flappy) loads before its first frame; music is streamed in asynchronously, and skipped.
+void load_example(DataStore const& data_store, NotNull<RenderDevice*> render_device) {
+	auto const loader = Loader{&data_store, render_device};
+	auto const player = loader.load_texture("images/bird_256x256.png");
+	auto const jump_sfx = loader.load_audio_clip("audio_clips/beep.wav");
+	auto const explode_atlas = loader.load_texture_atlas("images/explode_atlas.json");
+	auto const explode_timeline = loader.load_anim_timeline("animations/explode_anim.json");
+	auto const explode_sfx = loader.load_audio_clip("audio_clips/explode.wav");
+	auto const cloud = loader.load_texture("images/cloud_256x128.png");
+	auto const pipe = loader.load_texture_9slice("images/pipe_128x128.9slice.json");
+	auto const hud_font = loader.load_font("fonts/Vera.ttf");
+	bench::do_not_optimize(player);
+	bench::do_not_optimize(explode_atlas);
+	bench::do_not_optimize(cloud);
+	bench::do_not_optimize(pipe);
+	bench::do_not_optimize(hud_font);
+}
+
+// cold start of the example: creating a DataStore (and opening / mapping the bundle) and loading its startup assets.
+// each iteration starts without any asset caches; the OS file cache is warm for both variants.
+ADD_DEVICE_BENCH(ColdStart) {
+	auto* render_device = runner.get_render_device();
+	if (render_device == nullptr) { return; }
+
+	auto const assets = fs::path{runner.get_options().data_dir};
+	auto ec = std::error_code{};
+	if (!fs::is_regular_file(assets / "images/bird_256x256.png", ec)) {
+		fmt::print(stderr, "  skipped: example assets not found in '{}'\n", assets.generic_string());
+		return;
+	}
+
+	auto const bundle_path = (fs::temp_directory_path() / "bave-bench-assets.bvb").string();
+	if (!file::write_bytes(bundle_path.c_str(), build_bundle(assets))) {
+		fmt::print(stderr, "  skipped: failed to write '{}'\n", bundle_path);
+		return;
+	}
+
+	runner.measure("loose_files", [&] {
+		auto data_store = DataStore{};
+		data_store.set_loader(std::make_unique<FileLoader>(assets.string()));
+		load_example(data_store, render_device);
+	});
+
+	runner.measure("bundle", [&] {
+		auto data_store = DataStore{};
+		data_store.set_loader(std::make_unique<BundleLoader>(Bundle{file::map(bundle_path.c_str())}));
+		load_example(data_store, render_device);
+	});
+
+	render_device->get_device().waitIdle();
+	fs::remove(bundle_path, ec);
+}
+} // namespace
@@ -0,0 +1,48 @@
+#include <bave/graphics/particle_system.hpp>
+#include <bave/job_system.hpp>
+#include <bench/bench.hpp>
+#include <fmt/format.h>
+#include <algorithm>
+#include <thread>
+
+namespace {
+using namespace bave;
+
+ADD_BENCH(ParticleEmitter) {
+	for (auto const count : {std::size_t{100}, std::size_t{1000}, std::size_t{10'000}}) {
+		auto emitter = ParticleEmitter{};
+		emitter.config.count = count;
+		emitter.pre_warm();
+		runner.measure(fmt::format("tick_x{}", count), [&] {
+			emitter.tick(Seconds{1.0f / 60.0f});
+			bench::do_not_optimize(emitter);
+		});
+	}
+}
+
+// 16 emitters (chunked and baked into one buffer), ticked serially and on 2-8 threads (including the calling thread).
+ADD_BENCH(ParticleSystem) {
+	static constexpr std::size_t emitter_count_v{16};
+	static constexpr std::size_t particle_count_v{5'000};
+	auto system = ParticleSystem{};
+	system.emitters.resize(emitter_count_v);
+	for (auto& emitter : system.emitters) { emitter.config.count = particle_count_v; }
+	system.pre_warm();
+	auto const dt = Seconds{1.0f / 60.0f};
+
+	runner.measure(fmt::format("tick_{}x{}_1t", emitter_count_v, particle_count_v), [&] {
+		system.tick(dt);
+		bench::do_not_optimize(system);
+	});
+
+	auto const max_threads = std::max(std::size_t{std::thread::hardware_concurrency()}, std::size_t{2});
+	for (auto const threads : {std::size_t{2}, std::size_t{4}, std::size_t{8}}) {
+		if (threads > max_threads) { break; }
+		auto job_system = JobSystem{threads - 1};
+		runner.measure(fmt::format("tick_{}x{}_{}t", emitter_count_v, particle_count_v, threads), [&] {
+			system.tick(dt, job_system);
+			bench::do_not_optimize(system);
+		});
+	}
+}
+} // namespace
@@ -0,0 +1,72 @@
+#include <bave/graphics/pixmap.hpp>
+#include <bench/bench.hpp>
+#include <fmt/format.h>
+#include <array>
+
+namespace {
+using namespace bave;
+
+// deterministic glyph-like sizes (so runs are comparable across commits).
+auto make_sub_images(std::size_t const count) -> std::vector<Pixmap> {
+	auto ret = std::vector<Pixmap>{};
+	ret.reserve(count);
+	auto state = std::uint32_t{12345};
+	auto const next = [&state](int const lo, int const hi) {
+		state = state * 1664525u + 1013904223u;
+		return lo + static_cast<int>((state >> 8) % static_cast<std::uint32_t>(hi - lo + 1));
+	};
+	for (std::size_t i = 0; i < count; ++i) { ret.emplace_back(glm::ivec2{next(4, 48), next(8, 64)}, white_v); }
+	return ret;
+}
+
+struct Packer {
+	std::string_view name{};
+	Pixmap::Builder::Layout layout{};
+};
+
+constexpr auto packers_v = std::array{
+	Packer{"shelf", {.packing = Pixmap::Builder::Packing::eShelf}},
+	Packer{"shelf_sorted", {.packing = Pixmap::Builder::Packing::eShelf, .sort_by_height = true}},
+	Packer{"skyline_sorted", {.packing = Pixmap::Builder::Packing::eSkyline, .sort_by_height = true}},
+	Packer{"maxrects_sorted", {.packing = Pixmap::Builder::Packing::eMaxRects, .sort_by_height = true}},
+};
+
+ADD_BENCH(PixmapBuilder) {
+	auto const sub_images = make_sub_images(256);
+	for (auto const& packer : packers_v) {
+		auto builder = Pixmap::Builder{1024, {1, 1}, packer.layout};
+		for (std::size_t i = 0; i < sub_images.size(); ++i) { builder.add(static_cast<Pixmap::Builder::Id>(i), sub_images[i]); }
+		auto occupancy = 0.0f;
+		runner.measure(fmt::format("build_{}", packer.name), [&] {
+			auto const atlas = builder.build();
+			occupancy = atlas.stats.get_occupancy();
+			bench::do_not_optimize(atlas.pixmap.get_pixels().data());
+		});
+		fmt::print(stderr, "    occupancy: {:.1f}%\n", 100.0f * occupancy);
+	}
+}
+
+ADD_BENCH(Pixmap) {
+	auto const extent = glm::ivec2{512};
+	auto const bytes = static_cast<std::uint64_t>(extent.x * extent.y) * sizeof(Rgba);
+	auto target = Pixmap{extent};
+	auto const source = Pixmap{extent, Rgba{.channels = {0x10, 0x20, 0x30, 0xff}}};
+
+	runner.measure("fill_512", [&] {
+		target.fill(red_v);
+		bench::do_not_optimize(target.get_pixels().data());
+	}, bytes);
+	runner.measure("overwrite_512", [&] {
+		target.overwrite(source, {});
+		bench::do_not_optimize(target.get_pixels().data());
+	}, bytes);
+	runner.measure("make_bitmap_512", [&] {
+		auto const bitmap = target.make_bitmap();
+		bench::do_not_optimize(bitmap);
+	}, bytes);
+	runner.measure("make_alpha_512", [&] {
+		auto const alpha = target.make_alpha();
+		bench::do_not_optimize(alpha.data());
+	}, bytes);
+}
+} // namespace
@@ -0,0 +1,176 @@
+#include <bave/graphics/bitmap.hpp>
+#include <bave/graphics/detail/image_uploader.hpp>
+#include <bave/graphics/renderer.hpp>
+#include <bave/graphics/shape.hpp>
+#include <bave/job_system.hpp>
+#include <bench/bench.hpp>
+#include <fmt/format.h>
+
+namespace {
+using namespace bave;
+
+auto make_render_pass(vk::Device const device, vk::Format const format) -> vk::UniqueRenderPass {
+	auto const attachment_ref = vk::AttachmentReference{0, vk::ImageLayout::eColorAttachmentOptimal};
+	auto sd = vk::SubpassDescription{};
+	sd.pipelineBindPoint = vk::PipelineBindPoint::eGraphics;
+	sd.colorAttachmentCount = 1;
+	sd.pColorAttachments = &attachment_ref;
+
+	auto ad = vk::AttachmentDescription{};
+	ad.format = format;
+	ad.samples = vk::SampleCountFlagBits::e1;
+	ad.loadOp = vk::AttachmentLoadOp::eClear;
+	ad.storeOp = vk::AttachmentStoreOp::eStore;
+	ad.initialLayout = vk::ImageLayout::eUndefined;
+	ad.finalLayout = vk::ImageLayout::eShaderReadOnlyOptimal;
+
+	auto rpci = vk::RenderPassCreateInfo{};
+	rpci.attachmentCount = 1;
+	rpci.pAttachments = &ad;
+	rpci.subpassCount = 1;
+	rpci.pSubpasses = &sd;
+	return device.createRenderPassUnique(rpci);
+}
+
+// cost of a framebuffer create / destroy pair: what Renderer used to pay every frame.
+ADD_DEVICE_BENCH(Framebuffer) {
+	auto* render_device = runner.get_render_device();
+	if (render_device == nullptr) { return; }
+
+	auto const device = render_device->get_device();
+	auto const format = vk::Format::eR8G8B8A8Srgb;
+	auto const render_pass = make_render_pass(device, format);
+	for (auto const size : {256u, 1920u}) {
+		auto const ici = detail::RenderImage::CreateInfo{
+			.format = format,
+			.usage = detail::RenderImage::CreateInfo::usage_v | vk::ImageUsageFlagBits::eColorAttachment,
+			.mip_map = false,
+		};
+		auto const image = render_device->get_image_cache().allocate(ici, vk::Extent2D{size, size});
+		auto const image_view = image->get_image_view();
+
+		auto fci = vk::FramebufferCreateInfo{};
+		fci.renderPass = *render_pass;
+		fci.attachmentCount = 1;
+		fci.pAttachments = &image_view;
+		fci.width = fci.height = size;
+		fci.layers = 1;
+
+		runner.measure(fmt::format("create_destroy_{}", size), [&] {
+			auto const framebuffer = device.createFramebufferUnique(fci);
+			bench::do_not_optimize(framebuffer);
+		});
+	}
+}
+
+// acquiring and releasing a 1024^2 image: reused from the pool, and created from scratch (pool trimmed every iteration).
+ADD_DEVICE_BENCH(ImageCache) {
+	auto* render_device = runner.get_render_device();
+	if (render_device == nullptr) { return; }
+
+	auto& image_cache = render_device->get_image_cache();
+	auto const ici = detail::RenderImage::CreateInfo{};
+	auto const extent = vk::Extent2D{1024, 1024};
+
+	runner.measure("allocate_release_pooled", [&] {
+		auto const image = image_cache.allocate(ici, extent);
+		bench::do_not_optimize(image);
+	});
+
+	runner.measure("allocate_release_unpooled", [&] {
+		{
+			auto const image = image_cache.allocate(ici, extent);
+			bench::do_not_optimize(image);
+		}
+		image_cache.trim();
+	});
+}
+
+// creating textures (allocate + upload) on the calling thread, and concurrently on 4 threads.
+ADD_DEVICE_BENCH(TextureUpload) {
+	auto* render_device = runner.get_render_device();
+	if (render_device == nullptr) { return; }
+
+	static constexpr std::size_t count_v{16};
+	static constexpr int size_v{256};
+	auto const bitmap = Bitmap{std::vector<std::byte>(std::size_t{size_v} * size_v * 4, std::byte{0x80}), glm::ivec2{size_v}};
+	auto const create = [&] {
+		auto const texture = Texture{render_device, bitmap.get_bitmap_view()};
+		bench::do_not_optimize(texture);
+	};
+	auto const bytes = count_v * bitmap.get_bitmap_view().bytes.size();
+
+	runner.measure(fmt::format("create_{}x{}_1t", count_v, size_v), [&] {
+		for (std::size_t i = 0; i < count_v; ++i) { create(); }
+	}, bytes);
+
+	auto job_system = JobSystem{3};
+	runner.measure(fmt::format("create_{}x{}_4t", count_v, size_v), [&] {
+		job_system.parallel_for(count_v, [&](std::size_t const begin, std::size_t const end) {
+			for (auto i = begin; i < end; ++i) { create(); }
+		}, 1);
+	}, bytes);
+}
+
+// uploading mip-mapped textures with a submit each, and batched into one command buffer (both waited on).
+ADD_DEVICE_BENCH(MipMaps) {
+	auto* render_device = runner.get_render_device();
+	if (render_device == nullptr) { return; }
+
+	static constexpr std::size_t count_v{16};
+	static constexpr int size_v{512};
+	auto const bitmap = Bitmap{std::vector<std::byte>(std::size_t{size_v} * size_v * 4, std::byte{0x80}), glm::ivec2{size_v}};
+	auto const bytes = count_v * bitmap.get_bitmap_view().bytes.size();
+
+	runner.measure(fmt::format("individual_{}x{}", count_v, size_v), [&] {
+		for (std::size_t i = 0; i < count_v; ++i) {
+			auto const texture = Texture{render_device, bitmap.get_bitmap_view(), true};
+			bench::do_not_optimize(texture);
+		}
+		render_device->get_device().waitIdle();
+	}, bytes);
+
+	runner.measure(fmt::format("batched_{}x{}", count_v, size_v), [&] {
+		auto textures = std::vector<Texture>{};
+		textures.reserve(count_v);
+		auto uploader = detail::ImageUploader{render_device};
+		for (std::size_t i = 0; i < count_v; ++i) { textures.emplace_back(render_device, bitmap.get_bitmap_view(), true, uploader); }
+		uploader.submit();
+		render_device->get_device().waitIdle();
+	}, bytes);
+}
+
+// whole frames, with draws split into jobs recorded on 1-8 threads.
+ADD_DEVICE_BENCH(RecordJobs) {
+	auto* render_device = runner.get_render_device();
+	auto const* data_store = runner.get_data_store();
+	if (render_device == nullptr || data_store == nullptr) { return; }
+
+	// a separate Renderer, so that frames can be started and finished within a bench.
+	auto renderer = Renderer{render_device, data_store};
+	auto job_system = JobSystem{7};
+	renderer.set_job_system(&job_system);
+	auto& shader_cache = renderer.get_pipeline_cache().get_shader_cache();
+	if (!shader_cache.load("shaders/default.vert") || !shader_cache.load("shaders/default.frag")) {
+		fmt::print(stderr, "  skipped: shaders/default.[vert|frag] not found\n");
+		return;
+	}
+
+	static constexpr std::size_t job_count_v{32};
+	static constexpr std::size_t draws_per_job_v{64};
+	auto const quad = QuadShape{};
+	auto const job = [&](RenderJob& render_job) {
+		auto shader = render_job.bind(Shader{&renderer, "shaders/default.vert", "shaders/default.frag"});
+		for (std::size_t i = 0; i < draws_per_job_v; ++i) { quad.draw(shader); }
+	};
+	auto const jobs = std::vector<RecordFunc>(job_count_v, job);
+
+	for (auto const threads : {std::size_t{1}, std::size_t{2}, std::size_t{4}, std::size_t{8}}) {
+		runner.measure(fmt::format("frame_{}x{}_{}t", job_count_v, draws_per_job_v, threads), [&] {
+			if (!renderer.start_render(black_v)) { return; }
+			renderer.record_jobs(jobs, threads);
+			renderer.finish_render();
+		});
+	}
+}
+} // namespace
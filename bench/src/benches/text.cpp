@@ -0,0 +1,47 @@
+#include <bave/font/font.hpp>
+#include <bave/graphics/render_device.hpp>
+#include <bave/io/file_io.hpp>
+#include <bench/bench.hpp>
+#include <fmt/format.h>
+
+namespace {
+using namespace bave;
+
+constexpr std::string_view line_v{"The quick brown fox jumps over the lazy dog, 0123456789!"};
+
+ADD_DEVICE_BENCH(FontPen) {
+	auto* render_device = runner.get_render_device();
+	auto bytes = std::vector<std::byte>{};
+	if (render_device == nullptr || !file::read_bytes(bytes, runner.data_path("fonts/Vera.ttf").c_str())) {
+		fmt::print(stderr, "  skipped: fonts/Vera.ttf not found\n");
+		return;
+	}
+
+	auto const height = TextHeight::eDefault;
+	// atlases are cached per Font: measure a fresh one (rasterize and upload).
+	runner.measure("load_create_font_atlas", [&] {
+		auto font = Font{render_device};
+		static_cast<void>(font.load_from_bytes(bytes));
+		auto const created = font.create_font_atlas(height);
+		bench::do_not_optimize(created);
+	});
+
+	auto font = Font{render_device};
+	if (!font.load_from_bytes(std::move(bytes))) { return; }
+
+	// glyphs are rasterized on first use: warm the atlas before measuring layout.
+	auto geometry = Geometry{};
+	static_cast<void>(Font::Pen{&font, height}.generate_quads(geometry, line_v));
+	runner.measure("generate_quads", [&] {
+		geometry.vertex_array.vertices.clear();
+		geometry.vertex_array.indices.clear();
+		auto pen = Font::Pen{&font, height};
+		pen.generate_quads(geometry, line_v);
+		bench::do_not_optimize(geometry.vertex_array.vertices.data());
+	}, line_v.size());
+	runner.measure("calc_line_extent", [&] {
+		auto const extent = Font::Pen{&font, height}.calc_line_extent(line_v);
+		bench::do_not_optimize(extent);
+	}, line_v.size());
+}
+} // namespace
@@ -0,0 +1,103 @@
+#include <bave/build_version.hpp>
+#include <bave/clap/clap.hpp>
+#include <bave/driver.hpp>
+#include <bave/headless_app.hpp>
+#include <bave/io/data_loader_builder.hpp>
+#include <bave/io/file_io.hpp>
+#include <bave/io/file_loader.hpp>
+#include <bench/bench.hpp>
+#include <fmt/format.h>
+#include <algorithm>
+#include <cstdio>
+
+namespace {
+using bench::Bench;
+using bench::Runner;
+
+void run_bench(Runner& runner, Bench const& bench) {
+	fmt::print(stderr, "[{}]\n", bench.get_name());
+	runner.set_bench(bench.get_name());
+	bench.run(runner);
+}
+
+/// \brief Runs device benches on the first tick, then requests shutdown.
+class DeviceBenches : public bave::Driver {
+  public:
+	explicit DeviceBenches(bave::App& app, bave::NotNull<Runner*> runner, std::vector<Bench*> benches)
+		: bave::Driver(app), m_runner(runner), m_benches(std::move(benches)) {}
+
+	void tick() final {
+		if (m_done) { return; }
+		m_runner->set_render_device(&get_app().get_render_device());
+		m_runner->set_data_store(&get_app().get_data_store());
+		for (auto const* bench : m_benches) { run_bench(*m_runner, *bench); }
+		m_runner->set_render_device({});
+		m_runner->set_data_store({});
+		m_done = true;
+		get_app().shutdown();
+	}
+
+  private:
+	bave::NotNull<Runner*> m_runner;
+	std::vector<Bench*> m_benches{};
+	bool m_done{};
+};
+} // namespace
+
+auto main(int argc, char** argv) -> int {
+	auto options = bench::Options{};
+	auto min_sample_ms = 20;
+	auto out_path = std::string{};
+	auto no_device = false;
+
+	auto clap_options = bave::clap::Options{
+		bave::clap::make_app_name(*argv),
+		"Run bave micro-benchmarks and write results as JSON",
+		to_string(bave::build_version_v),
+	};
+	clap_options.required(options.filter, "f,filter", "only run benchmarks whose <bench>/<label> contains this string", "<string>")
+		.required(out_path, "o,out", "write JSON results to this file (default: stdout)", "<path>")
+		.required(options.samples, "s,samples", fmt::format("samples per benchmark (default: {})", options.samples), "<count>")
+		.required(min_sample_ms, "t,min-time", fmt::format("minimum duration of each sample in ms (default: {})", min_sample_ms), "<ms>")
+		.required(options.data_dir, "d,data", "assets directory (default: upfind example/assets)", "<path>")
+		.flag(no_device, "no-device", "skip benchmarks that need a Vulkan device");
+
+	auto const result = clap_options.parse(argc, argv);
+	if (bave::clap::should_quit(result)) { return bave::clap::return_code(result); }
+
+	if (options.data_dir.empty()) { options.data_dir = bave::DataLoaderBuilder{argc, argv}.upfind("assets,example/assets"); }
+	options.min_sample_time = std::chrono::milliseconds{std::max(min_sample_ms, 1)};
+
+	auto runner = Runner{options};
+	auto device_benches = std::vector<Bench*>{};
+	for (auto* bench : Bench::get_benches()) {
+		if (bench->needs_device()) {
+			if (!no_device) { device_benches.push_back(bench); }
+			continue;
+		}
+		run_bench(runner, *bench);
+	}
+
+	if (!device_benches.empty()) {
+		auto const data_dir = options.data_dir;
+		auto app = bave::HeadlessApp{bave::HeadlessApp::CreateInfo{
+			.extent = {64, 64},
+			.data_loader = std::make_unique<bave::FileLoader>(data_dir),
+			.validation_layers = false,
+		}};
+		app.set_bootloader([&runner, &device_benches](bave::App& app) { return std::make_unique<DeviceBenches>(app, &runner, std::move(device_benches)); });
+		if (app.run() != bave::ErrCode::eSuccess) { fmt::print(stderr, "failed to run device benches\n"); }
+	}
+
+	auto const json = runner.to_json_string();
+	if (out_path.empty()) {
+		fmt::print("{}\n", json);
+		return EXIT_SUCCESS;
+	}
+	if (!bave::file::write_string(out_path.c_str(), json)) {
+		fmt::print(stderr, "failed to write results to '{}'\n", out_path);
+		return EXIT_FAILURE;
+	}
+	fmt::print(stderr, "results written to '{}'\n", out_path);
+	return EXIT_SUCCESS;
+}
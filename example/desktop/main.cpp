@@ -7,7 +7,11 @@ auto main(int argc, char** argv) -> int {
 	// set up its CreateInfo:
 	// create a data loader by searching for assets in a super directory of the exe dir.
 	// this allows debugging without the need to set the working directory to <project_root>/example.
-	auto data_loader = bave::DataLoaderBuilder{argc, argv}.add_dir("assets,example/assets").build();
+	// a bundle (built via `bave-tools bundle example/assets`) is preferred if present, for faster loads.
+	auto builder = bave::DataLoaderBuilder{argc, argv};
+	// only add the bundle search if one exists, to avoid a warning on every run without one.
+	if (auto const bundle = builder.upfind("assets.bvb,example/assets.bvb"); !bundle.empty()) { builder.add_bundle(bundle); }
+	auto data_loader = builder.add_dir("assets,example/assets").build();
 	auto create_info = bave::DesktopApp::CreateInfo{
 		.title = "BaveExample",
 		.mode = bave::Windowed{.extent = {720, 1280}},
@@ -1,7 +1,6 @@
 #include <backends/imgui_impl_vulkan.h>
 #include <bave/graphics/pixmap.hpp>
 #include <bave/graphics/projector.hpp>
-#include <bave/loader.hpp>
 #include <src/flappy.hpp>
 #include <thread>
 
@@ -10,7 +9,6 @@ using bave::App;
 using bave::FocusChange;
 using bave::Key;
 using bave::KeyInput;
-using bave::Loader;
 using bave::PointerId;
 using bave::PointerTap;
 using bave::Rect;
@@ -20,7 +18,9 @@ using bave::Texture;
 
 // bave will reset delta time after using game factory, so time spent in this constructor will not bloat up the first tick's dt.
 // it will still halt the app until complete though; taking too long might trigger an ANR (App Not Responding) on Android.
-Flappy::Flappy(App& app) : Driver(app), m_game_view(app.get_render_device().render_view) {
+Flappy::Flappy(App& app) : Driver(app), m_game_view(app.get_render_device().render_view), m_assets(&app.get_data_store(), &app.get_render_device()) {
+	// watch asset files for modifications in debug builds (only supported when loading from the assets directory on Linux).
+	if constexpr (bave::debug_v) { app.set_hot_reload(true); }
 	// we use a custom / fixed viewport so that the same game world is visible regardless of screen / framebuffer size.
 	setup_viewport();
 	// this example loads most assets on the main thread, but all of them can be loaded asynchronously if desired.
@@ -34,6 +34,8 @@ Flappy::Flappy(App& app) : Driver(app), m_game_view(app.get_render_device().rend
 void Flappy::tick() {
 	// check async asset load status, and start using if ready.
 	poll_futures();
+	// reload any modified assets: textures are updated in place, so existing sprites pick up the changes.
+	m_assets.reload(get_app().get_file_changes());
 
 	auto const dt = get_app().get_dt();
 
@@ -163,21 +165,20 @@ void Flappy::setup_viewport() {
 }
 
 void Flappy::load_assets() {
-	auto const loader = Loader{&get_app().get_data_store(), &get_app().get_render_device()};
-	// setup an async load.
-	m_music_future = std::async([loader] { return loader.load_audio_clip("audio_clips/in_the_city.mp3"); });
+	// AssetCache is thread-safe: setup an async load.
+	m_music_future = std::async([this] { return m_assets.load_audio_clip("audio_clips/in_the_city.mp3"); });
 
 	// load the rest before returning.
-	m_config.player_texture = loader.load_texture("images/bird_256x256.png");
-	m_config.jump_sfx = loader.load_audio_clip("audio_clips/beep.wav");
+	m_config.player_texture = m_assets.load_texture("images/bird_256x256.png");
+	m_config.jump_sfx = m_assets.load_audio_clip("audio_clips/beep.wav");
 
-	m_config.explode_atlas = loader.load_texture_atlas("images/explode_atlas.json");
-	m_config.explode_timeline = loader.load_anim_timeline("animations/explode_anim.json");
-	m_config.explode_sfx = loader.load_audio_clip("audio_clips/explode.wav");
+	m_config.explode_atlas = m_assets.load_texture_atlas("images/explode_atlas.json");
+	m_config.explode_timeline = m_assets.load_anim_timeline("animations/explode_anim.json");
+	m_config.explode_sfx = m_assets.load_audio_clip("audio_clips/explode.wav");
 
-	m_config.cloud_texture = loader.load_texture("images/cloud_256x128.png");
-	m_config.pipe_texture = loader.load_texture_9slice("images/pipe_128x128.9slice.json");
-	m_config.hud_font = loader.load_font("fonts/Vera.ttf");
+	m_config.cloud_texture = m_assets.load_texture("images/cloud_256x128.png");
+	m_config.pipe_texture = m_assets.load_texture_9slice("images/pipe_128x128.9slice.json");
+	m_config.hud_font = m_assets.load_font("fonts/Vera.ttf");
 
 	if (m_config.player_texture) { m_config.player_texture->sampler.min = m_config.player_texture->sampler.mag = Texture::Filter::eNearest; }
 }
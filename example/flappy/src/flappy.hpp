@@ -1,4 +1,5 @@
 #pragma once
+#include <bave/asset_cache.hpp>
 #include <bave/driver.hpp>
 #include <bave/graphics/sprite.hpp>
 #include <bave/graphics/sprite_anim.hpp>
@@ -45,6 +46,8 @@ class Flappy : public bave::Driver {
 
 	bave::RenderView m_game_view{};
 
+	// shared assets, reloaded in place when their files are modified (if hot reload is enabled).
+	bave::AssetCache m_assets;
 	Config m_config{};
 	std::future<std::shared_ptr<bave::AudioClip>> m_music_future{};
 
@@ -18,7 +18,8 @@ class AndroidApp : private App, private detail::IWsi {
   public:
 	static constexpr auto msaa_v = vk::SampleCountFlagBits{vk::SampleCountFlagBits::e1};
 
-	explicit AndroidApp(android_app& app, vk::SampleCountFlagBits msaa = msaa_v, bool validation_layers = debug_v);
+	explicit AndroidApp(android_app& app, vk::SampleCountFlagBits msaa = msaa_v, bool validation_layers = debug_v,
+						std::uint32_t frames_in_flight = RenderDeviceCreateInfo{}.frames_in_flight);
 
 	using App::run;
 	using App::set_bootloader;
@@ -68,6 +69,7 @@ class AndroidApp : private App, private detail::IWsi {
 	android_app& m_app; // NOLINT(cppcoreguidelines-avoid-const-or-ref-data-members)
 	vk::SampleCountFlagBits m_msaa;
 	bool m_validation_layers;
+	std::uint32_t m_frames_in_flight;
 	std::string m_persistent_dir{};
 
 	std::unique_ptr<RenderDevice> m_render_device{};
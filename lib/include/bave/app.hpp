@@ -3,6 +3,7 @@
 #include <bave/audio/audio_device.hpp>
 #include <bave/audio/audio_streamer.hpp>
 #include <bave/build_version.hpp>
+#include <bave/core/frame_pacer.hpp>
 #include <bave/core/polymorphic.hpp>
 #include <bave/core/time.hpp>
 #include <bave/core/timer.hpp>
@@ -13,6 +14,7 @@
 #include <bave/input/gamepad.hpp>
 #include <bave/input/gesture_recognizer.hpp>
 #include <bave/input/key_state.hpp>
+#include <bave/job_system.hpp>
 #include <bave/logger.hpp>
 #include <bave/platform.hpp>
 #include <capo/capo.hpp>
@@ -92,12 +94,22 @@ class App : public PolyPinned {
 	///
 	/// Loaded shaders are cached and not reloaded on every call.
 	/// A Shader instance is intended to be temporary, within a draw scope.
+	/// It refers to shader modules by URI, so it remains valid (and uses reloaded modules) across hot reloads.
 	[[nodiscard]] auto load_shader(std::string_view vertex, std::string_view fragment) const -> std::optional<Shader>;
 
 	/// \brief Set a custom DataLoader.
 	/// \param loader Custom DataLoader to use.
 	void set_data_loader(std::unique_ptr<IDataLoader> loader);
 
+	/// \brief Enable / disable watching the DataLoader for modified files.
+	/// \param enable Whether to watch for modified files.
+	/// \returns true if the DataLoader supports watching (or enable is false).
+	///
+	/// Only FileLoader on Linux currently supports watching.
+	/// Modified shaders are invalidated automatically, other modified URIs are reported via get_file_changes().
+	auto set_hot_reload(bool enable) -> bool;
+	[[nodiscard]] auto is_hot_reload_enabled() const -> bool { return m_file_watcher != nullptr; }
+
 	/// \brief Get a particular gamepad.
 	/// \param id ID of gamepad.
 	/// \returns Const reference to Gamepad.
@@ -132,6 +144,9 @@ class App : public PolyPinned {
 
 	[[nodiscard]] auto get_events() const -> std::span<Event const> { return m_events; }
 	[[nodiscard]] auto get_file_drops() const -> std::span<std::string const> { return m_drops; }
+	/// \brief Obtain URIs of files modified since the last frame (if hot reload is enabled).
+	/// \returns URIs of modified files, eg to pass to AssetCache::reload().
+	[[nodiscard]] auto get_file_changes() const -> std::span<std::string const> { return m_file_changes; }
 	[[nodiscard]] auto get_active_pointers() const -> std::span<Pointer const> { return m_active_pointers; }
 	[[nodiscard]] auto get_gamepads() const -> EnumArray<GamepadId, Gamepad> const& { return m_gamepads; }
 	[[nodiscard]] auto get_gesture_recognizer() const -> GestureRecognizer const& { return m_gesture_recognizer; }
@@ -141,8 +156,20 @@ class App : public PolyPinned {
 	[[nodiscard]] auto get_framebuffer_size() const -> glm::ivec2 { return do_get_framebuffer_size(); }
 	[[nodiscard]] auto get_display_ratio() const -> glm::vec2;
 	[[nodiscard]] auto get_pipeline_cache() const -> detail::PipelineCache& { return do_get_renderer().get_pipeline_cache(); }
+	/// \brief Obtain render stats of the last rendered frame.
+	[[nodiscard]] auto get_render_stats() const -> RenderStats const& { return do_get_renderer().get_stats(); }
+	/// \brief Obtain render stats of recently rendered frames, eg to export with to_csv().
+	///
+	/// Retains no frames by default: set a capacity to start collecting.
+	[[nodiscard]] auto get_render_stats_history() -> RenderStatsHistory& { return m_render_stats_history; }
+	[[nodiscard]] auto get_render_stats_history() const -> RenderStatsHistory const& { return m_render_stats_history; }
 
 	[[nodiscard]] auto get_timer() -> Timer& { return m_timer; }
+	/// \brief Obtain the FramePacer, to cap the frame rate or query input-to-present latency.
+	[[nodiscard]] auto get_frame_pacer() -> FramePacer& { return m_frame_pacer; }
+	[[nodiscard]] auto get_frame_pacer() const -> FramePacer const& { return m_frame_pacer; }
+	/// \brief Obtain the JobSystem: main thread jobs are run every frame before the Driver is ticked.
+	[[nodiscard]] auto get_job_system() const -> JobSystem& { return *m_job_system; }
 	[[nodiscard]] auto get_driver() const -> Ptr<Driver> { return do_get_driver(); }
 
   protected:
@@ -161,6 +188,8 @@ class App : public PolyPinned {
 	Gamepad::Id m_most_recent_gamepad{};
 	GestureRecognizer m_gesture_recognizer{};
 	KeyState m_key_state{};
+	/// \brief If set, used as the delta time of every frame (instead of elapsed time).
+	std::optional<Seconds> m_fixed_dt{};
 
   private:
 	virtual auto setup() -> std::optional<ErrCode> = 0;
@@ -189,15 +218,24 @@ class App : public PolyPinned {
 	virtual void do_wait_render_device_idle() = 0;
 
 	void pre_tick();
+	void poll_file_changes();
+	void record_render_stats();
 
 	std::function<std::unique_ptr<Driver>(App&)> m_bootloader{};
 	std::unique_ptr<DataStore> m_data_store{std::make_unique<DataStore>()};
 	std::unique_ptr<AudioDevice> m_audio_device{};
 	std::unique_ptr<AudioStreamer> m_audio_streamer{};
+	std::unique_ptr<JobSystem> m_job_system{std::make_unique<JobSystem>()};
+
+	std::unique_ptr<FileWatcher> m_file_watcher{};
 
 	std::vector<std::string> m_drops{};
+	std::vector<std::string> m_file_changes{};
 	std::vector<Event> m_events{};
 	DeltaTime m_dt{};
 	Timer m_timer{};
+	FramePacer m_frame_pacer{};
+	RenderStatsHistory m_render_stats_history{};
+	std::uint64_t m_render_stats_frame{};
 };
 } // namespace bave
@@ -0,0 +1,157 @@
+#pragma once
+#include <bave/core/enum_array.hpp>
+#include <bave/core/string_hash.hpp>
+#include <bave/loader.hpp>
+#include <cstdint>
+#include <mutex>
+#include <unordered_map>
+
+namespace bave {
+/// \brief Cache of shared assets, layered on Loader.
+///
+/// Assets are keyed by type, URI and load parameters: repeated loads return the resident instance.
+/// If dedupe is enabled, distinct URIs with identical contents also share an instance.
+/// Entries only owned by the cache are evicted in least-recently-used order when resident memory exceeds the budget.
+/// All member functions are thread-safe; loads run without holding the internal lock.
+class AssetCache {
+  public:
+	static constexpr std::size_t default_budget_v{256 * 1024 * 1024};
+
+	enum class Type : int { eTexture, eTexture9Slice, eTextureAtlas, eFont, eAudioClip, eAnimTimeline, eCOUNT_ };
+
+	struct CreateInfo {
+		/// \brief Maximum estimated bytes of resident assets.
+		std::size_t budget{default_budget_v};
+		/// \brief Whether to share assets across URIs with identical contents.
+		bool dedupe{};
+		/// \brief Whether textures prefer sibling KTX2 files (see Loader::prefer_compressed).
+		bool prefer_compressed{};
+		/// \brief Whether fonts prefer sibling BakedFont files (see Loader::prefer_baked_fonts).
+		bool prefer_baked_fonts{};
+	};
+
+	struct Stats {
+		/// \brief Number of resident assets.
+		std::size_t count{};
+		/// \brief Estimated bytes of resident assets.
+		std::size_t bytes{};
+	};
+
+	/// \brief Constructor.
+	/// \param data_store Non-null pointer to a const DataStore.
+	/// \param render_device Non-null pointer to a RenderDevice.
+	/// \param create_info Budget and dedupe settings.
+	explicit AssetCache(NotNull<DataStore const*> data_store, NotNull<RenderDevice*> render_device, CreateInfo const& create_info);
+	/// \brief Constructor with default CreateInfo.
+	/// \param data_store Non-null pointer to a const DataStore.
+	/// \param render_device Non-null pointer to a RenderDevice.
+	explicit AssetCache(NotNull<DataStore const*> data_store, NotNull<RenderDevice*> render_device)
+		: AssetCache(data_store, render_device, CreateInfo{}) {}
+
+	/// \brief Obtain a cached Texture, loading it if not resident.
+	/// \param uri URI to load from.
+	/// \param mip_map Whether to enable mip-mapping.
+	/// \returns Texture on success, nullptr on failure.
+	[[nodiscard]] auto load_texture(std::string_view uri, bool mip_map = false) -> std::shared_ptr<Texture>;
+	/// \brief Obtain a cached Texture9Slice, loading it if not resident.
+	/// \param uri URI to load from.
+	/// \returns Texture9Slice on success, nullptr on failure.
+	[[nodiscard]] auto load_texture_9slice(std::string_view uri) -> std::shared_ptr<Texture9Slice>;
+	/// \brief Obtain a cached TextureAtlas, loading it if not resident.
+	/// \param uri URI to load from.
+	/// \param mip_map Whether to enable mip-mapping.
+	/// \returns TextureAtlas on success, nullptr on failure.
+	[[nodiscard]] auto load_texture_atlas(std::string_view uri, bool mip_map = false) -> std::shared_ptr<TextureAtlas>;
+	/// \brief Obtain a cached Font, loading it if not resident.
+	/// \param uri URI to load from.
+	/// \param preload List of TextHeights to preload glyph atlases for (only used if not resident).
+	/// \returns Font on success, nullptr on failure.
+	[[nodiscard]] auto load_font(std::string_view uri, std::span<TextHeight const> preload = {}) -> std::shared_ptr<Font>;
+	/// \brief Obtain a cached AudioClip, loading it if not resident.
+	/// \param uri URI to load from.
+	/// \returns AudioClip on success, nullptr on failure.
+	[[nodiscard]] auto load_audio_clip(std::string_view uri) -> std::shared_ptr<AudioClip>;
+	/// \brief Obtain a cached AnimTimeline, loading it if not resident.
+	/// \param uri URI to load from.
+	/// \returns AnimTimeline on success, nullptr on failure.
+	[[nodiscard]] auto load_anim_timeline(std::string_view uri) -> std::shared_ptr<AnimTimeline>;
+
+	/// \brief Check if an asset is resident.
+	/// \param type Asset type.
+	/// \param uri URI of asset.
+	/// \returns true if any variant of the asset at uri is resident.
+	[[nodiscard]] auto contains(Type type, std::string_view uri) const -> bool;
+
+	/// \brief Reload resident assets whose sources were modified.
+	/// \param uris URIs of modified files (eg App::get_file_changes()).
+	/// \returns Number of reloaded / dropped entries.
+	///
+	/// Textures, 9-slices and atlases are reloaded in place (including when the image they reference changes),
+	/// other assets are dropped from the cache and reloaded on next use.
+	/// Texture images are swapped via Texture::replace_image(), so concurrent draws remain safe;
+	/// atlas tile sheets and 9-slice metadata are replaced without synchronization.
+	/// Texture memory stats are measured by image format and mip levels.
+	auto reload(std::span<std::string const> uris) -> std::size_t;
+
+	/// \brief Set the memory budget and evict entries if over it.
+	/// \param bytes Maximum estimated bytes of resident assets.
+	void set_budget(std::size_t bytes);
+	[[nodiscard]] auto get_budget() const -> std::size_t;
+
+	/// \brief Evict all entries only owned by the cache.
+	/// \returns Number of evicted entries.
+	auto trim() -> std::size_t;
+	/// \brief Drop all entries.
+	///
+	/// Assets still owned elsewhere remain valid, but will no longer be shared.
+	void clear();
+
+	[[nodiscard]] auto get_stats(Type type) const -> Stats;
+	[[nodiscard]] auto get_total_stats() const -> Stats;
+
+	[[nodiscard]] auto get_loader() const -> Loader const& { return m_loader; }
+
+  private:
+	struct Entry {
+		std::shared_ptr<void> asset{};
+		std::string uri{};
+		std::string content_key{};
+		Type type{};
+		bool mip_map{};
+		std::size_t bytes{};
+		std::uint64_t last_used{};
+	};
+
+	using EntryMap = std::unordered_map<std::string, Entry, StringHash, std::equal_to<>>;
+
+	template <typename T, typename F, typename G>
+	auto get_or_load(Type type, std::string_view uri, bool mip_map, F load, G measure) -> std::shared_ptr<T>;
+	template <typename T>
+	auto reload_in_place(Entry const& entry, std::shared_ptr<T> fresh) -> std::size_t;
+	[[nodiscard]] auto is_modified(Entry const& entry, std::span<std::string const> uris) const -> bool;
+
+	[[nodiscard]] auto find(std::string const& key) -> std::shared_ptr<void>;
+	[[nodiscard]] auto find_content(std::string const& content_key, std::string const& key, std::span<std::byte const> bytes) -> std::shared_ptr<void>;
+	auto insert(std::string key, Entry entry) -> std::shared_ptr<void>;
+
+	auto evict(std::size_t budget) -> std::size_t;
+	void erase(EntryMap::iterator it);
+	void release_content(EntryMap::iterator it);
+
+	Logger m_log{"AssetCache"};
+	NotNull<DataStore const*> m_data_store;
+	NotNull<RenderDevice*> m_render_device;
+	Loader m_loader;
+	bool m_dedupe{};
+
+	mutable std::mutex m_mutex{};
+	EntryMap m_entries{};
+	// content key => key of the entry that owns it.
+	std::unordered_map<std::string, std::string, StringHash, std::equal_to<>> m_contents{};
+	// aliased entry key => entry key.
+	std::unordered_map<std::string, std::string, StringHash, std::equal_to<>> m_aliases{};
+	EnumArray<Type, Stats> m_stats{};
+	std::size_t m_budget{};
+	std::uint64_t m_clock{};
+};
+} // namespace bave
@@ -0,0 +1,38 @@
+#pragma once
+#include <bave/core/time.hpp>
+
+namespace bave {
+/// \brief Caps the frame rate and tracks input-to-present latency.
+///
+/// Sleeps until each frame's deadline instead of spinning.
+/// Latency is measured on the CPU, from input being sampled until the frame has been submitted for presentation;
+/// it does not include compositor / display latency.
+class FramePacer {
+  public:
+	/// \brief Set the target frame rate.
+	/// \param fps Frames per second, 0 to uncap.
+	void set_target_fps(int fps);
+	[[nodiscard]] auto get_target_fps() const -> int { return m_target_fps; }
+
+	/// \brief Sleep until the deadline of the next frame (no-op if uncapped).
+	void wait();
+
+	/// \brief Record the time input was sampled for the current frame.
+	void mark_input() { m_input = Clock::now(); }
+	/// \brief Record the time the current frame was presented.
+	void mark_present();
+
+	/// \brief Obtain the input-to-present latency of the last frame.
+	[[nodiscard]] auto get_latency() const -> Seconds { return m_latency; }
+	/// \brief Obtain the input-to-present latency averaged over recent frames.
+	[[nodiscard]] auto get_average_latency() const -> Seconds { return m_average_latency; }
+
+  private:
+	int m_target_fps{};
+	Clock::duration m_period{};
+	Clock::time_point m_deadline{};
+	Clock::time_point m_input{};
+	Seconds m_latency{};
+	Seconds m_average_latency{};
+};
+} // namespace bave
@@ -1,6 +1,8 @@
 #pragma once
 #include <bave/core/c_string.hpp>
 #include <bave/core/polymorphic.hpp>
+#include <bave/data_view.hpp>
+#include <bave/io/file_watcher.hpp>
 #include <cstddef>
 #include <string>
 #include <vector>
@@ -20,6 +22,21 @@ class IDataLoader : public Polymorphic {
 	/// \returns true if successful.
 	[[nodiscard]] virtual auto read_bytes(std::vector<std::byte>& out, std::string_view uri) const -> bool = 0;
 
+	/// \brief Map bytes from a given URI without copying them, where supported.
+	/// \param uri URI to map.
+	/// \returns DataView of mapped bytes, invalid on failure (see DataView::is_valid()).
+	///
+	/// The default implementation reads bytes into owned storage.
+	[[nodiscard]] virtual auto map(std::string_view uri) const -> DataView {
+		auto bytes = std::vector<std::byte>{};
+		if (!read_bytes(bytes, uri)) { return {}; }
+		return DataView::from(std::move(bytes));
+	}
+
+	/// \brief Create a watcher for modified resources, where supported.
+	/// \returns FileWatcher whose reported paths are URIs, nullptr if unsupported.
+	[[nodiscard]] virtual auto make_watcher() const -> std::unique_ptr<FileWatcher> { return {}; }
+
 	/// \brief Read string from a given URI.
 	/// \param out Storage for string to be read.
 	/// \param uri URI to read from.
@@ -33,6 +33,12 @@ class DataStore {
 	/// \param uri URI to read from.
 	/// \returns Vector of bytes, empty on failure.
 	[[nodiscard]] auto read_bytes(std::string_view uri) const -> std::vector<std::byte>;
+	/// \brief Map bytes from a given URI.
+	/// \param uri URI to map.
+	/// \returns DataView of bytes, invalid on failure (valid and empty for zero-byte files).
+	///
+	/// See file::map() for the constraints on modifying mapped files.
+	[[nodiscard]] auto map(std::string_view uri) const -> DataView;
 	/// \brief Read string from a given URI.
 	/// \param uri URI to read from.
 	/// \returns String, empty on failure.
@@ -42,6 +48,10 @@ class DataStore {
 	/// \returns JSON, null object on failure.
 	[[nodiscard]] auto read_json(std::string_view uri) const -> dj::Json;
 
+	/// \brief Create a watcher for modified resources.
+	/// \returns FileWatcher if supported by the loader, else nullptr.
+	[[nodiscard]] auto make_watcher() const -> std::unique_ptr<FileWatcher>;
+
 	/// \brief Convert a GLSL URI to SPIR-V.
 	/// \param glsl GLSL URI.
 	/// \returns SPIR-V URI if exists, else empty string.
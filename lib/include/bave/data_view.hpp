@@ -0,0 +1,57 @@
+#pragma once
+#include <cstddef>
+#include <memory>
+#include <span>
+#include <vector>
+
+namespace bave {
+/// \brief Ref-counted read-only view of loaded data.
+///
+/// The viewed bytes remain valid as long as any copy of the view is alive.
+class DataView {
+  public:
+	DataView() = default;
+
+	/// \brief Construct a view whose storage is kept alive by an owner.
+	/// \param owner Owner of the viewed storage.
+	/// \param bytes View into the owned storage.
+	explicit DataView(std::shared_ptr<void const> owner, std::span<std::byte const> bytes) : m_owner(std::move(owner)), m_bytes(bytes) {}
+
+	/// \brief Construct a view that owns its bytes.
+	/// \param bytes Bytes to take ownership of.
+	/// \returns DataView.
+	[[nodiscard]] static auto from(std::vector<std::byte> bytes) -> DataView {
+		auto owner = std::make_shared<std::vector<std::byte> const>(std::move(bytes));
+		auto const span = std::span<std::byte const>{*owner};
+		return DataView{std::move(owner), span};
+	}
+
+	[[nodiscard]] auto get_bytes() const -> std::span<std::byte const> { return m_bytes; }
+	[[nodiscard]] auto get_size() const -> std::size_t { return m_bytes.size(); }
+	[[nodiscard]] auto is_empty() const -> bool { return m_bytes.empty(); }
+	/// \brief Check if this views loaded data, including zero bytes (eg an empty file).
+	/// \returns false if default constructed (failed to load).
+	[[nodiscard]] auto is_valid() const -> bool { return m_owner != nullptr || !m_bytes.empty(); }
+
+	/// \brief Obtain a view into a sub-range of bytes, sharing ownership.
+	/// \param offset Offset of first byte.
+	/// \param count Number of bytes.
+	/// \returns DataView of sub-range.
+	/// \pre offset + count must not exceed get_size().
+	[[nodiscard]] auto subview(std::size_t const offset, std::size_t const count) const -> DataView {
+		return DataView{m_owner, m_bytes.subspan(offset, count)};
+	}
+
+	/// \brief Copy viewed bytes into a vector.
+	/// \returns Copy of viewed bytes.
+	[[nodiscard]] auto to_vector() const -> std::vector<std::byte> { return {m_bytes.begin(), m_bytes.end()}; }
+
+	operator std::span<std::byte const>() const { return m_bytes; }
+
+	explicit operator bool() const { return !is_empty(); }
+
+  private:
+	std::shared_ptr<void const> m_owner{};
+	std::span<std::byte const> m_bytes{};
+};
+} // namespace bave
@@ -37,6 +37,10 @@ class DesktopApp : private App, private detail::IWsi {
 		DisplayMode mode{Windowed{}};
 		std::function<Gpu(std::span<Gpu const>)> select_gpu{};
 		vk::SampleCountFlagBits msaa{vk::SampleCountFlagBits::e1};
+		/// \brief Frames in flight (1-3).
+		std::uint32_t frames_in_flight{RenderDeviceCreateInfo{}.frames_in_flight};
+		/// \brief Target frame rate, 0 to uncap.
+		int target_fps{};
 		std::unique_ptr<IDataLoader> data_loader{};
 		std::string persistent_dir{};
 		std::string log_filename{"bave.log"};
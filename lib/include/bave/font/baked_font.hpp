@@ -0,0 +1,77 @@
+#pragma once
+#include <bave/core/inclusive_range.hpp>
+#include <bave/core/ptr.hpp>
+#include <bave/font/detail/glyph_slot.hpp>
+#include <bave/graphics/rect.hpp>
+#include <cstdint>
+#include <span>
+#include <string_view>
+#include <vector>
+
+namespace bave {
+/// \brief Pre-rasterized glyph atlases for a set of TextHeights.
+///
+/// Serialized form (little endian):
+/// header: magic ("BVFA"), version, scale, atlas count.
+/// atlas: height, codepoint range, extent, glyph count, glyphs, alpha bytes (extent.x * extent.y).
+struct BakedFont {
+	struct Glyph;
+	struct Atlas;
+
+	static constexpr std::uint32_t version_v{2};
+	static constexpr std::string_view extension_v{".bfont"};
+	static constexpr float default_scale_v{2.0f};
+	static constexpr auto default_codepoints_v = InclusiveRange<Codepoint>{.lo = Codepoint::eAsciiFirst, .hi = Codepoint::eAsciiLast};
+
+	/// \brief Scale factor atlases were rasterized at.
+	float scale{};
+	/// \brief Baked atlases.
+	std::vector<Atlas> atlases{};
+
+	/// \brief Rasterize glyph atlases.
+	/// \param slot_factory Glyph source (loaded font file).
+	/// \param heights TextHeights to bake atlases for.
+	/// \param codepoints Range of codepoints to bake (tofu is always included).
+	/// \param scale Scale factor for glyph and atlas generation.
+	/// \returns BakedFont.
+	[[nodiscard]] static auto bake(detail::GlyphSlot::Factory& slot_factory, std::span<TextHeight const> heights,
+								   InclusiveRange<Codepoint> codepoints = default_codepoints_v, float scale = default_scale_v) -> BakedFont;
+
+	/// \brief Attempt to deserialize a BakedFont.
+	/// \param bytes Bytestream to read from.
+	/// \returns true on success.
+	auto deserialize(std::span<std::byte const> bytes) -> bool;
+	/// \brief Serialize into a bytestream.
+	/// \returns Serialized bytes.
+	[[nodiscard]] auto serialize() const -> std::vector<std::byte>;
+
+	/// \brief Obtain the baked atlas for a given TextHeight.
+	/// \param height TextHeight to search for.
+	/// \returns Pointer to Atlas if present, else nullptr.
+	[[nodiscard]] auto find_atlas(TextHeight height) const -> Ptr<Atlas const>;
+};
+
+/// \brief Metrics of a single baked glyph.
+struct BakedFont::Glyph {
+	Codepoint codepoint{};
+	glm::ivec2 advance{};
+	glm::ivec2 extent{};
+	glm::ivec2 left_top{};
+	/// \brief Pixel rect within the atlas (zero for glyphs without bitmaps).
+	Rect<int> rect{};
+};
+
+/// \brief Baked atlas for a single TextHeight.
+struct BakedFont::Atlas {
+	/// \brief Unscaled text height.
+	TextHeight height{};
+	/// \brief Range of codepoints that was baked (tofu is always included).
+	InclusiveRange<Codepoint> codepoints{default_codepoints_v};
+	glm::ivec2 extent{};
+	std::vector<Glyph> glyphs{};
+	/// \brief Coverage of each pixel, row-major.
+	std::vector<std::uint8_t> alpha{};
+
+	[[nodiscard]] auto find_glyph(Codepoint codepoint) const -> Ptr<Glyph const>;
+};
+} // namespace bave
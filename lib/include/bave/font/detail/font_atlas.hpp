@@ -1,5 +1,6 @@
 #pragma once
 #include <bave/core/inclusive_range.hpp>
+#include <bave/font/baked_font.hpp>
 #include <bave/font/detail/glyph_page.hpp>
 #include <bave/font/glyph.hpp>
 #include <bave/graphics/pixmap.hpp>
@@ -9,7 +10,13 @@
 namespace bave::detail {
 class FontAtlas {
   public:
-	explicit FontAtlas(NotNull<RenderDevice*> render_device, NotNull<GlyphSlot::Factory*> slot_factory, TextHeight height = TextHeight::eDefault);
+	explicit FontAtlas(NotNull<RenderDevice*> render_device, NotNull<GlyphSlot::Factory*> slot_factory, TextHeight height = TextHeight::eDefault,
+					   InclusiveRange<Codepoint> codepoints = BakedFont::default_codepoints_v);
+	/// \brief Construct from a baked atlas, rasterizing only glyphs in its codepoint range missing from it through slot_factory.
+	explicit FontAtlas(NotNull<RenderDevice*> render_device, NotNull<GlyphSlot::Factory*> slot_factory, BakedFont::Atlas const& baked, TextHeight height);
+
+	/// \brief Rasterize and pack glyphs without uploading them.
+	[[nodiscard]] static auto bake(GlyphSlot::Factory& slot_factory, TextHeight height, InclusiveRange<Codepoint> codepoints) -> BakedFont::Atlas;
 
 	[[nodiscard]] auto glyph_for(Codepoint codepoint) const -> Glyph;
 
@@ -17,6 +24,8 @@ class FontAtlas {
 	[[nodiscard]] auto get_texture() const -> std::shared_ptr<Texture const> const& { return m_texture; }
 
   private:
+	void upload(NotNull<RenderDevice*> render_device, BitmapView bitmap);
+
 	std::shared_ptr<Texture const> m_texture{};
 	GlyphPage m_page;
 	std::unordered_map<Codepoint, Glyph> m_glyphs{};
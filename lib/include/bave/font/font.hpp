@@ -1,6 +1,7 @@
 #pragma once
 #include <bave/core/inclusive_range.hpp>
 #include <bave/core/not_null.hpp>
+#include <bave/font/baked_font.hpp>
 #include <bave/font/detail/font_atlas.hpp>
 #include <bave/graphics/geometry.hpp>
 #include <bave/graphics/rgba.hpp>
@@ -13,7 +14,7 @@ class Font {
   public:
 	class Pen;
 
-	static constexpr auto scale_v{2.0f};
+	static constexpr auto scale_v{BakedFont::default_scale_v};
 	static constexpr auto scale_limit_v = InclusiveRange<float>{1.0f, 16.0f};
 
 	/// \brief Constructor.
@@ -25,6 +26,19 @@ class Font {
 	/// \param scale Scale factor for glyph and atlas generation.
 	/// \returns true on success.
 	auto load_from_bytes(std::vector<std::byte> file_bytes, float scale = scale_v) -> bool;
+	/// \brief Attach pre-baked glyph atlases.
+	/// \param baked BakedFont to use for matching TextHeights.
+	/// \returns true on success.
+	///
+	/// Glyphs missing in baked atlases are rasterized at runtime if a font file has been loaded.
+	/// Atlases created at runtime for other TextHeights cover the same codepoint range.
+	auto load_baked(BakedFont baked) -> bool;
+
+	/// \brief Rasterize glyph atlases for offline use.
+	/// \param heights TextHeights to bake atlases for.
+	/// \param codepoints Range of codepoints to bake (tofu is always included).
+	/// \returns BakedFont, empty if font file has not been loaded.
+	[[nodiscard]] auto bake(std::span<TextHeight const> heights, InclusiveRange<Codepoint> codepoints = BakedFont::default_codepoints_v) const -> BakedFont;
 
 	/// \brief Create font atlas for a specific text height.
 	/// \param height TextHeight to create atlas for.
@@ -34,7 +48,7 @@ class Font {
 	[[nodiscard]] auto glyph_for(TextHeight height, Codepoint codepoint) -> Glyph;
 	[[nodiscard]] auto get_texture(TextHeight height) -> std::shared_ptr<Texture const>;
 
-	[[nodiscard]] auto is_loaded() const -> bool { return m_slot_factory != nullptr; }
+	[[nodiscard]] auto is_loaded() const -> bool { return m_slot_factory != nullptr || m_has_baked; }
 
 	[[nodiscard]] auto get_render_device() const -> RenderDevice& { return *m_render_device; }
 	[[nodiscard]] auto get_font_atlas(TextHeight height) -> Ptr<detail::FontAtlas const>;
@@ -44,6 +58,9 @@ class Font {
 	std::unique_ptr<detail::GlyphSlot::Factory> m_slot_factory{};
 	float m_scale{};
 	std::unordered_map<TextHeight, detail::FontAtlas> m_atlases{};
+	std::unordered_map<TextHeight, BakedFont::Atlas> m_baked{};
+	InclusiveRange<Codepoint> m_codepoints{BakedFont::default_codepoints_v};
+	bool m_has_baked{};
 };
 
 class Font::Pen {
@@ -0,0 +1,52 @@
+#pragma once
+#include <bave/data_view.hpp>
+#include <bave/graphics/bitmap.hpp>
+#include <vulkan/vulkan.hpp>
+#include <vector>
+
+namespace bave {
+/// \brief GPU-ready image payload (KTX2 container), with precomputed mip levels.
+///
+/// Only 2D, single layer, non-supercompressed KTX2 files are supported.
+/// Files with unknown formats (detail::get_format_block()), more levels than the full mip chain, or levels smaller than their extent are rejected.
+/// Payloads are viewed in place: no copies are made.
+class CompressedImage {
+  public:
+	static constexpr std::string_view extension_v{".ktx2"};
+
+	struct Level {
+		std::span<std::byte const> bytes{};
+		glm::ivec2 extent{};
+	};
+
+	/// \brief Check if bytes start with the KTX2 identifier.
+	/// \param bytes Bytes to check.
+	/// \returns true if bytes are a KTX2 file.
+	[[nodiscard]] static auto is_ktx2(std::span<std::byte const> bytes) -> bool;
+
+	/// \brief Attempt to load a KTX2 file.
+	/// \param bytes View of KTX2 file, kept alive by this instance.
+	/// \returns true on success.
+	auto load_from_ktx2(DataView bytes) -> bool;
+
+	[[nodiscard]] auto get_format() const -> vk::Format { return m_format; }
+	[[nodiscard]] auto get_extent() const -> glm::ivec2 { return m_levels.empty() ? glm::ivec2{} : m_levels.front().extent; }
+	[[nodiscard]] auto get_levels() const -> std::span<Level const> { return m_levels; }
+	[[nodiscard]] auto get_size() const -> std::size_t;
+
+	/// \brief Check if the format is block-compressed.
+	[[nodiscard]] auto is_block_compressed() const -> bool;
+	/// \brief Obtain the base level as a bitmap, if the format is 8-bit RGBA.
+	/// \returns BitmapView of base level, empty if the format is not RGBA8.
+	[[nodiscard]] auto get_rgba_bitmap() const -> BitmapView;
+
+	[[nodiscard]] auto is_empty() const -> bool { return m_levels.empty(); }
+
+	explicit operator bool() const { return !is_empty(); }
+
+  private:
+	DataView m_bytes{};
+	vk::Format m_format{};
+	std::vector<Level> m_levels{};
+};
+} // namespace bave
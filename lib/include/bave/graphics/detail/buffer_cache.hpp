@@ -4,13 +4,17 @@
 #include <bave/graphics/detail/render_resource.hpp>
 #include <bave/logger.hpp>
 #include <array>
-#include <vector>
+#include <deque>
+#include <mutex>
 
 namespace bave::detail {
 class BufferCache {
   public:
 	explicit BufferCache(NotNull<RenderDevice*> render_device);
 
+	/// \brief Allocate a scratch buffer for the current frame.
+	///
+	/// Thread safe, but the returned buffer is only valid until this frame index comes around again.
 	auto allocate(BufferType type) -> RenderBuffer&;
 
 	[[nodiscard]] auto get_empty(BufferType type) const -> RenderBuffer const& { return m_empty_buffers.at(static_cast<std::size_t>(type)); }
@@ -19,12 +23,15 @@ class BufferCache {
 		return buffer == nullptr ? get_empty(type) : *buffer;
 	}
 
+	[[nodiscard]] auto buffer_count() const -> std::size_t;
+
 	auto next_frame() -> void;
 	auto clear() -> void;
 
   private:
 	struct Pool {
-		std::vector<RenderBuffer> buffers{};
+		// deque: references to allocated buffers remain valid while other threads allocate.
+		std::deque<RenderBuffer> buffers{};
 		std::size_t next{};
 	};
 
@@ -36,5 +43,6 @@ class BufferCache {
 	NotNull<RenderDevice*> m_render_device;
 	std::array<RenderBuffer, types_count_v> m_empty_buffers;
 	Buffered<Map> m_maps{};
+	mutable std::mutex m_mutex{};
 };
 } // namespace bave::detail
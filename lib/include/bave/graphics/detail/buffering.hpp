@@ -2,15 +2,20 @@
 #include <array>
 
 namespace bave::detail {
+// maximum frames in flight: capacity of Buffered.
+constexpr std::size_t max_buffering_v{3};
+// default frames in flight.
 constexpr std::size_t buffering_v{2};
 
 template <typename Type>
-using Buffered = std::array<Type, buffering_v>;
+using Buffered = std::array<Type, max_buffering_v>;
 
 struct FrameIndex {
 	std::size_t value{};
+	// frames in flight: only the first count elements of a Buffered are used.
+	std::size_t count{buffering_v};
 
-	constexpr auto increment() -> void { value = (value + 1) % buffering_v; }
+	constexpr auto increment() -> void { value = (value + 1) % count; }
 
 	constexpr operator std::size_t() const { return value; }
 };
@@ -34,6 +39,6 @@ auto make_buffered_impl(FactoryT factory, std::index_sequence<I...> /*is*/) {
 
 template <typename Type, typename FactoryT>
 auto make_buffered(FactoryT factory) -> Buffered<Type> {
-	return make_buffered_impl<Type>(std::move(factory), std::make_index_sequence<buffering_v>());
+	return make_buffered_impl<Type>(std::move(factory), std::make_index_sequence<max_buffering_v>());
 }
 } // namespace bave::detail
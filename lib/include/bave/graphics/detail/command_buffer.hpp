@@ -1,24 +1,148 @@
 #pragma once
 #include <bave/core/not_null.hpp>
+#include <bave/core/pinned.hpp>
 #include <vulkan/vulkan.hpp>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
 
 namespace bave {
 class RenderDevice;
 
 namespace detail {
-class CommandBuffer {
+/// \brief Immediate submit context: transient command pools, one per thread, with pooled command buffers and fences.
+///
+/// Command pools must be externally synchronized: a pool per thread lets uploads be recorded concurrently.
+/// Command buffers and fences are recycled once their submission completes, instead of being created per submit.
+/// Submissions that are not waited on are tracked until their fence signals: polled by the owning thread on its next acquire,
+/// and by next_frame() (called every frame by RenderDevice on the main thread).
+/// Command buffers and fences are only ever recycled by the owning thread, but resources kept alive for a submission
+/// are released by whichever thread observes its completion first: often the main thread, so they must be safe to destroy on any thread.
+/// A thread's pool is destroyed when the thread exits (or calls release_thread()), once its submissions have completed.
+class CommandPools {
+  public:
+	using Resource = std::shared_ptr<void>;
+
+	/// \brief Per-thread pool.
+	class Pool {
+	  public:
+		explicit Pool(vk::Device device, std::uint32_t queue_family);
+		/// \brief Blocks until in-flight submissions complete: their command buffers are freed with the pool.
+		~Pool();
+
+		Pool(Pool const&) = delete;
+		Pool(Pool&&) = delete;
+		auto operator=(Pool const&) -> Pool& = delete;
+		auto operator=(Pool&&) -> Pool& = delete;
+
+		/// \brief Obtain a command buffer ready for recording (owning thread only).
+		[[nodiscard]] auto acquire() -> vk::CommandBuffer;
+		/// \brief Return an unsubmitted command buffer (owning thread only).
+		void release(vk::CommandBuffer cb);
+		/// \brief Submit a recorded command buffer (owning thread only).
+		/// \param render_device RenderDevice to submit to.
+		/// \param cb Recorded command buffer, acquired from this pool.
+		/// \param resources Resources used by cb, kept alive until it completes.
+		/// \param wait Whether to block until the submission completes.
+		/// \returns false if submission failed.
+		auto submit(RenderDevice& render_device, vk::CommandBuffer cb, std::vector<Resource> resources, bool wait) -> bool;
+
+	  private:
+		struct Submission {
+			vk::CommandBuffer cb{};
+			vk::UniqueFence fence{};
+			std::vector<Resource> resources{};
+			bool complete{};
+		};
+
+		auto poll(bool recycle) -> std::vector<Resource>;
+		[[nodiscard]] auto acquire_fence() -> vk::UniqueFence;
+		void recycle(vk::CommandBuffer cb, vk::UniqueFence fence);
+
+		vk::Device m_device{};
+		vk::UniqueCommandPool m_pool{};
+		// accessed only by the owning thread.
+		std::vector<vk::CommandBuffer> m_free_cbs{};
+		std::vector<vk::UniqueFence> m_free_fences{};
+		// also polled by next_frame().
+		std::vector<Submission> m_in_flight{};
+		std::mutex m_mutex{};
+
+		friend class CommandPools;
+	};
+
+	explicit CommandPools(vk::Device device, std::uint32_t queue_family);
+	~CommandPools();
+
+	CommandPools(CommandPools const&) = delete;
+	CommandPools(CommandPools&&) = delete;
+	auto operator=(CommandPools const&) -> CommandPools& = delete;
+	auto operator=(CommandPools&&) -> CommandPools& = delete;
+
+	/// \brief Obtain the calling thread's pool (created on first use).
+	[[nodiscard]] auto get() -> Pool&;
+	/// \brief Destroy the calling thread's pool (if any), blocking until its submissions complete.
+	///
+	/// Called automatically when a thread that obtained a pool exits. No CommandBuffer of the calling thread may be alive.
+	void release_thread();
+
+	[[nodiscard]] auto pool_count() const -> std::size_t;
+	/// \brief Number of submissions that have not yet been observed to complete.
+	[[nodiscard]] auto in_flight_count() const -> std::size_t;
+
+	/// \brief Release resources of completed submissions on all threads' pools (on the calling thread).
+	void next_frame();
+
+  private:
+	// shared with threads that obtained a pool, to release it on exit.
+	struct Shared {
+		std::unordered_map<std::thread::id, std::unique_ptr<Pool>> pools{};
+		std::shared_mutex mutex{};
+	};
+	struct ThreadExit;
+
+	static void release(Shared& shared, std::thread::id thread);
+
+	vk::Device m_device;
+	std::uint32_t m_queue_family;
+	std::shared_ptr<Shared> m_shared{std::make_shared<Shared>()};
+};
+
+/// \brief One-time submit command buffer, acquired from the calling thread's pool.
+///
+/// Must be submitted (or destroyed) on the constructing thread.
+class CommandBuffer : public Pinned {
   public:
 	CommandBuffer(RenderDevice const& render_device);
+	~CommandBuffer();
 
 	[[nodiscard]] auto get() const -> vk::CommandBuffer { return m_cb; }
 
+	/// \brief Keep a resource used by recorded commands alive until they complete.
+	template <typename Type>
+	void keep_alive(std::shared_ptr<Type> resource) {
+		if (resource) { m_resources.push_back(std::move(resource)); }
+	}
+
+	/// \brief Submit and block until complete (eg for read backs).
 	auto submit(RenderDevice& render_device) -> void;
+	/// \brief Submit without blocking.
+	///
+	/// Commands are executed in queue submission order, so subsequent frames observe the results.
+	/// Resources passed to keep_alive() are released once the submission completes, on any thread (see CommandPools).
+	auto submit_deferred(RenderDevice& render_device) -> void;
 
 	operator vk::CommandBuffer() const { return get(); }
 
   private:
-	vk::UniqueCommandPool m_pool{};
+	void do_submit(RenderDevice& render_device, bool wait);
+
+	NotNull<CommandPools::Pool*> m_pool;
 	vk::CommandBuffer m_cb{};
+	std::vector<CommandPools::Resource> m_resources{};
 };
 } // namespace detail
 } // namespace bave
@@ -21,7 +21,7 @@ class DeferQueue {
   private:
 	using Frame = std::vector<std::shared_ptr<void>>;
 
-	std::array<Frame, buffering_v> m_queue{};
+	std::array<Frame, max_buffering_v> m_queue{};
 	std::mutex m_mutex{};
 };
 } // namespace bave::detail
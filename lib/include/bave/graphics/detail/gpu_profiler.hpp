@@ -0,0 +1,61 @@
+#pragma once
+#include <bave/graphics/render_device.hpp>
+#include <bave/profiler.hpp>
+#include <vulkan/vulkan.hpp>
+#include <optional>
+
+namespace bave::detail {
+/// \brief Records GPU timestamps per buffered frame and reports them to Profiler once resolved.
+class GpuProfiler {
+  public:
+	/// \brief Maximum timestamps per frame (two per scope).
+	static constexpr std::uint32_t max_queries_v{512};
+
+	using Scope = std::uint32_t;
+
+	explicit GpuProfiler(NotNull<RenderDevice const*> render_device);
+
+	[[nodiscard]] auto is_supported() const -> bool { return m_period > 0.0f; }
+
+	/// \brief Resolve the previous queries of the current frame slot and reset them.
+	/// \param command_buffer Command buffer of the frame (outside a render pass).
+	/// \pre The frame slot's fence must have been waited on.
+	void begin_frame(vk::CommandBuffer command_buffer);
+
+	/// \brief Write a timestamp at the start of a scope.
+	/// \param command_buffer Command buffer to record into.
+	/// \param name Name of scope (must outlive Profiler, eg a string literal).
+	/// \returns Scope to end, std::nullopt if not recording.
+	[[nodiscard]] auto begin_scope(vk::CommandBuffer command_buffer, std::string_view name) -> std::optional<Scope>;
+	/// \brief Write a timestamp at the end of a scope.
+	/// \param command_buffer Command buffer to record into.
+	/// \param scope Scope returned by begin_scope().
+	void end_scope(vk::CommandBuffer command_buffer, std::optional<Scope> scope);
+
+  private:
+	struct Pending {
+		std::string_view name{};
+		std::uint32_t query{};
+		int depth{};
+	};
+
+	struct Slot {
+		vk::UniqueQueryPool pool{};
+		std::vector<Pending> pending{};
+		std::uint64_t profiler_frame{};
+		std::uint32_t next_query{};
+		int depth{};
+		bool recording{};
+	};
+
+	void resolve(Slot& slot);
+
+	NotNull<RenderDevice const*> m_render_device;
+	Buffered<Slot> m_slots{};
+	std::vector<std::uint64_t> m_results{};
+	std::vector<Profiler::GpuSample> m_samples{};
+	// nanoseconds per tick.
+	float m_period{};
+	std::uint64_t m_mask{};
+};
+} // namespace bave::detail
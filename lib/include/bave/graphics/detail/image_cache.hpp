@@ -1,24 +1,102 @@
 #pragma once
 #include <bave/graphics/detail/render_resource.hpp>
 #include <bave/logger.hpp>
+#include <atomic>
 #include <memory>
 #include <mutex>
+#include <unordered_map>
 #include <vector>
 
 namespace bave::detail {
+/// \brief Pool of RenderImages.
+///
+/// Images are returned to the pool when their last owner releases them (Texture defers that until in-flight frames are done),
+/// and bucketed by everything that determines the underlying Vulkan Image: format, usage, extent, mip levels, etc.
+/// allocate() reuses a compatible free image if one exists (O(1)), without a new device allocation or layout transition.
+/// Free images that exceed the trim policy are destroyed in next_frame().
+///
+/// allocate() is thread safe.
 class ImageCache {
   public:
-	explicit ImageCache(NotNull<RenderDevice*> render_device) : m_render_device(render_device) {}
+	struct TrimPolicy {
+		/// \brief Free images idle for more than this many frames are destroyed.
+		std::uint64_t max_idle_frames{120};
+		/// \brief Maximum free images retained, oldest are destroyed first.
+		std::size_t max_free_images{64};
+		/// \brief Maximum device memory held by free images, oldest are destroyed first.
+		vk::DeviceSize max_free_bytes{64 * 1024 * 1024};
+	};
+
+	explicit ImageCache(NotNull<RenderDevice*> render_device);
 
 	auto allocate(RenderImage::CreateInfo const& create_info, vk::Extent2D extent = {1, 1}) -> std::shared_ptr<RenderImage>;
 
+	[[nodiscard]] auto get_trim_policy() const -> TrimPolicy;
+	void set_trim_policy(TrimPolicy const& policy);
+
+	/// \brief Total images alive (in use and free).
 	[[nodiscard]] auto image_count() const -> std::size_t;
+	/// \brief Images in the pool, available for reuse.
+	[[nodiscard]] auto free_count() const -> std::size_t;
+
+	/// \brief Destroy free images according to the trim policy.
+	auto next_frame() -> void;
+	/// \brief Destroy all free images, releasing their device memory back to the allocator.
+	auto trim() -> void;
 	auto clear() -> void;
 
   private:
+	struct Key {
+		vk::Format format{};
+		vk::ImageUsageFlags usage{};
+		vk::ImageAspectFlagBits aspect{};
+		vk::ImageTiling tiling{};
+		vk::ImageLayout layout{};
+		vk::SampleCountFlagBits samples{};
+		vk::ImageViewType view_type{};
+		vk::Extent2D extent{};
+		std::uint32_t mip_levels{};
+		bool mip_map{};
+		bool lazily_allocated{};
+
+		auto operator==(Key const&) const -> bool = default;
+	};
+
+	struct Hasher {
+		auto operator()(Key const& key) const -> std::size_t;
+	};
+
+	struct Entry {
+		std::unique_ptr<RenderImage> image{};
+		vk::DeviceSize size{};
+		std::uint64_t released{};
+	};
+
+	// shared with the deleters of allocated images, which may outlive the cache.
+	struct Pool {
+		std::unordered_map<Key, std::vector<Entry>, Hasher> buckets{};
+		TrimPolicy policy{};
+		std::uint64_t frame{};
+		std::size_t free_count{};
+		vk::DeviceSize free_bytes{};
+		std::atomic<std::size_t> image_count{};
+		std::mutex mutex{};
+	};
+
+	struct Recycler {
+		std::weak_ptr<Pool> pool{};
+
+		void operator()(RenderImage* image) const;
+	};
+
+	static auto make_key(RenderImage::CreateInfo const& create_info, vk::Extent2D extent) -> Key;
+	static auto make_key(RenderImage const& image) -> Key;
+
+	auto make_recycled(std::unique_ptr<RenderImage> image) -> std::shared_ptr<RenderImage>;
+	static auto evict_oldest(Pool& pool) -> std::unique_ptr<RenderImage>;
+
 	Logger m_log{"ImageCache"};
 	NotNull<RenderDevice*> m_render_device;
-	std::vector<std::shared_ptr<RenderImage>> m_images{};
-	mutable std::mutex m_mutex{};
+	std::shared_ptr<Pool> m_pool{std::make_shared<Pool>()};
 };
 } // namespace bave::detail
@@ -0,0 +1,49 @@
+#pragma once
+#include <bave/core/not_null.hpp>
+#include <bave/core/pinned.hpp>
+#include <bave/graphics/detail/render_resource.hpp>
+#include <bave/logger.hpp>
+#include <memory>
+#include <vector>
+
+namespace bave::detail {
+/// \brief Records uploads to multiple images, and their mip generation, into one command buffer.
+///
+/// Barriers are merged across images: one pipeline barrier per mip level for the whole batch, instead of a pair per image per level.
+/// If a format does not support linear filtering, full uploads of 8-bit RGBA / BGRA bitmaps have their mips
+/// generated on the CPU (box filter, in linear space for sRGB formats), other uploads are blitted with nearest filtering.
+/// Staged uploads are submitted (deferred) on destruction, where failures are logged instead of thrown.
+class ImageUploader : public Pinned {
+  public:
+	explicit ImageUploader(NotNull<RenderDevice*> render_device) : m_render_device(render_device) {}
+	~ImageUploader();
+
+	/// \brief Stage a bitmap to be written to an image, and regenerate its mip levels.
+	/// \param image Image to write to (must outlive the submit).
+	/// \param bitmap Bitmap to copy (into a staging buffer).
+	/// \param top_left Offset into image to write to.
+	/// \returns false if image is a cubemap or bitmap does not fit.
+	auto upload(RenderImage& image, BitmapView bitmap, glm::ivec2 top_left = {}) -> bool;
+
+	[[nodiscard]] auto get_upload_count() const -> std::size_t { return m_uploads.size(); }
+
+	/// \brief Record and submit all staged uploads.
+	/// \throws Error if a command buffer cannot be allocated.
+	void submit();
+
+  private:
+	struct Upload {
+		NotNull<RenderImage*> image;
+		std::shared_ptr<RenderBuffer> staging{};
+		std::vector<vk::BufferImageCopy> regions{};
+		// layout to transition from: undefined for full uploads, as previous contents are discarded.
+		vk::ImageLayout initial_layout{};
+		vk::Filter filter{vk::Filter::eLinear};
+		bool blit_mips{};
+	};
+
+	Logger m_log{"ImageUploader"};
+	NotNull<RenderDevice*> m_render_device;
+	std::vector<Upload> m_uploads{};
+};
+} // namespace bave::detail
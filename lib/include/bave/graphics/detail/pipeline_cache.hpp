@@ -2,6 +2,7 @@
 #include <bave/graphics/detail/descriptor_cache.hpp>
 #include <bave/graphics/detail/set_layout.hpp>
 #include <bave/graphics/detail/shader_cache.hpp>
+#include <shared_mutex>
 #include <span>
 
 namespace bave::detail {
@@ -18,9 +19,21 @@ class PipelineCache {
 		vk::ShaderModule fragment{};
 	};
 
+	/// \brief Render pass (and its sample count) that pipelines are built for.
+	struct Pass {
+		vk::RenderPass render_pass{};
+		vk::SampleCountFlagBits samples{vk::SampleCountFlagBits::e1};
+	};
+
 	explicit PipelineCache(vk::RenderPass render_pass, NotNull<RenderDevice*> render_device, NotNull<DataStore const*> data_store);
 
+	/// \brief Load a pipeline for the backbuffer render pass.
 	[[nodiscard]] auto load_pipeline(Program shader, State state) -> vk::Pipeline;
+	/// \brief Load a pipeline for a given render pass.
+	/// \param pass Render pass to build for (must outlive this instance).
+	///
+	/// Thread safe: lookups take a shared lock, pipelines are built outside the lock.
+	[[nodiscard]] auto load_pipeline(Program shader, State state, Pass pass) -> vk::Pipeline;
 
 	[[nodiscard]] auto get_shader_cache() const -> ShaderCache const& { return m_shader_cache; }
 	[[nodiscard]] auto get_shader_cache() -> ShaderCache& { return m_shader_cache; }
@@ -31,14 +44,21 @@ class PipelineCache {
 	[[nodiscard]] auto get_descriptor_set_layouts() const -> std::span<vk::DescriptorSetLayout const> { return m_descriptor_set_layouts_view; }
 
 	[[nodiscard]] auto shader_count() const -> std::size_t { return m_shader_cache.shader_count(); }
-	[[nodiscard]] auto pipeline_count() const -> std::size_t { return m_pipelines.size(); }
+	[[nodiscard]] auto pipeline_count() const -> std::size_t;
 
 	void clear_loaded();
 
+	/// \brief Invalidate shader modules loaded from a modified URI, and pipelines using them.
+	/// \param uri URI of modified GLSL / SPIR-V.
+	/// \returns true if any shader module was invalidated.
+	///
+	/// Invalidated objects are destroyed once in-flight frames are done with them.
+	auto invalidate(std::string_view uri) -> bool;
+
   private:
 	struct Key {
 	  public:
-		explicit Key(Program shader, State state);
+		explicit Key(Program shader, State state, Pass pass);
 
 		[[nodiscard]] auto hash() const -> std::size_t { return cached_hash; }
 
@@ -46,6 +66,7 @@ class PipelineCache {
 
 		Program shader{};
 		State state{};
+		Pass pass{};
 		std::size_t cached_hash{};
 	};
 
@@ -62,11 +83,12 @@ class PipelineCache {
 
 	Logger m_log{"PipelineCache"};
 
+	NotNull<RenderDevice*> m_render_device;
 	ShaderCache m_shader_cache;
 	DescriptorCache m_descriptor_cache;
-	vk::RenderPass m_render_pass{};
-	vk::SampleCountFlagBits m_samples{};
+	Pass m_backbuffer{};
 	std::unordered_map<Key, vk::UniquePipeline, Hasher> m_pipelines{};
+	mutable std::shared_mutex m_mutex{};
 	std::vector<vk::UniqueDescriptorSetLayout> m_descriptor_set_layouts{};
 	std::vector<vk::DescriptorSetLayout> m_descriptor_set_layouts_view{};
 	vk::UniquePipelineLayout m_pipeline_layout{};
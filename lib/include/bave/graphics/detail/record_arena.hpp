@@ -0,0 +1,36 @@
+#pragma once
+#include <bave/graphics/detail/buffer_cache.hpp>
+#include <bave/graphics/detail/descriptor_cache.hpp>
+#include <bave/graphics/render_stats.hpp>
+#include <vector>
+
+namespace bave::detail {
+/// \brief Per-thread recording resources: secondary command buffers and scratch buffers / descriptor sets.
+///
+/// An arena must only be used by one thread at a time.
+class RecordArena {
+  public:
+	explicit RecordArena(NotNull<RenderDevice*> render_device);
+
+	/// \brief Obtain an unused secondary command buffer for the current frame.
+	[[nodiscard]] auto allocate_command_buffer() -> vk::CommandBuffer;
+
+	/// \brief Recycle resources of the current frame (its fence must have been waited on).
+	auto next_frame() -> void;
+
+	BufferCache buffer_cache;
+	DescriptorCache descriptor_cache;
+	/// \brief Counters accumulated since last collected by Renderer.
+	RenderStats stats{};
+
+  private:
+	struct Pool {
+		vk::UniqueCommandPool command_pool{};
+		std::vector<vk::CommandBuffer> command_buffers{};
+		std::size_t next{};
+	};
+
+	NotNull<RenderDevice*> m_render_device;
+	Buffered<Pool> m_pools{};
+};
+} // namespace bave::detail
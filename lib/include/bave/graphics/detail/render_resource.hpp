@@ -5,6 +5,7 @@
 #include <bave/core/scoped_resource.hpp>
 #include <bave/graphics/bitmap.hpp>
 #include <vulkan/vulkan.hpp>
+#include <optional>
 #include <span>
 
 namespace bave {
@@ -67,6 +68,8 @@ class RenderImage : public RenderResource {
 		vk::ImageViewType view_type{vk::ImageViewType::e2D};
 		bool mip_map{true};
 		bool lazily_allocated{false};
+		/// \brief Number of mip levels if mip_map is set (0: full chain), clamped to compute_mip_levels().
+		std::uint32_t mip_levels{};
 	};
 
 	using Layer = std::span<std::byte const>;
@@ -75,13 +78,23 @@ class RenderImage : public RenderResource {
 	static constexpr std::uint32_t cubemap_layers_v{6};
 
 	static auto compute_mip_levels(vk::Extent2D extent) -> std::uint32_t;
+	static auto compute_mip_levels(CreateInfo const& create_info, vk::Extent2D extent) -> std::uint32_t;
 
 	explicit RenderImage(NotNull<RenderDevice*> render_device, CreateInfo const& create_info, vk::Extent2D extent = min_extent_v);
 
 	auto copy_from(BitmapView bitmap) -> bool;
+	/// \brief Recreate with a given format and upload precomputed mip levels (eg block-compressed).
+	/// \param format Format of level bytes.
+	/// \param extent Extent of base level.
+	/// \param levels Bytes of each mip level, starting with the base.
+	/// \returns false if format is unknown (get_format_block()), there are more levels than extent allows, or a level is too small.
+	auto copy_levels(vk::Format format, vk::Extent2D extent, std::span<Layer const> levels) -> bool;
 
 	void recreate(vk::Extent2D extent);
 	auto overwrite(BitmapView bitmap, glm::ivec2 top_left) -> bool;
+	/// \brief Copy the base level into an RGBA bitmap (blocks until complete).
+	/// \returns RGBA bitmap, std::nullopt if format is not 8-bit RGBA / BGRA.
+	[[nodiscard]] auto read_back() const -> std::optional<Bitmap>;
 
 	[[nodiscard]] auto get_render_device() const -> RenderDevice& { return *m_render_device; }
 
@@ -99,6 +112,14 @@ class RenderImage : public RenderResource {
 	operator vk::ImageView() const { return *m_view; }
 
   protected:
+	// previous image and view, kept alive until submits that may still use them complete.
+	struct Retired {
+		ScopedResource<vk::Image, Deleter> image{};
+		vk::UniqueImageView view{};
+	};
+
+	void create(vk::Extent2D extent, std::uint32_t mip_levels);
+
 	NotNull<RenderDevice*> m_render_device;
 	CreateInfo m_create_info{};
 	ScopedResource<vk::Image, Deleter> m_image{};
@@ -107,6 +128,33 @@ class RenderImage : public RenderResource {
 	std::uint32_t m_mip_levels{};
 };
 
+/// \brief Texel block of a format: 1x1 for uncompressed formats.
+struct FormatBlock {
+	vk::Extent2D extent{1, 1};
+	/// \brief Bytes per block, 0 if the format is unknown.
+	std::uint32_t size{};
+};
+
+/// \brief Obtain the texel block of a sampled image format (8-bit RGBA / BGRA / R / RG, 16 / 32-bit float RGBA, BC, ETC2 / EAC, ASTC).
+[[nodiscard]] auto get_format_block(vk::Format format) -> FormatBlock;
+/// \brief Obtain the size of an image level in bytes.
+/// \returns 0 if the format is unknown.
+[[nodiscard]] auto compute_level_size(vk::Format format, vk::Extent2D extent) -> vk::DeviceSize;
+/// \brief Obtain the size of an image and its mip chain in bytes.
+/// \returns 0 if the format is unknown.
+[[nodiscard]] auto compute_image_size(vk::Format format, vk::Extent2D extent, std::uint32_t mip_levels) -> vk::DeviceSize;
+
+constexpr auto is_rgba(vk::Format const format) {
+	return format == vk::Format::eR8G8B8A8Srgb || format == vk::Format::eR8G8B8A8Unorm || format == vk::Format::eA8B8G8R8SrgbPack32 ||
+		   format == vk::Format::eA8B8G8R8UnormPack32;
+}
+
+constexpr auto is_bgra(vk::Format const format) { return format == vk::Format::eB8G8R8A8Srgb || format == vk::Format::eB8G8R8A8Unorm; }
+
+constexpr auto is_srgb(vk::Format const format) {
+	return format == vk::Format::eR8G8B8A8Srgb || format == vk::Format::eB8G8R8A8Srgb || format == vk::Format::eA8B8G8R8SrgbPack32;
+}
+
 template <typename Type>
 constexpr auto to_vk_extent(glm::tvec2<Type> const in) -> vk::Extent2D {
 	auto const uextent = glm::uvec2{in};
@@ -1,12 +1,17 @@
 #pragma once
 #include <bave/graphics/texture.hpp>
 #include <vulkan/vulkan.hpp>
+#include <shared_mutex>
 #include <unordered_map>
 
 namespace bave::detail {
+/// \brief Cache of samplers.
+///
+/// get() is thread safe: lookups take a shared lock, samplers are created outside the lock.
+/// Common samplers are created on construction. Textures cache the samplers they obtain.
 class SamplerCache {
   public:
-	explicit SamplerCache(vk::Device device) : m_device(device) {}
+	explicit SamplerCache(vk::Device device);
 
 	auto get(Texture::Sampler const& sampler) -> vk::Sampler;
 
@@ -19,5 +24,6 @@ class SamplerCache {
 
 	vk::Device m_device{};
 	std::unordered_map<Texture::Sampler, vk::UniqueSampler, Hasher> m_map{};
+	std::shared_mutex m_mutex{};
 };
 } // namespace bave::detail
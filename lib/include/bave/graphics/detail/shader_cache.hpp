@@ -4,9 +4,16 @@
 #include <bave/data_store.hpp>
 #include <bave/logger.hpp>
 #include <vulkan/vulkan.hpp>
+#include <atomic>
+#include <shared_mutex>
 #include <unordered_map>
+#include <unordered_set>
 
 namespace bave::detail {
+/// \brief Cache of shader modules, by URI.
+///
+/// load() is thread safe: lookups take a shared lock, modules are created outside the lock.
+/// Failed URIs are remembered (and not loaded again) until invalidated or cleared.
 class ShaderCache {
   public:
 	explicit ShaderCache(vk::Device device, NotNull<DataStore const*> data_store) : m_device(device), m_data_store(data_store) {}
@@ -16,14 +23,28 @@ class ShaderCache {
 
 	[[nodiscard]] auto load(std::string_view uri) -> vk::ShaderModule;
 
-	[[nodiscard]] auto shader_count() const -> std::size_t { return m_modules.size(); }
+	[[nodiscard]] auto shader_count() const -> std::size_t;
 
-	void clear() { m_modules.clear(); }
+	/// \brief Obtain the current generation, incremented whenever modules are invalidated or cleared.
+	///
+	/// Modules resolved at one generation remain valid until it changes.
+	[[nodiscard]] auto get_generation() const -> std::uint64_t { return m_generation.load(std::memory_order_acquire); }
+
+	/// \brief Remove shader modules (and failures) loaded from a modified URI (GLSL or SPIR-V).
+	/// \returns Removed modules, to be destroyed once no longer in use.
+	[[nodiscard]] auto invalidate(std::string_view uri) -> std::vector<vk::UniqueShaderModule>;
+
+	void clear();
 
   private:
+	void set_failed(std::string_view uri);
+
 	vk::Device m_device;
 	NotNull<DataStore const*> m_data_store;
 	std::unordered_map<std::string, vk::UniqueShaderModule, StringHash, std::equal_to<>> m_modules{};
+	std::unordered_set<std::string, StringHash, std::equal_to<>> m_failed{};
+	std::atomic<std::uint64_t> m_generation{};
+	mutable std::shared_mutex m_mutex{};
 	Logger m_log{"ShaderCache"};
 };
 } // namespace bave::detail
@@ -34,5 +34,7 @@ struct Swapchain {
 	vk::PresentModeKHR desired_present_mode{};
 	vk::SwapchainCreateInfoKHR create_info{};
 	Storage active{};
+	// incremented on every recreation: render targets (and their image views) of older generations are invalid.
+	std::uint64_t generation{};
 };
 } // namespace bave::detail
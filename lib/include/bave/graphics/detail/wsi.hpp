@@ -11,5 +11,8 @@ class IWsi : public Polymorphic {
 	[[nodiscard]] virtual auto get_framebuffer_extent() const -> vk::Extent2D = 0;
 
 	[[nodiscard]] virtual auto select_gpu(std::span<Gpu const> gpus) const -> Gpu { return gpus.front(); }
+
+	/// \brief Whether to render offscreen (no surface / swapchain).
+	[[nodiscard]] virtual auto is_headless() const -> bool { return false; }
 };
 } // namespace bave::detail
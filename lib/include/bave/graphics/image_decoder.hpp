@@ -0,0 +1,56 @@
+#pragma once
+#include <bave/graphics/bitmap.hpp>
+#include <memory>
+#include <string_view>
+
+namespace bave {
+/// \brief Interface for decoding compressed images into RGBA bitmaps.
+///
+/// Decoders must be stateless: the same instance is used concurrently by all ImageFiles.
+class IImageDecoder : public Polymorphic {
+  public:
+	[[nodiscard]] virtual auto get_name() const -> std::string_view = 0;
+
+	/// \brief Check if bytes look like a supported format (signature only).
+	/// \param bytes Compressed image bytes.
+	/// \returns true if decode() should be attempted.
+	[[nodiscard]] virtual auto can_decode(std::span<std::byte const> bytes) const -> bool = 0;
+
+	/// \brief Decode an image into 8-bit RGBA.
+	/// \param bytes Compressed image bytes.
+	/// \returns Source of decoded bitmap, nullptr on failure.
+	[[nodiscard]] virtual auto decode(std::span<std::byte const> bytes) const -> std::unique_ptr<IBitmapViewSource> = 0;
+};
+
+/// \brief PNG decoder for non-interlaced 8-bit images.
+///
+/// Inflates all IDAT chunks into a single pre-sized buffer and reconstructs rows with
+/// per-filter, per-channel-count kernels. Other PNGs (16-bit, interlaced, etc) fail to decode,
+/// as do rows with unknown filter types.
+class PngDecoder final : public IImageDecoder {
+  public:
+	[[nodiscard]] auto get_name() const -> std::string_view final { return "png"; }
+	[[nodiscard]] auto can_decode(std::span<std::byte const> bytes) const -> bool final;
+	[[nodiscard]] auto decode(std::span<std::byte const> bytes) const -> std::unique_ptr<IBitmapViewSource> final;
+};
+
+/// \brief QOI (Quite OK Image) decoder.
+///
+/// Streams that end before all pixels are decoded (including within an op) fail to decode.
+class QoiDecoder final : public IImageDecoder {
+  public:
+	static constexpr std::string_view extension_v{".qoi"};
+
+	[[nodiscard]] auto get_name() const -> std::string_view final { return "qoi"; }
+	[[nodiscard]] auto can_decode(std::span<std::byte const> bytes) const -> bool final;
+	[[nodiscard]] auto decode(std::span<std::byte const> bytes) const -> std::unique_ptr<IBitmapViewSource> final;
+};
+
+/// \brief Generic decoder backed by stb_image (PNG, JPEG, BMP, TGA, etc).
+class StbDecoder final : public IImageDecoder {
+  public:
+	[[nodiscard]] auto get_name() const -> std::string_view final { return "stb"; }
+	[[nodiscard]] auto can_decode(std::span<std::byte const> /*bytes*/) const -> bool final { return true; }
+	[[nodiscard]] auto decode(std::span<std::byte const> bytes) const -> std::unique_ptr<IBitmapViewSource> final;
+};
+} // namespace bave
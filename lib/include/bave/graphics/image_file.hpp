@@ -1,20 +1,45 @@
 #pragma once
-#include <bave/graphics/bitmap.hpp>
+#include <bave/data_view.hpp>
+#include <bave/core/ptr.hpp>
+#include <bave/graphics/image_decoder.hpp>
 #include <memory>
 
 namespace bave {
 /// \brief Image file decompresser.
+///
+/// Decoding is delegated to a chain of IImageDecoders: the first one that accepts the bytes and succeeds is used.
 class ImageFile : public IBitmapViewSource {
   public:
+	using Decoders = std::span<Ptr<IImageDecoder const> const>;
+
+	/// \brief Obtain the default decoder chain: QoiDecoder, PngDecoder, StbDecoder.
+	/// \returns Span of default decoders (static storage).
+	[[nodiscard]] static auto get_default_decoders() -> Decoders;
+
 	/// \brief Attempt to load a compressed image.
 	/// \param compressed Bytestream representing image data.
 	/// \returns true on success.
-	auto load_from_bytes(std::span<std::byte const> compressed) -> bool;
+	auto load_from_bytes(std::span<std::byte const> compressed) -> bool { return load_from_bytes(compressed, get_default_decoders()); }
+	/// \brief Attempt to load a compressed image using custom decoders.
+	/// \param compressed Bytestream representing image data.
+	/// \param decoders Decoders to try, in order.
+	/// \returns true on success.
+	auto load_from_bytes(std::span<std::byte const> compressed, Decoders decoders) -> bool;
+	/// \brief Attempt to load a compressed image from a view.
+	/// \param bytes View of image data.
+	/// \returns true on success.
+	///
+	/// RawImages are viewed directly (no decoding or copying), keeping bytes alive.
+	auto load_from_bytes(DataView bytes) -> bool;
 
 	/// \brief Obtain a view into the decompressed bitmap.
 	/// \returns a BitmapView into the decompressed bitmap.
 	[[nodiscard]] auto get_bitmap_view() const -> BitmapView final;
 
+	/// \brief Obtain the name of the decoder used.
+	/// \returns Name of decoder, "raw" for RawImages, empty if not loaded.
+	[[nodiscard]] auto get_decoder_name() const -> std::string_view;
+
 	[[nodiscard]] auto is_empty() const -> bool { return m_impl == nullptr; }
 
 	explicit operator bool() const { return !is_empty(); }
@@ -67,12 +67,18 @@ class ParticleEmitter : public Instanced<Sprite> {
 
 	[[nodiscard]] auto make_particle() const -> Particle;
 
+	void prepare_tick();
 	void refresh_particles(bool respawn);
-	void tick_particles(Seconds dt);
+	void tick_particles(Seconds dt) { tick_particles(dt, 0, m_particles.size()); }
+	void tick_particles(Seconds dt, std::size_t begin, std::size_t end);
 	void sync_instances();
+	// bakes particles [begin, begin + out.size()) for a unit quad (scaled by config.quad_size).
+	void bake_particles(std::span<RenderInstance::Baked> out, std::size_t begin) const;
 
 	std::vector<Particle> m_particles{};
 	glm::vec2 m_position{};
 	bool m_ticked{};
+
+	friend class ParticleSystem;
 };
 } // namespace bave
@@ -2,20 +2,30 @@
 #include <bave/graphics/particle_emitter.hpp>
 
 namespace bave {
+class JobSystem;
+
 /// \brief Container of ParticleEmitter instances.
+///
+/// Ticking bakes the particles of all emitters into one shared instance buffer,
+/// and emitters with the same textures and UV rect are drawn with a single instanced draw call.
+/// Emitters' own instances are not updated (draw the system, not individual emitters).
 class ParticleSystem : public IDrawable {
   public:
+	/// \brief Maximum particles per chunk, when ticking on a JobSystem.
+	static constexpr std::size_t chunk_size_v{2048};
+
 	/// \brief Draw all emitters using a given shader.
 	/// \param shader Shader to use.
-	void draw(Shader& shader) const final {
-		for (auto const& emitter : emitters) { emitter.draw(shader); }
-	}
+	void draw(Shader& shader) const final;
 
 	/// \brief Tick all emitters.
 	/// \param dt Delta time since last call.
-	void tick(Seconds const dt) {
-		for (auto& emitter : emitters) { emitter.tick(dt); }
-	}
+	void tick(Seconds const dt) { do_tick(dt, {}); }
+
+	/// \brief Tick all emitters in parallel, splitting large emitters into chunks.
+	/// \param dt Delta time since last call.
+	/// \param job_system JobSystem to tick emitters on.
+	void tick(Seconds const dt, JobSystem& job_system) { do_tick(dt, &job_system); }
 
 	/// \brief Pre-warm particles of all emitters by simulating ticks.
 	/// \param dt Delta time to use per tick.
@@ -31,7 +41,42 @@ class ParticleSystem : public IDrawable {
 		for (auto& emitter : emitters) { emitter.respawn(); }
 	}
 
+	/// \brief Get the instances baked by the last tick.
+	[[nodiscard]] auto get_baked_instances() const -> std::span<RenderInstance::Baked const> { return m_baked; }
+	/// \brief Get the number of batches (draw calls, unless empty) built by the last tick.
+	[[nodiscard]] auto get_batch_count() const -> std::size_t { return m_batches.size(); }
+
 	/// \brief Vector of emitters.
 	std::vector<ParticleEmitter> emitters{};
+
+  private:
+	struct Batch {
+		std::array<std::shared_ptr<Texture const>, Shader::max_textures_v> textures{};
+		UvRect uv{uv_rect_v};
+		// unit quad with uv.
+		QuadShape quad{};
+		std::size_t offset{};
+		std::size_t count{};
+	};
+
+	struct Chunk {
+		std::size_t emitter{};
+		std::size_t begin{};
+		std::size_t end{};
+		std::size_t offset{};
+	};
+
+	[[nodiscard]] static auto make_unit_quad(UvRect const& uv) -> QuadShape;
+
+	void do_tick(Seconds dt, Ptr<JobSystem> job_system);
+	void build_batches();
+	[[nodiscard]] auto make_batch(ParticleEmitter const& emitter) -> Batch;
+
+	std::vector<RenderInstance::Baked> m_baked{};
+	std::vector<Batch> m_batches{};
+	// batches of the previous tick: their quads are reused, geometry is only rebuilt when UVs change.
+	std::vector<Batch> m_previous_batches{};
+	std::vector<std::size_t> m_emitter_batches{};
+	std::vector<Chunk> m_chunks{};
 };
 } // namespace bave
@@ -3,11 +3,15 @@
 #include <bave/graphics/bitmap.hpp>
 #include <bave/graphics/rect.hpp>
 #include <bave/graphics/rgba.hpp>
+#include <cstdint>
+#include <span>
 #include <unordered_map>
 #include <vector>
 
 namespace bave {
 /// \brief Writeable array of Rgba.
+///
+/// Pixels are stored contiguously in row-major order, each Rgba being 4 packed bytes (RGBA8).
 class Pixmap {
   public:
 	struct Atlas;
@@ -18,14 +22,48 @@ class Pixmap {
 	/// \param background initializer for all Rgba values.
 	explicit Pixmap(glm::ivec2 extent = {1, 1}, Rgba background = black_v);
 
+	/// \brief Create a Pixmap from an 8-bit alpha mask.
+	/// \param alpha Alpha values, at least (extent.y - 1) * stride + extent.x.
+	/// \param extent Extent (size) of mask.
+	/// \param stride Number of alpha values between the start of each row.
+	/// \param rgb Colour to combine each alpha value with (its alpha is ignored).
+	/// \returns Pixmap, empty if alpha is too small.
+	[[nodiscard]] static auto from_alpha(std::span<std::uint8_t const> alpha, glm::ivec2 extent, int stride, Rgba rgb = white_v) -> Pixmap;
+
 	[[nodiscard]] auto get_extent() const -> glm::ivec2 { return m_extent; }
 
 	/// \brief Overwrite image data.
 	/// \param source Source Pixmap to read from.
 	/// \param left_top Destination offset to start overwriting at.
 	/// \returns true on success.
+	///
+	/// Copies whole rows at a time.
 	auto overwrite(Pixmap const& source, Index2D left_top) -> bool;
 
+	/// \brief Set all pixels.
+	/// \param rgba Value to set.
+	void fill(Rgba rgba);
+	/// \brief Set all pixels in a rect.
+	/// \param rgba Value to set.
+	/// \param rect Rect (lt inclusive, rb exclusive) to fill.
+	/// \returns true on success, false if rect is out of bounds.
+	auto fill(Rgba rgba, Rect<int> const& rect) -> bool;
+
+	/// \brief Obtain all pixels.
+	/// \returns Span of all Rgba values, in row-major order.
+	[[nodiscard]] auto get_pixels() const -> std::span<Rgba const> { return m_pixels; }
+	/// \brief Obtain all pixels.
+	/// \returns Span of all Rgba values, in row-major order.
+	[[nodiscard]] auto get_pixels() -> std::span<Rgba> { return m_pixels; }
+	/// \brief Obtain a row of pixels.
+	/// \param row Index of row.
+	/// \returns Span of Rgba values in row, empty if out of bounds.
+	[[nodiscard]] auto get_row(int row) const -> std::span<Rgba const>;
+	/// \brief Obtain a row of pixels.
+	/// \param row Index of row.
+	/// \returns Span of Rgba values in row, empty if out of bounds.
+	[[nodiscard]] auto get_row(int row) -> std::span<Rgba>;
+
 	/// \brief Obtain Rgba at given Index2D.
 	/// \returns Const reference to Rgba.
 	[[nodiscard]] auto at(Index2D index) const -> Rgba const&;
@@ -33,9 +71,17 @@ class Pixmap {
 	/// \returns Mutable reference to Rgba.
 	[[nodiscard]] auto at(Index2D index) -> Rgba&;
 
+	/// \brief Obtain a view of the stored Rgba bitmap (no copy).
+	/// \returns BitmapView into the stored pixels.
+	[[nodiscard]] auto get_bitmap_view() const -> BitmapView;
 	/// \brief Create a byte bitmap from stored Rgba bitmap.
 	/// \returns Rgba Bitmap.
+	///
+	/// Prefer get_bitmap_view() unless the Bitmap needs to outlive this Pixmap.
 	[[nodiscard]] auto make_bitmap() const -> Bitmap;
+	/// \brief Copy out the alpha channel.
+	/// \returns Alpha of each pixel, in row-major order.
+	[[nodiscard]] auto make_alpha() const -> std::vector<std::uint8_t>;
 
 	[[nodiscard]] auto is_empty() const -> bool { return m_pixels.empty(); }
 
@@ -48,23 +94,66 @@ class Pixmap {
 struct Pixmap::Atlas {
 	using Id = std::uint32_t;
 
+	struct Stats {
+		/// \brief Number of sub-images.
+		std::size_t count{};
+		/// \brief Pixels covered by sub-images.
+		std::int64_t used_pixels{};
+		/// \brief Pixels in atlas.
+		std::int64_t total_pixels{};
+
+		/// \brief Obtain the fraction of atlas pixels covered by sub-images.
+		/// \returns Occupancy in [0, 1].
+		[[nodiscard]] auto get_occupancy() const -> float {
+			return total_pixels > 0 ? static_cast<float>(static_cast<double>(used_pixels) / static_cast<double>(total_pixels)) : 0.0f;
+		}
+	};
+
 	/// \brief Combined Pixmap.
 	Pixmap pixmap{};
 	/// \brief UV coordinates of each sub-image.
 	std::unordered_map<Id, UvRect> uvs{};
+	/// \brief Occupancy stats.
+	Stats stats{};
 };
 
 /// \brief Builder for Pixmap::Atlas.
+///
+/// Sub-images are laid out on build(), the atlas extent is rounded up to powers of two.
 class Pixmap::Builder {
   public:
 	using Id = Atlas::Id;
 
 	static constexpr int min_width_v{16};
 
+	/// \brief Packing algorithm.
+	enum class Packing : int {
+		/// \brief Rows of sub-images, each as tall as its tallest sub-image (rows are separated by 2 * pad.y).
+		eShelf,
+		/// \brief Bottom-left placement along a skyline of placed sub-images.
+		eSkyline,
+		/// \brief Bottom-left placement into maximal free rectangles (slowest, densest).
+		eMaxRects,
+	};
+
+	struct Layout {
+		/// \brief Packing algorithm.
+		Packing packing{Packing::eShelf};
+		/// \brief Whether to pack sub-images by decreasing height (else in order of addition).
+		bool sort_by_height{};
+	};
+
 	/// \brief Constructor.
 	/// \param max_width Maximum width of final pixmap.
 	/// \param pad Padding between each sub-image.
-	explicit Builder(int max_width, glm::ivec2 pad = {1, 1});
+	/// \param layout Packing options.
+	///
+	/// Skyline and MaxRects search power-of-two widths up to max_width for the smallest atlas.
+	explicit Builder(int max_width, glm::ivec2 pad, Layout const& layout);
+	/// \brief Constructor with default (shelf) Layout.
+	/// \param max_width Maximum width of final pixmap.
+	/// \param pad Padding between each sub-image.
+	explicit Builder(int max_width, glm::ivec2 pad = {1, 1}) : Builder(max_width, pad, Layout{}) {}
 
 	/// \brief Add a sub-image.
 	/// \param id Id to associate with.
@@ -77,23 +166,14 @@ class Pixmap::Builder {
 	[[nodiscard]] auto build(Rgba background = black_v) const -> Atlas;
 
   private:
-	void line_break();
-
 	struct Entry {
 		Pixmap pixmap{};
-		Rect<int> rect{};
 		Id id{};
 	};
 
 	std::vector<Entry> m_entries{};
 	int m_max_width;
 	glm::ivec2 m_pad;
-
-	struct {
-		glm::ivec2 cursor{};
-		int current_height{};
-		int line_height{};
-		glm::ivec2 size{};
-	} m_data{};
+	Layout m_layout;
 };
 } // namespace bave
@@ -0,0 +1,24 @@
+#pragma once
+#include <bave/graphics/bitmap.hpp>
+#include <cstdint>
+#include <vector>
+
+namespace bave {
+/// \brief Uncompressed RGBA image format: a fixed size header followed by pixels.
+///
+/// Used to store pre-decoded images (eg in bundles), which can then be uploaded without decoding or copying.
+struct RawImage {
+	static constexpr std::uint32_t version_v{1};
+	/// \brief Size of header (magic, version, width, height), keeps pixels 16-byte aligned.
+	static constexpr std::size_t header_size_v{16};
+
+	/// \brief Encode a bitmap.
+	/// \param bitmap Bitmap to encode.
+	/// \returns Encoded bytes, empty if bitmap is invalid.
+	[[nodiscard]] static auto encode(BitmapView bitmap) -> std::vector<std::byte>;
+	/// \brief View the pixels of an encoded RawImage.
+	/// \param bytes Encoded bytes.
+	/// \returns BitmapView into bytes, empty if bytes are not a valid RawImage.
+	[[nodiscard]] static auto view(std::span<std::byte const> bytes) -> BitmapView;
+};
+} // namespace bave
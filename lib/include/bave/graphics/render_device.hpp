@@ -6,6 +6,7 @@
 #include <bave/font/detail/font_library.hpp>
 #include <bave/graphics/detail/buffer_cache.hpp>
 #include <bave/graphics/detail/buffering.hpp>
+#include <bave/graphics/detail/command_buffer.hpp>
 #include <bave/graphics/detail/defer.hpp>
 #include <bave/graphics/detail/device_blocker.hpp>
 #include <bave/graphics/detail/image_cache.hpp>
@@ -26,10 +27,19 @@ namespace bave {
 struct RenderDeviceCreateInfo {
 	detail::ColourSpace swapchain_colour_space{detail::ColourSpace::eSrgb};
 	vk::SampleCountFlagBits desired_samples{vk::SampleCountFlagBits::e1};
+	/// \brief Frames that can be in flight on the GPU (clamped to [1, 3]): fewer trades throughput for latency.
+	std::uint32_t frames_in_flight{static_cast<std::uint32_t>(detail::buffering_v)};
 	bool validation_layers{debug_v};
 };
 
-/// \brief Vulkan rendering device.
+/// \brief Vulkan device, swapchain, and caches of shared resources.
+///
+/// Thread safety:
+/// - Creating resources is safe from any thread: Textures, Fonts, shader modules and pipelines.
+///   The caches involved are internally synchronized, uploads are recorded into per-thread command pools,
+///   and queue submission is serialized.
+/// - A resource must not be modified on one thread while another uses it (eg overwriting a Texture that is being drawn).
+/// - Frame and swapchain management (and render_view) are main thread only.
 class RenderDevice {
   public:
 	static constexpr auto max_timeout_v{std::numeric_limits<std::uint64_t>::max()};
@@ -39,11 +49,17 @@ class RenderDevice {
 	using CreateInfo = RenderDeviceCreateInfo;
 
 	struct RecreateSync {};
+	struct MemoryUsage {
+		std::uint64_t used{};
+		std::uint64_t budget{};
+	};
 	using AcquireResult = std::variant<std::monostate, detail::RenderTarget, RecreateSync>;
 
 	explicit RenderDevice(NotNull<detail::IWsi*> wsi, CreateInfo create_info = {});
 
 	[[nodiscard]] auto validation_layers_enabled() const -> bool { return !!m_debug_messenger; }
+	/// \brief Check if rendering to an offscreen image instead of a swapchain.
+	[[nodiscard]] auto is_headless() const -> bool { return !m_surface; }
 
 	[[nodiscard]] auto get_instance() const -> vk::Instance { return *m_instance; }
 	[[nodiscard]] auto get_surface() const -> vk::SurfaceKHR { return *m_surface; }
@@ -54,10 +70,26 @@ class RenderDevice {
 	[[nodiscard]] auto get_swapchain_format() const -> vk::Format { return m_swapchain.create_info.imageFormat; }
 	[[nodiscard]] auto get_swapchain_extent() const -> vk::Extent2D { return m_swapchain.create_info.imageExtent; }
 	[[nodiscard]] auto get_framebuffer_size() const -> glm::vec2 { return detail::to_glm_vec<float>(get_swapchain_extent()); }
+	/// \brief Obtain the number of times the swapchain (or offscreen image) has been recreated.
+	[[nodiscard]] auto get_swapchain_generation() const -> std::uint64_t { return m_swapchain.generation; }
+
+	/// \brief Check if images of a format can be sampled with optimal tiling.
+	/// \param format Format to check.
+	/// \returns true if supported.
+	[[nodiscard]] auto is_sampled_format_supported(vk::Format format) const -> bool;
+	/// \brief Check if optimally tiled images of a format can be blitted and sampled with linear filtering.
+	/// \param format Format to check.
+	/// \returns true if supported.
+	[[nodiscard]] auto is_linear_filter_supported(vk::Format format) const -> bool;
+
+	/// \brief Obtain device memory usage and budget, summed over all heaps.
+	/// \returns Memory usage reported by VMA.
+	[[nodiscard]] auto get_memory_usage() const -> MemoryUsage;
 
 	[[nodiscard]] auto get_line_width_limits() const -> InclusiveRange<float> { return m_line_width_limits; }
 	[[nodiscard]] auto get_sample_count() const -> vk::SampleCountFlagBits { return m_samples; }
 	[[nodiscard]] auto get_frame_index() const -> detail::FrameIndex { return m_frame_index; }
+	[[nodiscard]] auto get_frames_in_flight() const -> std::uint32_t { return static_cast<std::uint32_t>(m_frame_index.count); }
 	[[nodiscard]] auto get_default_view() const -> RenderView { return RenderView{.viewport = get_framebuffer_size()}; }
 
 	[[nodiscard]] auto get_viewport_scaler() const -> ExtentScaler { return ExtentScaler{.source = get_framebuffer_size()}; }
@@ -75,10 +107,17 @@ class RenderDevice {
 
 	auto recreate_surface() -> bool;
 
+	/// \brief Read back the offscreen image (headless only).
+	/// \returns RGBA bitmap of the last rendered frame, std::nullopt if not headless.
+	///
+	/// Waits for the device to be idle.
+	[[nodiscard]] auto read_offscreen() const -> std::optional<Bitmap>;
+
 	[[nodiscard]] auto get_defer_queue() -> detail::DeferQueue& { return m_defer_queue; }
 	[[nodiscard]] auto get_buffer_cache() const -> detail::BufferCache& { return *m_buffer_cache; }
 	[[nodiscard]] auto get_image_cache() const -> detail::ImageCache& { return *m_image_cache; }
 	[[nodiscard]] auto get_sampler_cache() const -> detail::SamplerCache& { return *m_sampler_cache; }
+	[[nodiscard]] auto get_command_pools() const -> detail::CommandPools& { return *m_command_pools; }
 	[[nodiscard]] auto get_font_library() const -> detail::FontLibrary& { return *m_font_library; }
 
 	RenderView render_view{};
@@ -89,6 +128,8 @@ class RenderDevice {
 	};
 
 	auto recreate_swapchain(vk::Extent2D framebuffer) -> bool;
+	auto recreate_offscreen(vk::Extent2D framebuffer) -> bool;
+	[[nodiscard]] auto acquire_offscreen(vk::Fence wait) -> AcquireResult;
 
 	Logger m_log{"RenderDevice"};
 
@@ -105,9 +146,11 @@ class RenderDevice {
 	Gpu m_gpu{};
 	vk::Queue m_queue{};
 	detail::Swapchain m_swapchain{};
+	std::unique_ptr<detail::CommandPools> m_command_pools{};
 	std::unique_ptr<detail::BufferCache> m_buffer_cache{};
 	std::unique_ptr<detail::ImageCache> m_image_cache{};
 	std::unique_ptr<detail::SamplerCache> m_sampler_cache{};
+	std::optional<detail::RenderImage> m_offscreen{};
 	std::unique_ptr<detail::FontLibrary> m_font_library{detail::FontLibrary::make()};
 
 	detail::DeviceBlocker m_blocker{};
@@ -6,6 +6,8 @@
 #include <vector>
 
 namespace bave {
+class JobSystem;
+
 /// \brief A single render instance.
 struct RenderInstance {
 	struct Baked;
@@ -19,6 +21,12 @@ struct RenderInstance {
 	[[nodiscard]] auto to_baked(glm::mat4 const& parent = glm::identity<glm::mat4>()) const -> Baked;
 
 	static void fill_baked(std::vector<Baked>& out, std::span<RenderInstance const> instances, glm::mat4 const& parent);
+	/// \brief Bake instances in parallel.
+	/// \param out Vector to append baked instances to.
+	/// \param instances Instances to bake.
+	/// \param parent Transform to parent instances on.
+	/// \param job_system JobSystem to bake on.
+	static void fill_baked(std::vector<Baked>& out, std::span<RenderInstance const> instances, glm::mat4 const& parent, JobSystem& job_system);
 };
 
 /// \brief Baked render instance (ready to upload to GPU).
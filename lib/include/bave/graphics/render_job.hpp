@@ -0,0 +1,42 @@
+#pragma once
+#include <bave/core/ptr.hpp>
+#include <bave/graphics/render_view.hpp>
+#include <bave/graphics/shader.hpp>
+#include <functional>
+
+namespace bave {
+namespace detail {
+class RecordArena;
+}
+
+/// \brief Context of a job recorded by Renderer::record_jobs().
+///
+/// Each job records into its own secondary command buffer, using the scratch buffers and descriptor sets of its thread.
+class RenderJob {
+  public:
+	/// \brief Obtain the index of this job (in the span passed to Renderer::record_jobs()).
+	[[nodiscard]] auto get_index() const -> std::size_t { return m_index; }
+
+	/// \brief Obtain a copy of a Shader that records into this job.
+	/// \param shader Shader to copy (typically loaded on the main thread before recording jobs).
+	/// \returns Shader bound to this job.
+	[[nodiscard]] auto bind(Shader shader) -> Shader;
+
+	/// \brief View used by Shaders bound to this job (initialized to RenderDevice::render_view).
+	RenderView render_view{};
+
+  private:
+	explicit RenderJob(vk::CommandBuffer command_buffer, NotNull<detail::RecordArena*> arena, std::size_t index, RenderView const& render_view)
+		: render_view(render_view), m_command_buffer(command_buffer), m_arena(arena), m_index(index) {}
+
+	vk::CommandBuffer m_command_buffer{};
+	NotNull<detail::RecordArena*> m_arena;
+	std::size_t m_index{};
+
+	friend class Renderer;
+	friend class Shader;
+};
+
+/// \brief Callback that records draws for a RenderJob.
+using RecordFunc = std::function<void(RenderJob&)>;
+} // namespace bave
@@ -0,0 +1,81 @@
+#pragma once
+#include <cstdint>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace bave {
+/// \brief Counters of a rendered frame.
+///
+/// Counters are reset by Renderer::start_render() and incremented along the Shader::draw() path.
+/// Gauges (buffers, images, memory) are sampled by Renderer::finish_render().
+struct RenderStats {
+	static constexpr std::string_view csv_header_v{
+		"frame,draw_calls,instances,vertices,pipeline_binds,descriptor_sets,descriptor_writes,bytes_uploaded,buffers,images,memory_used,memory_budget"};
+
+	std::uint64_t frame{};
+
+	std::uint64_t draw_calls{};
+	std::uint64_t instances{};
+	std::uint64_t vertices{};
+	std::uint64_t pipeline_binds{};
+	/// \brief Descriptor sets allocated.
+	std::uint64_t descriptor_sets{};
+	/// \brief Descriptors written (vk::WriteDescriptorSet).
+	std::uint64_t descriptor_writes{};
+	/// \brief Bytes written to scratch (host visible) buffers.
+	std::uint64_t bytes_uploaded{};
+
+	/// \brief Scratch buffers alive.
+	std::uint64_t buffers{};
+	/// \brief Images alive (in ImageCache).
+	std::uint64_t images{};
+	/// \brief Device memory used by all heaps (VMA).
+	std::uint64_t memory_used{};
+	/// \brief Device memory budget of all heaps (VMA).
+	std::uint64_t memory_budget{};
+
+	/// \brief Add the counters (not gauges) of another instance.
+	/// \param rhs Stats whose counters to add.
+	void add_counters(RenderStats const& rhs);
+
+	/// \brief Obtain a CSV row matching csv_header_v (without a trailing newline).
+	[[nodiscard]] auto to_csv_row() const -> std::string;
+};
+
+/// \brief Ring buffer of the stats of the last N frames.
+class RenderStatsHistory {
+  public:
+	/// \brief Constructor.
+	/// \param capacity Number of frames to retain (0 retains none).
+	explicit RenderStatsHistory(std::size_t capacity = 0) : m_capacity(capacity) {}
+
+	/// \brief Set the number of frames to retain, dropping the oldest ones if necessary.
+	/// \param capacity Number of frames (0 retains none).
+	void set_capacity(std::size_t capacity);
+	[[nodiscard]] auto get_capacity() const -> std::size_t { return m_capacity; }
+
+	/// \brief Retain stats of a frame, overwriting the oldest retained frame if full.
+	/// \param stats Stats to retain.
+	void push(RenderStats const& stats);
+	/// \brief Obtain a copy of retained frames.
+	/// \returns Retained frames, oldest first (eg to pass to to_csv()).
+	[[nodiscard]] auto get_frames() const -> std::vector<RenderStats>;
+
+	[[nodiscard]] auto size() const -> std::size_t { return m_frames.size(); }
+	/// \brief Drop all retained frames.
+	void clear();
+
+  private:
+	std::vector<RenderStats> m_frames{};
+	// index of the oldest frame in m_frames.
+	std::size_t m_head{};
+	std::size_t m_capacity{};
+};
+
+/// \brief Serialize stats as CSV (header + one row per frame).
+/// \param frames Stats to serialize.
+/// \returns CSV string.
+[[nodiscard]] auto to_csv(std::span<RenderStats const> frames) -> std::string;
+} // namespace bave
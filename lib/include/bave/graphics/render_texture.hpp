@@ -0,0 +1,52 @@
+#pragma once
+#include <bave/graphics/render_view.hpp>
+#include <bave/graphics/rgba.hpp>
+#include <bave/graphics/texture.hpp>
+
+namespace bave {
+class Renderer;
+
+/// \brief Texture that can be rendered into.
+///
+/// Draw into it between begin_render() and end_render() with the usual Shader / Drawable API,
+/// then sample it like any other Texture (including in the same frame).
+/// Rendering is only possible while the Renderer is rendering (ie, in Driver::render()).
+/// Render textures are single sampled, and retain their contents until next rendered into.
+class RenderTexture : public Texture {
+  public:
+	/// \brief Constructor.
+	/// \param renderer Non-null pointer to Renderer.
+	/// \param size Size of texture.
+	explicit RenderTexture(NotNull<Renderer const*> renderer, glm::ivec2 size);
+
+	RenderTexture(RenderTexture&&) = default;
+	auto operator=(RenderTexture&&) -> RenderTexture& = default;
+	RenderTexture(RenderTexture const&) = delete;
+	auto operator=(RenderTexture const&) -> RenderTexture& = delete;
+
+	~RenderTexture() override;
+
+	/// \brief Resize the texture (discards its contents).
+	/// \param size New size.
+	void resize(glm::ivec2 size);
+
+	/// \brief Begin rendering into this texture: subsequent draws target it until end_render().
+	/// \param clear_colour Colour to clear the texture to.
+	/// \returns false if the Renderer is not rendering or another offscreen target is active.
+	auto begin_render(Rgba clear_colour = blank_v) -> bool;
+	/// \brief End rendering into this texture.
+	void end_render();
+
+	[[nodiscard]] auto is_rendering() const -> bool { return m_rendering; }
+
+	/// \brief View to render with (defaults to the size of the texture).
+	RenderView render_view{};
+
+  private:
+	void create_framebuffer();
+
+	NotNull<Renderer const*> m_renderer;
+	std::shared_ptr<vk::UniqueFramebuffer> m_framebuffer{};
+	bool m_rendering{};
+};
+} // namespace bave
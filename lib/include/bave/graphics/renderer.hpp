@@ -2,17 +2,26 @@
 #include <bave/core/not_null.hpp>
 #include <bave/core/pinned.hpp>
 #include <bave/graphics/detail/device_blocker.hpp>
+#include <bave/graphics/detail/gpu_profiler.hpp>
 #include <bave/graphics/detail/pipeline_cache.hpp>
+#include <bave/graphics/detail/record_arena.hpp>
 #include <bave/graphics/detail/render_resource.hpp>
 #include <bave/graphics/render_device.hpp>
+#include <bave/graphics/render_job.hpp>
+#include <bave/graphics/render_stats.hpp>
 #include <bave/graphics/rgba.hpp>
 #include <bave/graphics/texture.hpp>
 #include <bave/graphics/transform.hpp>
 #include <optional>
 
 namespace bave {
+class JobSystem;
+
 class Renderer : public Pinned {
   public:
+	/// \brief Colour format of offscreen targets (RenderTexture).
+	static constexpr vk::Format offscreen_format_v{vk::Format::eR8G8B8A8Srgb};
+
 	explicit Renderer(NotNull<RenderDevice*> render_device, NotNull<DataStore const*> data_store);
 
 	[[nodiscard]] auto get_render_device() const -> RenderDevice& { return *m_render_device; }
@@ -30,8 +39,51 @@ class Renderer : public Pinned {
 	[[nodiscard]] auto get_frame_index() const -> detail::FrameIndex { return m_render_device->get_frame_index(); }
 	[[nodiscard]] auto get_pipeline_cache() const -> detail::PipelineCache& { return *m_pipeline_cache; }
 
+	/// \brief Obtain the command buffer to record draws into.
+	/// \returns Offscreen command buffer if an offscreen pass is active, else the frame's current (secondary) command buffer.
 	[[nodiscard]] auto get_command_buffer() const -> vk::CommandBuffer;
 
+	/// \brief Set the JobSystem to record jobs on.
+	/// \param job_system JobSystem to use, null to record jobs on the calling thread.
+	void set_job_system(Ptr<JobSystem> job_system) { m_job_system = job_system; }
+	[[nodiscard]] auto get_job_system() const -> Ptr<JobSystem> { return m_job_system; }
+
+	/// \brief Record jobs in parallel, each into its own secondary command buffer.
+	/// \param jobs Jobs to record: each is invoked once, on the calling thread or a JobSystem worker thread.
+	/// \param max_threads Maximum threads to record on (including the calling thread), 0 for all JobSystem threads.
+	/// \returns false if not rendering or an offscreen pass is active.
+	///
+	/// Jobs execute in order, after draws recorded before this call and before draws recorded after it.
+	/// Shaders should be loaded before recording, and bound to each job via RenderJob::bind().
+	auto record_jobs(std::span<RecordFunc const> jobs, std::size_t max_threads = 0) const -> bool;
+
+	/// \brief Obtain the render pass of offscreen targets (single sampled, offscreen_format_v).
+	[[nodiscard]] auto get_offscreen_render_pass() const -> vk::RenderPass { return *m_offscreen->render_pass; }
+	/// \brief Begin an offscreen render pass: subsequent draws are recorded into it.
+	/// \param framebuffer Framebuffer compatible with get_offscreen_render_pass().
+	/// \param extent Extent of framebuffer.
+	/// \param clear_colour Colour to clear the target to.
+	/// \param render_view RenderView to use during the pass.
+	/// \returns false if not rendering or an offscreen pass is already active.
+	///
+	/// Offscreen passes are recorded into a separate command buffer that is submitted before the frame's,
+	/// so targets can be sampled in the same frame.
+	auto begin_offscreen(vk::Framebuffer framebuffer, vk::Extent2D extent, Rgba clear_colour, RenderView const& render_view) const -> bool;
+	/// \brief End the active offscreen render pass and restore the previous RenderView.
+	void end_offscreen() const;
+	[[nodiscard]] auto is_offscreen() const -> bool { return m_offscreen->active; }
+
+	/// \brief Obtain the extent of the current target (offscreen or backbuffer).
+	[[nodiscard]] auto get_target_extent() const -> vk::Extent2D;
+	/// \brief Obtain the render pass and sample count of the current target.
+	[[nodiscard]] auto get_target_pass() const -> detail::PipelineCache::Pass;
+	[[nodiscard]] auto get_gpu_profiler() const -> detail::GpuProfiler& { return *m_gpu_profiler; }
+
+	/// \brief Obtain stats of the last rendered frame.
+	[[nodiscard]] auto get_stats() const -> RenderStats const& { return m_stats; }
+	/// \brief Obtain stats of the frame being rendered (to increment).
+	[[nodiscard]] auto get_frame_stats() const -> RenderStats& { return *m_frame_stats; }
+
   private:
 	struct Frame {
 		struct Sync {
@@ -40,24 +92,67 @@ class Renderer : public Pinned {
 			vk::UniqueFence drawn{};
 			vk::UniqueCommandPool command_pool{};
 			vk::CommandBuffer command_buffer{};
+			vk::CommandBuffer offscreen_command_buffer{};
+		};
+
+		// framebuffers per swapchain image, valid for one swapchain generation and MSAA image.
+		struct Framebuffers {
+			struct Entry {
+				vk::ImageView swapchain{};
+				vk::UniqueFramebuffer framebuffer{};
+			};
+
+			std::vector<Entry> entries{};
+			std::uint64_t generation{};
+			vk::ImageView msaa{};
 		};
 
 		detail::Buffered<Sync> syncs{};
 		std::optional<detail::RenderImage> msaa_image{};
 		vk::UniqueRenderPass render_pass{};
 
-		detail::Buffered<vk::UniqueFramebuffer> framebuffers{};
+		Framebuffers framebuffers{};
 		std::optional<detail::RenderTarget> render_target{};
 
 		static auto make(RenderDevice& render_device) -> Frame;
 		void make_syncs(vk::Device device, std::uint32_t queue_family);
 	};
 
+	auto get_framebuffer(detail::RenderTarget const& render_target) -> vk::Framebuffer;
+
+	// the backbuffer pass is recorded into secondary command buffers (segments), so that jobs can execute in order between them.
+	struct Recording {
+		// [0]: main thread segments, [1..]: job threads.
+		std::vector<std::unique_ptr<detail::RecordArena>> arenas{};
+		std::vector<vk::CommandBuffer> segments{};
+		vk::CommandBuffer segment{};
+		vk::Framebuffer framebuffer{};
+	};
+
+	void begin_segment() const;
+	void end_segment() const;
+
+	struct Offscreen {
+		vk::UniqueRenderPass render_pass{};
+		vk::Extent2D extent{};
+		RenderView backbuffer_view{};
+		// whether the frame's offscreen command buffer has been begun.
+		bool recording{};
+		bool active{};
+	};
+
 	Logger m_log{"FrameRenderer"};
 
 	NotNull<RenderDevice*> m_render_device;
+	Ptr<JobSystem> m_job_system{};
 	Frame m_frame{};
 	std::unique_ptr<detail::PipelineCache> m_pipeline_cache{};
+	std::unique_ptr<detail::GpuProfiler> m_gpu_profiler{};
+	std::optional<detail::GpuProfiler::Scope> m_render_pass_scope{};
+	std::unique_ptr<Offscreen> m_offscreen{std::make_unique<Offscreen>()};
+	std::unique_ptr<Recording> m_recording{std::make_unique<Recording>()};
+	std::unique_ptr<RenderStats> m_frame_stats{std::make_unique<RenderStats>()};
+	RenderStats m_stats{};
 	Texture m_white;
 
 	detail::DeviceBlocker m_blocker{};
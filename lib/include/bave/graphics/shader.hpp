@@ -6,8 +6,17 @@
 #include <bave/graphics/render_instance.hpp>
 #include <bave/graphics/render_view.hpp>
 #include <bave/graphics/sampler_image.hpp>
+#include <string>
 
 namespace bave {
+namespace detail {
+class BufferCache;
+class DescriptorCache;
+} // namespace detail
+
+struct RenderStats;
+class RenderJob;
+
 class Shader {
   public:
 	static constexpr auto max_textures_v = detail::SetLayout::max_textures_v;
@@ -17,7 +26,14 @@ class Shader {
 	/// \brief The default value for polygon_mode.
 	inline static auto default_polygon_mode{vk::PolygonMode::eFill}; // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
 
-	explicit Shader(NotNull<class Renderer const*> renderer, vk::ShaderModule vertex, vk::ShaderModule fragment);
+	/// \brief Constructor.
+	/// \param renderer Non-null pointer to the Renderer to draw with.
+	/// \param vertex URI of vertex shader.
+	/// \param fragment URI of fragment shader.
+	///
+	/// Shader modules are looked up (by URI) in the ShaderCache on construction, and again on the next draw
+	/// after the ShaderCache invalidates modules, so a Shader remains valid across hot reloads.
+	explicit Shader(NotNull<class Renderer const*> renderer, std::string_view vertex, std::string_view fragment);
 
 	auto update_texture(SamplerImage const& image, std::uint32_t binding = 0) -> bool;
 	void update_textures(std::span<SamplerImage const, max_textures_v> images);
@@ -47,6 +63,13 @@ class Shader {
 	vk::PolygonMode polygon_mode{default_polygon_mode};
 
   private:
+	struct Program {
+		vk::ShaderModule vertex{};
+		vk::ShaderModule fragment{};
+		// ShaderCache generation the modules were resolved at.
+		std::uint64_t generation{};
+	};
+
 	struct Sets {
 		std::array<SamplerImage, max_textures_v> images{};
 		Ptr<detail::RenderBuffer> ubo{};
@@ -54,16 +77,26 @@ class Shader {
 	};
 
 	[[nodiscard]] auto allocate_scratch(detail::BufferType type) const -> detail::RenderBuffer&;
+	[[nodiscard]] auto get_command_buffer() const -> vk::CommandBuffer;
+	[[nodiscard]] auto get_buffer_cache() const -> detail::BufferCache&;
+	[[nodiscard]] auto get_descriptor_cache() const -> detail::DescriptorCache&;
+	[[nodiscard]] auto get_stats() const -> RenderStats&;
 
+	void resolve_program();
 	void set_viewport();
 	[[nodiscard]] auto get_scissor(Rect<> n_rect) const -> vk::Rect2D;
 	void update_and_bind_sets(vk::CommandBuffer command_buffer, std::span<RenderInstance::Baked const> instances) const;
 
 	NotNull<Renderer const*> m_renderer;
-	vk::ShaderModule m_vert{};
-	vk::ShaderModule m_frag{};
+	// set if bound to a RenderJob: draws are recorded into its command buffer and arena.
+	Ptr<RenderJob> m_job{};
+	std::string m_vert{};
+	std::string m_frag{};
+	Program m_program{};
 
 	vk::Viewport m_viewport{};
 	Sets m_sets{};
+
+	friend class RenderJob;
 };
 } // namespace bave
@@ -1,9 +1,15 @@
 #pragma once
+#include <bave/graphics/compressed_image.hpp>
 #include <bave/graphics/detail/render_resource.hpp>
 #include <bave/graphics/sampler_image.hpp>
 #include <memory>
+#include <mutex>
 
 namespace bave {
+namespace detail {
+class ImageUploader;
+}
+
 /// \brief Texture: image on the GPU.
 class Texture {
   public:
@@ -18,6 +24,10 @@ class Texture {
 		Filter min{Filter::eLinear};
 		Filter mag{Filter::eLinear};
 		Border border{Border::eOpaqueBlack};
+		/// \brief Filter between mip levels (eLinear: trilinear filtering). Set to eLinear by constructors of mip-mapped Textures.
+		Filter mip{Filter::eNearest};
+		/// \brief Bias added to the selected mip level: positive values reduce shimmering of minified textures, negative values sharpen.
+		float lod_bias{};
 
 		auto operator==(Sampler const&) const -> bool = default;
 	};
@@ -33,19 +43,65 @@ class Texture {
 	/// \param bitmap View of bitmap.
 	/// \param mip_map Whether to enable mip-mapping.
 	explicit Texture(NotNull<RenderDevice*> render_device, BitmapView bitmap, bool mip_map = false);
+	/// \brief Constructor.
+	/// \param render_device Non-null pointer to RenderDevice.
+	/// \param bitmap View of bitmap.
+	/// \param mip_map Whether to enable mip-mapping.
+	/// \param uploader Batch to stage the upload (and mip generation) into, must be submitted before the Texture is drawn.
+	explicit Texture(NotNull<RenderDevice*> render_device, BitmapView bitmap, bool mip_map, detail::ImageUploader& uploader);
+	/// \brief Constructor.
+	/// \param render_device Non-null pointer to RenderDevice.
+	/// \param image GPU-ready image, with precomputed mip levels.
+	/// \pre The format of image must be supported (RenderDevice::is_sampled_format_supported()).
+	explicit Texture(NotNull<RenderDevice*> render_device, CompressedImage const& image);
 
 	virtual ~Texture();
 
 	[[nodiscard]] auto get_size() const -> glm::ivec2;
 
+	/// \brief Obtain the image view and sampler to bind.
+	///
+	/// The image is read once, and the Vulkan sampler is cached, and only looked up again when sampler has changed.
+	/// Safe to call from multiple threads; changing sampler while the Texture is being drawn on other threads is not supported.
 	[[nodiscard]] auto get_sampler_image() const -> SamplerImage;
-	[[nodiscard]] auto get_image() const -> std::shared_ptr<detail::RenderImage> const& { return m_image; }
+	/// \brief Look up the Vulkan sampler for the current sampler now.
+	///
+	/// Call after changing sampler, so that subsequent draws (possibly on other threads) use the cached sampler.
+	void update_sampler() { resolve_sampler(); }
+	[[nodiscard]] auto get_image() const -> std::shared_ptr<detail::RenderImage>;
+
+	/// \brief Replace the image (eg when reloading).
+	/// \param image Image to swap in.
+	///
+	/// Safe to call while the Texture is being drawn on other threads: each draw binds either the previous or the new image.
+	/// The previous image is released once in-flight frames (and commands recorded this frame) are done with it.
+	void replace_image(std::shared_ptr<detail::RenderImage> image);
 
 	Sampler sampler{};
 
   protected:
+	/// \brief Constructor.
+	/// \param render_device Non-null pointer to RenderDevice.
+	/// \param image Image to own.
+	explicit Texture(NotNull<RenderDevice*> render_device, std::shared_ptr<detail::RenderImage> image)
+		: m_render_device(render_device), m_image(std::move(image)) {}
+
 	NotNull<RenderDevice*> m_render_device;
 	std::shared_ptr<detail::RenderImage> m_image{};
+
+  private:
+	// guards swaps of m_image (replace_image()) and the resolved sampler.
+	// heap allocated: Texture remains movable, and its mutex stable.
+	struct Binding {
+		std::mutex mutex{};
+		Sampler sampler{};
+		vk::Sampler handle{};
+	};
+
+	auto resolve_sampler() const -> vk::Sampler;
+	auto resolve_sampler(std::scoped_lock<std::mutex> const& lock) const -> vk::Sampler;
+
+	std::unique_ptr<Binding> m_binding{std::make_unique<Binding>()};
 };
 
 class TextureWriteable : public Texture {
@@ -11,10 +11,19 @@ class Texture9Slice : public Texture {
 	/// \param bitmap View of 9-slice bitmap.
 	/// \param slice NineSlice instance.
 	explicit Texture9Slice(NotNull<RenderDevice*> render_device, BitmapView bitmap, NineSlice slice) : Texture(render_device, bitmap, false), m_slice(slice) {}
+	/// \brief Constructor.
+	/// \param render_device Non-null pointer to RenderDevice.
+	/// \param bitmap View of 9-slice bitmap.
+	/// \param slice NineSlice instance.
+	/// \param uploader Batch to stage the upload into, must be submitted before the Texture9Slice is drawn.
+	explicit Texture9Slice(NotNull<RenderDevice*> render_device, BitmapView bitmap, NineSlice slice, detail::ImageUploader& uploader)
+		: Texture(render_device, bitmap, false, uploader), m_slice(slice) {}
 
 	[[nodiscard]] auto get_slice() const -> NineSlice const& { return m_slice; }
 
   private:
 	NineSlice m_slice;
+
+	friend class AssetCache;
 };
 } // namespace bave
@@ -12,11 +12,20 @@ class TextureAtlas : public Texture {
 	/// \param sheet TileSheet describing tiles and their rects.
 	/// \param mip_map Whether to enable mip-mapping.
 	explicit TextureAtlas(NotNull<RenderDevice*> render_device, BitmapView bitmap, TileSheet sheet, bool mip_map = false);
+	/// \brief Constructor.
+	/// \param render_device Non-null pointer to RenderDevice.
+	/// \param bitmap View of atlas bitmap.
+	/// \param sheet TileSheet describing tiles and their rects.
+	/// \param mip_map Whether to enable mip-mapping.
+	/// \param uploader Batch to stage the upload into, must be submitted before the TextureAtlas is drawn.
+	explicit TextureAtlas(NotNull<RenderDevice*> render_device, BitmapView bitmap, TileSheet sheet, bool mip_map, detail::ImageUploader& uploader);
 
 	[[nodiscard]] auto get_sheet() const -> TileSheet const& { return m_sheet; }
 	[[nodiscard]] auto get_uv(std::string_view id) const -> UvRect;
 
   private:
 	TileSheet m_sheet;
+
+	friend class AssetCache;
 };
 } // namespace bave
@@ -0,0 +1,89 @@
+#pragma once
+#include <bave/app.hpp>
+#include <bave/data_loader.hpp>
+#include <bave/driver.hpp>
+#include <functional>
+#include <optional>
+
+namespace bave {
+/// \brief Concrete App without a window: renders into an offscreen image.
+///
+/// Intended for benchmarks and golden image tests on build servers (works with software rasterizers like lavapipe / SwiftShader).
+/// Every frame is ticked with a fixed delta time, and the offscreen image can be read back after / during run().
+/// Dear ImGui calls are accepted but never rendered.
+class HeadlessApp : private App, private detail::IWsi {
+  public:
+	/// \brief Data needed during construction.
+	struct CreateInfo {
+		glm::ivec2 extent{1280, 720};
+		/// \brief Delta time of each frame.
+		Seconds fixed_dt{1.0f / 60.0f};
+		/// \brief Number of frames to run for, 0 to run until shutdown is requested.
+		std::uint64_t max_frames{};
+		std::function<Gpu(std::span<Gpu const>)> select_gpu{};
+		vk::SampleCountFlagBits msaa{vk::SampleCountFlagBits::e1};
+		/// \brief Frames in flight (1-3).
+		std::uint32_t frames_in_flight{RenderDeviceCreateInfo{}.frames_in_flight};
+		std::unique_ptr<IDataLoader> data_loader{};
+		std::string persistent_dir{};
+		bool validation_layers{debug_v};
+	};
+
+	/// \brief Constructor.
+	/// \param create_info CreateInfo for this instance.
+	explicit HeadlessApp(CreateInfo create_info);
+
+	using App::run;
+	using App::set_bootloader;
+
+	/// \brief Obtain the number of frames rendered.
+	[[nodiscard]] auto get_frame_count() const -> std::uint64_t { return m_frame_count; }
+	/// \brief Read back the last rendered frame.
+	/// \returns RGBA bitmap, std::nullopt if nothing has been rendered.
+	[[nodiscard]] auto read_framebuffer() const -> std::optional<Bitmap>;
+
+  private:
+	struct ImGuiContext {
+		bool init{};
+		auto operator==(ImGuiContext const&) const -> bool = default;
+
+		struct Deleter {
+			void operator()(ImGuiContext context) const noexcept;
+		};
+	};
+
+	auto setup() -> std::optional<ErrCode> final;
+	void poll_events() final;
+	void tick() final;
+	void render() final;
+
+	void do_shutdown() final { m_shutdown = true; }
+	[[nodiscard]] auto get_is_shutting_down() const -> bool final { return m_shutdown; }
+
+	[[nodiscard]] auto do_get_persistent_dir() const -> std::string_view final { return m_create_info.persistent_dir; }
+
+	[[nodiscard]] auto do_get_framebuffer_size() const -> glm::ivec2 final { return m_create_info.extent; }
+
+	[[nodiscard]] auto do_get_render_device() const -> RenderDevice& final;
+	[[nodiscard]] auto do_get_renderer() const -> Renderer& final;
+	[[nodiscard]] auto do_get_driver() const -> Ptr<Driver> final { return m_driver.get(); }
+
+	[[nodiscard]] auto get_instance_extensions() const -> std::span<char const* const> final { return {}; }
+	[[nodiscard]] auto make_surface(vk::Instance /*instance*/) const -> vk::SurfaceKHR final { return {}; }
+	[[nodiscard]] auto get_framebuffer_extent() const -> vk::Extent2D final { return detail::to_vk_extent(m_create_info.extent); }
+	[[nodiscard]] auto select_gpu(std::span<Gpu const> gpus) const -> Gpu final;
+	[[nodiscard]] auto is_headless() const -> bool final { return true; }
+
+	auto do_set_window_size(glm::ivec2 size) -> bool final;
+
+	void do_wait_render_device_idle() final;
+
+	CreateInfo m_create_info{};
+	ScopedResource<ImGuiContext, ImGuiContext::Deleter> m_imgui{};
+	std::unique_ptr<RenderDevice> m_render_device{};
+	std::unique_ptr<Renderer> m_renderer{};
+	std::unique_ptr<Driver> m_driver{};
+	std::uint64_t m_frame_count{};
+	bool m_shutdown{};
+};
+} // namespace bave
@@ -0,0 +1,20 @@
+#pragma once
+#include <imgui.h>
+#include <bave/core/fixed_string.hpp>
+#include <bave/profiler.hpp>
+
+namespace bave {
+/// \brief ImGui panel for Profiler: frame time graph, scopes of the last frame, Chrome trace export.
+class ImProfiler {
+  public:
+	/// \brief Draw the panel contents (inside an existing window).
+	void draw();
+
+	/// \brief Path that Export writes Chrome trace JSON to.
+	FixedString<128> trace_path{"bave_trace.json"};
+	ImVec2 graph_size{0.0f, 60.0f};
+
+  private:
+	std::vector<float> m_frame_times{};
+};
+} // namespace bave
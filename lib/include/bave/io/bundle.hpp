@@ -0,0 +1,82 @@
+#pragma once
+#include <bave/data_view.hpp>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace bave {
+/// \brief Packed asset bundle: an index of URIs sorted by hash, followed by aligned blobs.
+///
+/// Lookups are a binary search over the index, reads are views into the bundle bytes.
+/// All member functions are const and safe to call concurrently.
+class Bundle {
+  public:
+	static constexpr std::string_view extension_v{".bvb"};
+	static constexpr std::uint32_t version_v{1};
+	/// \brief Alignment of each blob.
+	static constexpr std::size_t alignment_v{16};
+
+	class Builder;
+
+	Bundle() = default;
+
+	/// \brief Construct from bundle bytes.
+	/// \param bytes View of bundle bytes, kept alive by the Bundle.
+	explicit Bundle(DataView bytes);
+
+	[[nodiscard]] auto is_valid() const -> bool { return m_valid; }
+	[[nodiscard]] auto get_count() const -> std::size_t { return m_count; }
+
+	/// \brief Check if an entry exists.
+	/// \param uri URI of entry.
+	/// \returns true if present.
+	[[nodiscard]] auto contains(std::string_view uri) const -> bool;
+	/// \brief Obtain a view into an entry.
+	/// \param uri URI of entry.
+	/// \returns View into the bundle bytes, empty if not present.
+	[[nodiscard]] auto find(std::string_view uri) const -> DataView;
+
+	/// \brief Hash used for the index (64-bit FNV-1a).
+	[[nodiscard]] static auto hash(std::string_view uri) -> std::uint64_t;
+
+  private:
+	struct Entry {
+		std::uint64_t offset{};
+		std::uint64_t size{};
+	};
+
+	[[nodiscard]] auto find_entry(std::string_view uri, Entry& out) const -> bool;
+
+	DataView m_bytes{};
+	std::size_t m_count{};
+	std::size_t m_strings_offset{};
+	bool m_valid{};
+};
+
+/// \brief Builds bundle bytes from a set of entries.
+class Bundle::Builder {
+  public:
+	/// \brief Add an entry.
+	/// \param uri URI of entry.
+	/// \param bytes Bytes of entry.
+	/// \returns Self.
+	///
+	/// Replaces any existing entry with the same URI.
+	auto add(std::string uri, std::vector<std::byte> bytes) -> Builder&;
+
+	[[nodiscard]] auto get_count() const -> std::size_t { return m_entries.size(); }
+
+	/// \brief Serialize added entries.
+	/// \returns Bundle bytes.
+	[[nodiscard]] auto build() const -> std::vector<std::byte>;
+
+  private:
+	struct Entry {
+		std::string uri{};
+		std::vector<std::byte> bytes{};
+	};
+
+	std::vector<Entry> m_entries{};
+};
+} // namespace bave
@@ -0,0 +1,25 @@
+#pragma once
+#include <bave/data_loader.hpp>
+#include <bave/io/bundle.hpp>
+
+namespace bave {
+/// \brief IDataLoader serving views into a Bundle (no copies on map()).
+class BundleLoader : public IDataLoader {
+  public:
+	explicit BundleLoader(Bundle bundle) : m_bundle(std::move(bundle)) {}
+
+	[[nodiscard]] auto get_bundle() const -> Bundle const& { return m_bundle; }
+
+  private:
+	[[nodiscard]] auto exists(std::string_view uri) const -> bool final { return m_bundle.contains(uri); }
+	[[nodiscard]] auto read_bytes(std::vector<std::byte>& out, std::string_view uri) const -> bool final {
+		if (!m_bundle.contains(uri)) { return false; }
+		auto const view = m_bundle.find(uri);
+		out.assign(view.get_bytes().begin(), view.get_bytes().end());
+		return true;
+	}
+	[[nodiscard]] auto map(std::string_view uri) const -> DataView final { return m_bundle.find(uri); }
+
+	Bundle m_bundle;
+};
+} // namespace bave
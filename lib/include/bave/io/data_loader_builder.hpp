@@ -6,7 +6,7 @@
 static_assert(bave::platform_v == bave::Platform::eDesktop);
 
 namespace bave {
-/// \brief Concrete IDataLoader builder based on input searches for asset directories / ZIPs.
+/// \brief Concrete IDataLoader builder based on input searches for asset directories / ZIPs / Bundles.
 class DataLoaderBuilder {
   public:
 	/// \brief Construct an instance.
@@ -36,6 +36,10 @@ class DataLoaderBuilder {
 	/// \param uri ZIP filename to search for.
 	/// \returns Self.
 	auto add_zip(std::string uri) -> DataLoaderBuilder&;
+	/// \brief Add a Bundle file search.
+	/// \param uri Bundle filename to search for.
+	/// \returns Self.
+	auto add_bundle(std::string uri) -> DataLoaderBuilder&;
 
 	/// \brief Build a concrete IDataLoader based on first successful search.
 	/// \returns Concrete IDataLoader.
@@ -44,7 +48,7 @@ class DataLoaderBuilder {
 	[[nodiscard]] auto build() const -> std::unique_ptr<IDataLoader>;
 
   private:
-	enum class Type : int { eDir, eZip };
+	enum class Type : int { eDir, eZip, eBundle };
 
 	struct Entry {
 		std::string input{};
@@ -53,6 +57,7 @@ class DataLoaderBuilder {
 
 	[[nodiscard]] auto build_dir(std::string_view patterns) const -> std::unique_ptr<IDataLoader>;
 	[[nodiscard]] auto build_zip(std::string_view uri) const -> std::unique_ptr<IDataLoader>;
+	[[nodiscard]] auto build_bundle(std::string_view uri) const -> std::unique_ptr<IDataLoader>;
 
 	Logger m_log{"DataLoaderBuilder"};
 
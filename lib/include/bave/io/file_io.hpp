@@ -1,5 +1,6 @@
 #pragma once
 #include <bave/core/c_string.hpp>
+#include <bave/data_view.hpp>
 #include <span>
 #include <string>
 #include <vector>
@@ -37,6 +38,16 @@ namespace bave::file {
 /// \returns true on success.
 [[nodiscard]] auto read_string(std::string& out, CString path) -> bool;
 
+/// \brief Memory-map a file.
+/// \param path Path to map.
+/// \returns DataView into mapped file, invalid on failure (valid and empty for zero-byte files).
+///
+/// The mapping is released when the last copy of the returned view is destroyed.
+/// Mapped files must not be truncated or rewritten in place while mapped (accessing truncated pages raises SIGBUS on POSIX):
+/// writers should write to a temporary file and rename it over the original.
+/// FileLoader copies files into memory instead of mapping them once it has created a FileWatcher (hot reload).
+[[nodiscard]] auto map(CString path) -> DataView;
+
 /// \brief Write bytes to a file.
 /// \param path Path to write to.
 /// \param data Bytes to write.
@@ -1,8 +1,13 @@
 #pragma once
 #include <bave/data_loader.hpp>
 #include <bave/logger.hpp>
+#include <atomic>
 
 namespace bave {
+/// \brief IDataLoader for a directory on the filesystem.
+///
+/// map() memory-maps files, until make_watcher() is called: files may then be rewritten in place (eg by editors),
+/// which would fault mapped pages, so they are read into memory instead.
 class FileLoader : public IDataLoader {
   public:
 	explicit FileLoader(std::string_view mount_point);
@@ -12,9 +17,12 @@ class FileLoader : public IDataLoader {
   private:
 	[[nodiscard]] auto exists(std::string_view uri) const -> bool final;
 	auto read_bytes(std::vector<std::byte>& out, std::string_view uri) const -> bool final;
+	[[nodiscard]] auto map(std::string_view uri) const -> DataView final;
 	auto read_string(std::string& out, std::string_view uri) const -> bool final;
+	[[nodiscard]] auto make_watcher() const -> std::unique_ptr<FileWatcher> final;
 
 	Logger m_log{"FileLoader"};
 	std::string m_prefix{};
+	mutable std::atomic<bool> m_watched{};
 };
 } // namespace bave
@@ -0,0 +1,43 @@
+#pragma once
+#include <bave/core/time.hpp>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace bave {
+/// \brief Watches a directory tree for modified files.
+///
+/// Uses inotify on Linux, unsupported (inactive) elsewhere.
+/// Events are debounced: a file is reported once it has not been modified for the debounce duration.
+/// Watched directories that are deleted, moved or replaced (including root) are watched again once they exist at their paths.
+class FileWatcher {
+  public:
+	static constexpr auto debounce_v = Seconds{0.1f};
+
+	/// \brief Constructor.
+	/// \param root Directory to watch recursively.
+	/// \param debounce Duration a file must be unmodified for before being reported.
+	explicit FileWatcher(std::string root, Seconds debounce = debounce_v);
+
+	/// \brief Check if the watcher is active.
+	/// \returns true if watching root.
+	[[nodiscard]] auto is_active() const -> bool { return m_impl != nullptr; }
+	[[nodiscard]] auto get_root() const -> std::string_view { return m_root; }
+
+	/// \brief Drain pending events without blocking.
+	/// \returns Paths (relative to root) of files modified since the last call.
+	///
+	/// Costs a single non-blocking read when nothing has changed.
+	[[nodiscard]] auto poll() -> std::vector<std::string>;
+
+  private:
+	struct Impl;
+	struct Deleter {
+		void operator()(Impl* ptr) const;
+	};
+
+	std::string m_root{};
+	Seconds m_debounce{};
+	std::unique_ptr<Impl, Deleter> m_impl{};
+};
+} // namespace bave
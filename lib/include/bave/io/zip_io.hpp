@@ -8,6 +8,13 @@ namespace bave::zip {
 /// \param zip_bytes Bytes of ZIP archive.
 /// \returns true on success.
 [[nodiscard]] auto mount(std::string name, std::vector<std::byte> zip_bytes) -> bool;
+/// \brief Mount a ZIP archive into ZIP VFS.
+/// \param name Name to mount as: must be unique.
+/// \param zip_bytes View of ZIP archive (eg mapped file), kept alive until unmounted.
+/// \returns true on success.
+///
+/// The central directory is indexed once on mount; entries can then be read concurrently.
+[[nodiscard]] auto mount(std::string name, DataView zip_bytes) -> bool;
 /// \brief Unmount a ZIP archive from ZIP VFS.
 /// \param name Name of mounted archive.
 /// \returns true on success.
@@ -27,4 +34,9 @@ namespace bave::zip {
 /// \param path Path to read from.
 /// \returns true on success.
 [[nodiscard]] auto read_bytes(std::vector<std::byte>& out, CString path) -> bool;
+
+/// \brief Map a file within ZIP VFS.
+/// \param path Path to map.
+/// \returns DataView into the archive for stored entries, else into inflated bytes. Empty on failure.
+[[nodiscard]] auto map(CString path) -> DataView;
 } // namespace bave::zip
@@ -8,5 +8,6 @@ class ZipLoader : public IDataLoader {
 	[[nodiscard]] auto read_bytes(std::vector<std::byte>& out, std::string_view uri) const -> bool final {
 		return zip::read_bytes(out, std::string{uri}.c_str());
 	}
+	[[nodiscard]] auto map(std::string_view uri) const -> DataView final { return zip::map(std::string{uri}.c_str()); }
 };
 } // namespace bave
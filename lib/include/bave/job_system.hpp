@@ -0,0 +1,152 @@
+#pragma once
+#include <bave/core/pinned.hpp>
+#include <bave/logger.hpp>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <thread>
+#include <vector>
+
+namespace bave {
+/// \brief Work-stealing job scheduler.
+///
+/// Each worker thread owns a deque: it pushes and pops its own jobs at the back, idle workers steal from the front of others'.
+/// Jobs scheduled from other threads are distributed round-robin across workers.
+/// Waiting for a job (wait(), parallel_for()) only executes that job (or its unfinished dependencies) on the calling thread,
+/// if no worker has started it yet, and otherwise blocks: unrelated jobs never run inside a wait.
+/// Main thread jobs are only executed by run_main_jobs() (App calls it every frame, before ticking the Driver).
+class JobSystem : public Pinned {
+	struct Job;
+
+  public:
+	using Func = std::function<void()>;
+	using RangeFunc = std::function<void(std::size_t begin, std::size_t end)>;
+
+	/// \brief Handle to a scheduled job.
+	class Handle {
+	  public:
+		Handle() = default;
+
+		/// \brief Check if the job has completed.
+		[[nodiscard]] auto is_done() const -> bool;
+
+		explicit operator bool() const { return m_job != nullptr; }
+
+	  private:
+		explicit Handle(std::shared_ptr<Job> job) : m_job(std::move(job)) {}
+
+		std::shared_ptr<Job> m_job{};
+
+		friend class JobSystem;
+	};
+
+	/// \brief Constructor.
+	/// \param thread_count Number of worker threads, 0 for one less than hardware concurrency (minimum 1).
+	///
+	/// The constructing thread is considered the main thread.
+	explicit JobSystem(std::size_t thread_count = 0);
+	/// \brief Execute pending worker jobs and join workers.
+	///
+	/// Main thread jobs that have not been run are discarded.
+	~JobSystem();
+
+	[[nodiscard]] auto get_thread_count() const -> std::size_t { return m_workers.size(); }
+	[[nodiscard]] auto is_main_thread() const -> bool { return std::this_thread::get_id() == m_main_thread; }
+
+	/// \brief Schedule a job on a worker thread.
+	/// \param func Job to execute.
+	/// \param dependencies Jobs that must complete before this one starts.
+	/// \returns Handle to the scheduled job.
+	auto schedule(Func func, std::span<Handle const> dependencies = {}) -> Handle;
+	/// \brief Schedule a job on the main thread (eg a continuation of worker jobs that touches App / Renderer state).
+	/// \param func Job to execute.
+	/// \param dependencies Jobs that must complete before this one starts.
+	/// \returns Handle to the scheduled job.
+	auto schedule_on_main(Func func, std::span<Handle const> dependencies = {}) -> Handle;
+
+	/// \brief Execute a callable on a worker thread.
+	/// \param func Callable to execute.
+	/// \returns Future of the callable's result (or exception).
+	template <std::invocable F>
+	[[nodiscard]] auto async(F func) -> std::future<std::invoke_result_t<F>> {
+		auto task = std::make_shared<std::packaged_task<std::invoke_result_t<F>()>>(std::move(func));
+		auto ret = task->get_future();
+		schedule([task] { (*task)(); });
+		return ret;
+	}
+
+	/// \brief Wait for a job to complete, executing it (or its dependencies) on the calling thread if not yet started.
+	/// \param handle Job to wait for.
+	///
+	/// Main thread jobs cannot be waited for on the main thread (they are only run by run_main_jobs()).
+	void wait(Handle const& handle);
+	/// \brief Block until no worker jobs are queued or executing.
+	///
+	/// Does not execute jobs, and must not be called from one.
+	/// Worker jobs that depend on pending main thread jobs remain pending: interleave with run_main_jobs() to drain both.
+	void wait_idle();
+
+	/// \brief Execute a function over [0, count) in chunks, across workers and the calling thread.
+	/// \param count Number of elements.
+	/// \param func Function to execute per chunk, given [begin, end).
+	/// \param grain Elements per chunk, 0 to split into a few chunks per thread.
+	///
+	/// The calling thread executes chunks too, then waits for the helper jobs (only).
+	/// Blocks until all chunks have completed. The first exception thrown by func is rethrown on the calling thread.
+	void parallel_for(std::size_t count, RangeFunc const& func, std::size_t grain = 0);
+	/// \brief Execute a function on each element of a span, across workers and the calling thread.
+	/// \param span Elements to execute on.
+	/// \param func Function to execute per element.
+	/// \param grain Elements per chunk, 0 to split into a few chunks per thread.
+	template <typename Type, std::invocable<Type&> F>
+	void parallel_for(std::span<Type> span, F const& func, std::size_t const grain = 0) {
+		parallel_for(span.size(), [span, &func](std::size_t const begin, std::size_t const end) {
+			for (auto index = begin; index < end; ++index) { func(span[index]); }
+		}, grain);
+	}
+
+	/// \brief Execute ready main thread jobs.
+	/// \returns Number of jobs executed.
+	auto run_main_jobs() -> std::size_t;
+
+  private:
+	struct Worker;
+
+	auto schedule_job(Func func, std::span<Handle const> dependencies, bool main_thread) -> Handle;
+	void release(std::shared_ptr<Job> const& job);
+	void enqueue(std::shared_ptr<Job> job);
+	void execute(Job& job);
+	void complete(Job& job);
+	[[nodiscard]] auto pop() -> std::shared_ptr<Job>;
+	[[nodiscard]] auto pop_main() -> std::shared_ptr<Job>;
+	[[nodiscard]] auto take(Job const& job) -> std::shared_ptr<Job>;
+	[[nodiscard]] auto try_run_one() -> bool;
+	[[nodiscard]] auto try_help(Job const& job) -> bool;
+	void notify_waiters();
+	void run_worker(std::size_t index);
+
+	Logger m_log{"JobSystem"};
+
+	std::vector<std::unique_ptr<Worker>> m_workers{};
+	std::thread::id m_main_thread{};
+
+	std::mutex m_main_mutex{};
+	std::deque<std::shared_ptr<Job>> m_main_jobs{};
+
+	std::mutex m_sleep_mutex{};
+	std::condition_variable m_work_cv{};
+	std::condition_variable m_done_cv{};
+	std::atomic<std::size_t> m_queued{};
+	// worker jobs being executed.
+	std::atomic<std::size_t> m_running{};
+	std::atomic<std::size_t> m_waiters{};
+	std::atomic<std::size_t> m_sleeping{};
+	std::atomic<std::size_t> m_next_worker{};
+	bool m_stop{};
+};
+} // namespace bave
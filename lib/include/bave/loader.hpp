@@ -1,6 +1,7 @@
 #pragma once
 #include <bave/asset_type.hpp>
 #include <bave/audio/audio_clip.hpp>
+#include <bave/core/ptr.hpp>
 #include <bave/data_store.hpp>
 #include <bave/font/font.hpp>
 #include <bave/graphics/anim_timeline.hpp>
@@ -11,8 +12,12 @@
 #include <bave/graphics/texture_9slice.hpp>
 #include <bave/graphics/texture_atlas.hpp>
 #include <bave/graphics/tile_sheet.hpp>
+#include <bave/job_system.hpp>
 #include <djson/json.hpp>
 #include <memory>
+#include <optional>
+#include <span>
+#include <vector>
 
 namespace bave {
 /// \brief Asset loader.
@@ -23,10 +28,23 @@ class Loader {
 	/// \param render_device Non-null pointer to a RenderDevice.
 	explicit Loader(NotNull<DataStore const*> data_store, NotNull<RenderDevice*> render_device);
 
+	/// \brief Whether load_texture() looks for a sibling KTX2 file first.
+	///
+	/// Opt-in: each lookup is an extra DataStore::exists() call (filesystem / archive probe) per texture.
+	bool prefer_compressed{};
+	/// \brief Whether load_font() looks for a sibling BakedFont file.
+	///
+	/// Opt-in: each lookup is an extra DataStore::exists() call (filesystem / archive probe) per font.
+	bool prefer_baked_fonts{};
+
 	/// \brief Try to load bytes.
 	/// \param uri URI to load from.
 	/// \returns vector of bytes on success, empty vector on failure.
 	[[nodiscard]] auto load_bytes(std::string_view uri) const -> std::vector<std::byte>;
+	/// \brief Try to map bytes without copying them.
+	/// \param uri URI to map.
+	/// \returns DataView on success, empty view on failure.
+	[[nodiscard]] auto map_bytes(std::string_view uri) const -> DataView;
 	/// \brief Try to load a Json.
 	/// \param uri URI to load from.
 	/// \returns Json on success, null Json on failure.
@@ -53,7 +71,18 @@ class Loader {
 	/// \param uri URI to load from.
 	/// \param mip_map Whether to enable mip-mapping.
 	/// \returns Texture on success, nullptr on failure.
+	///
+	/// If prefer_compressed is set, a KTX2 file exists at uri with CompressedImage::extension_v and its format is supported by the device,
+	/// it is uploaded as-is along with its precomputed mip levels (mip_map is then ignored). Otherwise the image at uri is decoded.
+	/// A uri with CompressedImage::extension_v is always loaded as KTX2.
 	[[nodiscard]] auto load_texture(std::string_view uri, bool mip_map = false) const -> std::shared_ptr<Texture>;
+	/// \brief Try to load multiple Textures.
+	/// \param uris URIs to load from.
+	/// \param mip_map Whether to enable mip-mapping.
+	/// \returns Texture for each uri, nullptr for failures.
+	///
+	/// Decoded images are uploaded, and their mip levels generated, in a single batch (one command buffer).
+	[[nodiscard]] auto load_textures(std::span<std::string_view const> uris, bool mip_map = false) const -> std::vector<std::shared_ptr<Texture>>;
 	/// \brief Try to load a Texture9Slice.
 	/// \param uri URI to load from.
 	/// \returns Texture9Slice on success, nullptr on failure.
@@ -63,15 +92,52 @@ class Loader {
 	/// \param mip_map Whether to enable mip-mapping.
 	/// \returns TextureAtlas on success, nullptr on failure.
 	[[nodiscard]] auto load_texture_atlas(std::string_view uri, bool mip_map = false) const -> std::shared_ptr<TextureAtlas>;
+
+	/// \brief Try to load a Texture, staging a decoded image into uploader.
+	/// \param uri URI to load from.
+	/// \param mip_map Whether to enable mip-mapping.
+	/// \param uploader Batch to stage into (uploaded immediately if null), must be submitted before the Texture is drawn.
+	/// \returns Texture on success, nullptr on failure.
+	[[nodiscard]] auto load_texture(std::string_view uri, bool mip_map, Ptr<detail::ImageUploader> uploader) const -> std::shared_ptr<Texture>;
+	/// \brief Try to load a Texture9Slice, staging its image into uploader.
+	/// \param uri URI to load from.
+	/// \param uploader Batch to stage into (uploaded immediately if null), must be submitted before the Texture9Slice is drawn.
+	/// \returns Texture9Slice on success, nullptr on failure.
+	[[nodiscard]] auto load_texture_9slice(std::string_view uri, Ptr<detail::ImageUploader> uploader) const -> std::shared_ptr<Texture9Slice>;
+	/// \brief Try to load a TextureAtlas, staging its image into uploader.
+	/// \param uri URI to load from.
+	/// \param mip_map Whether to enable mip-mapping.
+	/// \param uploader Batch to stage into (uploaded immediately if null), must be submitted before the TextureAtlas is drawn.
+	/// \returns TextureAtlas on success, nullptr on failure.
+	[[nodiscard]] auto load_texture_atlas(std::string_view uri, bool mip_map, Ptr<detail::ImageUploader> uploader) const -> std::shared_ptr<TextureAtlas>;
+
 	/// \brief Try to load a Font.
 	/// \param uri URI to load from.
 	/// \param preload List of TextHeights to preload glyph atlases for.
 	/// \returns Font on success, nullptr on failure.
+	///
+	/// If prefer_baked_fonts is set and a BakedFont exists at uri with BakedFont::extension_v, its atlases are used directly.
+	/// A uri with BakedFont::extension_v is always loaded as a BakedFont (without a font file, glyphs cannot be added at runtime).
 	[[nodiscard]] auto load_font(std::string_view uri, std::span<TextHeight const> preload = {}) const -> std::shared_ptr<Font>;
+	/// \brief Read the font file for load_font().
+	/// \param uri URI of font.
+	/// \returns Bytes of the font file, empty if uri is a BakedFont, or prefer_baked_fonts is set and the file does not exist.
+	[[nodiscard]] auto load_font_bytes(std::string_view uri) const -> std::vector<std::byte>;
+	/// \brief Try to load a Font from bytes already read.
+	/// \param uri URI file_bytes were read from (also used to locate a BakedFont).
+	/// \param file_bytes Bytestream of the font file, may be empty if a BakedFont is used.
+	/// \param preload List of TextHeights to preload glyph atlases for.
+	/// \returns Font on success, nullptr on failure.
+	[[nodiscard]] auto load_font(std::string_view uri, std::vector<std::byte> file_bytes, std::span<TextHeight const> preload) const -> std::shared_ptr<Font>;
 	/// \brief Try to load an AudioClip.
 	/// \param uri URI to load from.
 	/// \returns AudioClip on success, nullptr on failure.
 	[[nodiscard]] auto load_audio_clip(std::string_view uri) const -> std::shared_ptr<AudioClip>;
+	/// \brief Try to load an AudioClip from bytes already read.
+	/// \param uri URI bytes were read from (used to determine the compression).
+	/// \param bytes Compressed bytestream.
+	/// \returns AudioClip on success, nullptr on failure.
+	[[nodiscard]] auto load_audio_clip(std::string_view uri, std::span<std::byte const> bytes) const -> std::shared_ptr<AudioClip>;
 	/// \brief Try to load an AnimTimeline.
 	/// \param uri URI to load from.
 	/// \returns AnimTimeline on success, nullptr on failure.
@@ -81,7 +147,34 @@ class Loader {
 	/// \returns ParticleEmitter on success, nullptr on failure.
 	[[nodiscard]] auto load_particle_emitter(std::string_view uri) const -> std::shared_ptr<ParticleEmitter>;
 
+	/// \brief Load asynchronously on a JobSystem worker thread.
+	/// \param job_system JobSystem to load on.
+	/// \param load Callable that loads using a copy of this Loader, eg: [](Loader const& l) { return l.load_texture("images/foo.png"); }.
+	/// \returns Future of the result of load.
+	template <std::invocable<Loader const&> F>
+	[[nodiscard]] auto load_async(JobSystem& job_system, F load) const -> std::future<std::invoke_result_t<F, Loader const&>> {
+		return job_system.async([loader = *this, load = std::move(load)] { return load(loader); });
+	}
+
+	/// \brief Load asynchronously on a JobSystem worker thread, and pass the result to a callback on the main thread.
+	/// \param job_system JobSystem to load on.
+	/// \param load Callable that loads using a copy of this Loader.
+	/// \param on_loaded Callback to invoke on the main thread with the result of load (skipped if load throws).
+	/// \returns Handle to the main thread job.
+	template <std::invocable<Loader const&> F, std::invocable<std::invoke_result_t<F, Loader const&>> C>
+	auto load_async(JobSystem& job_system, F load, C on_loaded) const -> JobSystem::Handle {
+		auto result = std::make_shared<std::optional<std::invoke_result_t<F, Loader const&>>>();
+		auto const loaded = job_system.schedule([loader = *this, load = std::move(load), result] { result->emplace(load(loader)); });
+		return job_system.schedule_on_main(
+			[result, on_loaded = std::move(on_loaded)] {
+				if (*result) { on_loaded(std::move(**result)); }
+			},
+			std::span{&loaded, 1});
+	}
+
   private:
+	[[nodiscard]] auto load_compressed_texture(std::string_view uri, bool mip_map, Ptr<detail::ImageUploader> uploader) const -> std::shared_ptr<Texture>;
+
 	Logger m_log{"Loader"};
 	NotNull<DataStore const*> m_data_store;
 	NotNull<RenderDevice*> m_render_device;
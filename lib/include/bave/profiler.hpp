@@ -0,0 +1,154 @@
+#pragma once
+#include <bave/core/c_string.hpp>
+#include <bave/core/pinned.hpp>
+#include <bave/core/time.hpp>
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace bave {
+/// \brief Whether profiling is compiled in (BAVE_USE_PROFILER).
+#if defined(BAVE_USE_PROFILER)
+constexpr bool profiler_v{true};
+#else
+constexpr bool profiler_v{false};
+#endif
+
+/// \brief Frame profiler: CPU scopes and GPU timestamps of the last N frames.
+///
+/// CPU scopes are recorded via BAVE_PROFILE_SCOPE, which compiles to nothing unless BAVE_USE_PROFILER is defined.
+/// GPU scopes (render pass, and optionally each draw) are recorded by Renderer via timestamp queries,
+/// and resolved when the frame's fence is next waited on (ie, a frame or two later).
+/// Recording is thread-safe.
+class Profiler : public Pinned {
+  public:
+	static constexpr std::size_t default_max_frames_v{120};
+
+	/// \brief CPU scope.
+	struct Sample {
+		/// \brief Name of scope (must outlive the Profiler, eg a string literal).
+		std::string_view name{};
+		Clock::time_point start{};
+		Clock::duration duration{};
+		/// \brief Nesting depth on the recording thread.
+		int depth{};
+		/// \brief Logger thread ID.
+		int thread{};
+	};
+
+	/// \brief GPU scope.
+	struct GpuSample {
+		/// \brief Name of scope (must outlive the Profiler, eg a string literal).
+		std::string_view name{};
+		/// \brief Start time relative to the first timestamp of the frame.
+		std::chrono::nanoseconds offset{};
+		std::chrono::nanoseconds duration{};
+		int depth{};
+	};
+
+	struct Frame {
+		std::uint64_t index{};
+		Clock::time_point start{};
+		Clock::duration duration{};
+		std::vector<Sample> cpu{};
+		std::vector<GpuSample> gpu{};
+	};
+
+	/// \brief Obtain the global instance.
+	[[nodiscard]] static auto self() -> Profiler&;
+
+	/// \brief Enable / disable recording.
+	/// \param enabled Whether to record.
+	///
+	/// Has no effect unless profiler_v is true.
+	void set_enabled(bool enabled);
+	[[nodiscard]] auto is_enabled() const -> bool { return profiler_v && m_enabled.load(std::memory_order_relaxed); }
+
+	/// \brief Enable / disable GPU timestamps around each draw call.
+	void set_gpu_draw_timing(bool enabled) { m_gpu_draw_timing = enabled; }
+	[[nodiscard]] auto is_gpu_draw_timing() const -> bool { return is_enabled() && m_gpu_draw_timing.load(std::memory_order_relaxed); }
+
+	/// \brief Set the number of completed frames to retain.
+	/// \param count Number of frames (clamped to at least 1).
+	void set_max_frames(std::size_t count);
+	[[nodiscard]] auto get_max_frames() const -> std::size_t;
+
+	/// \brief Complete the current frame and start the next one.
+	///
+	/// Called by App at the start of each frame.
+	void next_frame();
+	/// \brief Obtain the index of the frame being recorded.
+	[[nodiscard]] auto get_frame_index() const -> std::uint64_t;
+
+	/// \brief Record a CPU sample into the current frame.
+	void record(Sample const& sample);
+	/// \brief Attach resolved GPU samples to a (retained) frame.
+	/// \param frame_index Index of frame the samples were recorded in.
+	/// \param samples Resolved samples.
+	void add_gpu_samples(std::uint64_t frame_index, std::span<GpuSample const> samples);
+
+	/// \brief Obtain a copy of retained frames.
+	/// \returns Completed frames, oldest first.
+	[[nodiscard]] auto get_frames() const -> std::vector<Frame>;
+	/// \brief Obtain a copy of the most recent completed frame.
+	/// \returns Most recent frame, empty if none.
+	[[nodiscard]] auto get_last_frame() const -> Frame;
+	/// \brief Obtain the duration of each retained frame.
+	/// \returns Frame times in milliseconds, oldest first.
+	[[nodiscard]] auto get_frame_times() const -> std::vector<float>;
+
+	/// \brief Drop all retained frames.
+	void clear();
+
+	/// \brief Serialize retained frames as Chrome trace JSON (chrome://tracing, Perfetto).
+	/// \returns JSON string.
+	[[nodiscard]] auto to_chrome_trace() const -> std::string;
+	/// \brief Write retained frames as Chrome trace JSON.
+	/// \param path Path to write to.
+	/// \returns true on success.
+	auto write_chrome_trace(CString path) const -> bool;
+
+  private:
+	Profiler() = default;
+
+	mutable std::mutex m_mutex{};
+	std::vector<Frame> m_frames{};
+	// index of the oldest frame in m_frames.
+	std::size_t m_head{};
+	std::size_t m_max_frames{default_max_frames_v};
+	Frame m_current{};
+	Clock::time_point m_epoch{Clock::now()};
+
+	std::atomic<bool> m_enabled{};
+	std::atomic<bool> m_gpu_draw_timing{};
+};
+
+/// \brief RAII CPU profile scope: prefer BAVE_PROFILE_SCOPE.
+class ProfileScope : public Pinned {
+  public:
+	explicit ProfileScope(std::string_view name);
+	~ProfileScope();
+
+  private:
+	std::string_view m_name{};
+	Clock::time_point m_start{};
+	bool m_active{};
+};
+} // namespace bave
+
+// NOLINTBEGIN(cppcoreguidelines-macro-usage)
+#define BAVE_PROFILE_CAT_(a, b) a##b
+#define BAVE_PROFILE_CAT(a, b) BAVE_PROFILE_CAT_(a, b)
+
+#if defined(BAVE_USE_PROFILER)
+/// \brief Profile the enclosing scope (name must be a string literal).
+#define BAVE_PROFILE_SCOPE(name) ::bave::ProfileScope const BAVE_PROFILE_CAT(bave_profile_scope_, __LINE__) { name }
+#else
+/// \brief Profile the enclosing scope (name must be a string literal).
+#define BAVE_PROFILE_SCOPE(name) static_cast<void>(0)
+#endif
+// NOLINTEND(cppcoreguidelines-macro-usage)
@@ -146,8 +146,8 @@ auto find_index(Ptr<AInputEvent const> event, Pointer::Id id) -> std::optional<s
 }
 } // namespace
 
-AndroidApp::AndroidApp(android_app& app, vk::SampleCountFlagBits msaa, bool validation_layers)
-	: m_app(app), m_msaa(msaa), m_validation_layers(validation_layers) {
+AndroidApp::AndroidApp(android_app& app, vk::SampleCountFlagBits msaa, bool validation_layers, std::uint32_t frames_in_flight)
+	: m_app(app), m_msaa(msaa), m_validation_layers(validation_layers), m_frames_in_flight(frames_in_flight) {
 	m_app.userData = this;
 	if (m_app.activity->externalDataPath != nullptr && *m_app.activity->externalDataPath != '\0') { m_persistent_dir = m_app.activity->externalDataPath; }
 }
@@ -259,10 +259,12 @@ void AndroidApp::setup_event_callbacks() {
 void AndroidApp::init_graphics() {
 	auto const rdci = RenderDevice::CreateInfo{
 		.desired_samples = m_msaa,
+		.frames_in_flight = m_frames_in_flight,
 		.validation_layers = m_validation_layers,
 	};
 	m_render_device = std::make_unique<RenderDevice>(static_cast<detail::IWsi*>(this), rdci);
 	m_renderer = std::make_unique<Renderer>(m_render_device.get(), &get_data_store());
+	m_renderer->set_job_system(&get_job_system());
 }
 
 void AndroidApp::pause_render() {
@@ -37,4 +37,14 @@ auto AndroidDataLoader::read_bytes(std::vector<std::byte>& out, std::string_view
 }
 
 auto AndroidDataLoader::read_string(std::string& out, std::string_view const uri) const -> bool { return do_read_data(m_app, out, std::string{uri}.c_str()); }
+
+auto AndroidDataLoader::map(std::string_view const uri) const -> DataView {
+	auto asset = std::shared_ptr<AAsset>{open_asset(m_app->activity->assetManager, std::string{uri}.c_str())};
+	if (asset == nullptr) { return {}; }
+	auto const* data = AAsset_getBuffer(asset.get());
+	auto const size = AAsset_getLength(asset.get());
+	if (data == nullptr || size <= 0) { return {}; }
+	auto const bytes = std::span{static_cast<std::byte const*>(data), static_cast<std::size_t>(size)};
+	return DataView{std::move(asset), bytes};
+}
 } // namespace bave
@@ -20,6 +20,8 @@ struct AndroidDataLoader : IDataLoader {
 
 	auto read_string(std::string& out, std::string_view uri) const -> bool final;
 
+	[[nodiscard]] auto map(std::string_view uri) const -> DataView final;
+
 	Logger m_log{"AndroidDataLoader"};
 	NotNull<android_app*> m_app;
 };
@@ -1,10 +1,10 @@
+#include <bave/io/bundle_loader.hpp>
 #include <bave/io/data_loader_builder.hpp>
 #include <bave/io/file_io.hpp>
 #include <bave/io/file_loader.hpp>
 #include <bave/io/zip_io.hpp>
 #include <bave/io/zip_loader.hpp>
 #include <bave/logger.hpp>
-#include <src/io/zip_io_reinit.hpp>
 #include <filesystem>
 #include <span>
 
@@ -16,7 +16,6 @@ DataLoaderBuilder::DataLoaderBuilder(int argc, char const* const* argv) {
 	if (args.empty()) { return; }
 
 	m_exe_dir = fs::absolute({args.front()}).parent_path().make_preferred().generic_string();
-	zip::reinit(args.front());
 }
 
 auto DataLoaderBuilder::upfind(std::string_view const patterns) const -> std::string { return file::upfind(get_exe_dir(), patterns); }
@@ -29,6 +28,12 @@ auto DataLoaderBuilder::add_zip(std::string uri) -> DataLoaderBuilder& {
 	return *this;
 }
 
+auto DataLoaderBuilder::add_bundle(std::string uri) -> DataLoaderBuilder& {
+	if (uri.empty()) { return *this; }
+	m_entries.push_back(Entry{.input = std::move(uri), .type = Type::eBundle});
+	return *this;
+}
+
 auto DataLoaderBuilder::add_dir(std::string patterns) -> DataLoaderBuilder& {
 	if (patterns.empty()) { return *this; }
 	m_entries.push_back(Entry{.input = std::move(patterns), .type = Type::eDir});
@@ -41,6 +46,7 @@ auto DataLoaderBuilder::build() const -> std::unique_ptr<IDataLoader> {
 		switch (entry.type) {
 		case Type::eDir: ret = build_dir(entry.input); break;
 		case Type::eZip: ret = build_zip(entry.input); break;
+		case Type::eBundle: ret = build_bundle(entry.input); break;
 		default: break;
 		}
 		if (ret) { return ret; }
@@ -70,8 +76,8 @@ auto DataLoaderBuilder::build_zip(std::string_view const uri) const -> std::uniq
 		return {};
 	}
 
-	auto zip_bytes = std::vector<std::byte>{};
-	if (!file::read_bytes(zip_bytes, zip_path.c_str())) {
+	auto zip_bytes = file::map(zip_path.c_str());
+	if (!zip_bytes) {
 		m_log.warn("failed to read ZIP: '{}'", zip_path);
 		return {};
 	}
@@ -84,4 +90,21 @@ auto DataLoaderBuilder::build_zip(std::string_view const uri) const -> std::uniq
 	m_log.info("using ZipLoader with mounted ZIP: '{}'", zip_path);
 	return std::make_unique<ZipLoader>();
 }
+
+auto DataLoaderBuilder::build_bundle(std::string_view const uri) const -> std::unique_ptr<IDataLoader> {
+	auto bundle_path = file::upfind(m_exe_dir, uri);
+	if (bundle_path.empty()) {
+		m_log.warn("failed to find Bundle: '{}'", uri);
+		return {};
+	}
+
+	auto bundle = Bundle{file::map(bundle_path.c_str())};
+	if (!bundle.is_valid()) {
+		m_log.warn("invalid Bundle: '{}'", bundle_path);
+		return {};
+	}
+
+	m_log.info("using BundleLoader with mapped Bundle: '{}' ({} entries)", bundle_path, bundle.get_count());
+	return std::make_unique<BundleLoader>(std::move(bundle));
+}
 } // namespace bave
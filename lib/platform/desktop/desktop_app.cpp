@@ -347,10 +347,13 @@ void DesktopApp::make_window() {
 void DesktopApp::init_graphics() {
 	auto const rdci = RenderDevice::CreateInfo{
 		.desired_samples = m_create_info.msaa,
+		.frames_in_flight = m_create_info.frames_in_flight,
 		.validation_layers = m_create_info.validation_layers,
 	};
+	m_frame_pacer.set_target_fps(m_create_info.target_fps);
 	m_render_device = std::make_unique<RenderDevice>(static_cast<detail::IWsi*>(this), rdci);
 	m_renderer = std::make_unique<Renderer>(m_render_device.get(), &get_data_store());
+	m_renderer->set_job_system(&get_job_system());
 	m_dear_imgui = std::make_unique<detail::DearImGui>(m_window.get(), *m_render_device, m_renderer->get_render_pass());
 
 	m_renderer->start_render(m_create_info.splash);
@@ -1,7 +1,7 @@
-#include <physfs.h>
 #include <bave/app.hpp>
 #include <bave/core/error.hpp>
 #include <bave/driver.hpp>
+#include <bave/profiler.hpp>
 #include <capo/error_handler.hpp>
 
 namespace bave {
@@ -27,13 +27,34 @@ auto App::run() -> ErrCode {
 		if (auto const ret = setup()) { return *ret; }
 
 		while (!is_shutting_down()) {
+			{
+				BAVE_PROFILE_SCOPE("frame_pacing");
+				m_frame_pacer.wait();
+			}
 			start_next_frame();
-			poll_events();
-			pre_tick();
-			tick();
-			render();
+			{
+				BAVE_PROFILE_SCOPE("poll_events");
+				m_frame_pacer.mark_input();
+				poll_events();
+			}
+			{
+				BAVE_PROFILE_SCOPE("pre_tick");
+				pre_tick();
+			}
+			{
+				BAVE_PROFILE_SCOPE("tick");
+				tick();
+			}
+			{
+				BAVE_PROFILE_SCOPE("render");
+				render();
+			}
+			m_frame_pacer.mark_present();
+			record_render_stats();
 		}
 
+		// main thread jobs may be continuations of worker jobs, and vice versa.
+		do { m_job_system->wait_idle(); } while (m_job_system->run_main_jobs() > 0);
 		do_wait_render_device_idle();
 		return ErrCode::eSuccess;
 	} catch (std::exception const& e) {
@@ -64,15 +85,28 @@ auto App::load_shader(std::string_view vertex, std::string_view fragment) const
 		return {};
 	}
 
+	// load modules up front to report failure.
 	auto& shader_cache = renderer.get_pipeline_cache().get_shader_cache();
-	auto vert = shader_cache.load(vertex);
-	auto frag = shader_cache.load(fragment);
-	if (!vert || !frag) { return {}; }
+	if (!shader_cache.load(vertex) || !shader_cache.load(fragment)) { return {}; }
 
-	return Shader{&get_renderer(), vert, frag};
+	return Shader{&get_renderer(), vertex, fragment};
 }
 
-void App::set_data_loader(std::unique_ptr<IDataLoader> loader) { m_data_store->set_loader(std::move(loader)); }
+void App::set_data_loader(std::unique_ptr<IDataLoader> loader) {
+	m_data_store->set_loader(std::move(loader));
+	if (m_file_watcher) { set_hot_reload(true); }
+}
+
+auto App::set_hot_reload(bool const enable) -> bool {
+	m_file_watcher.reset();
+	if (!enable) { return true; }
+	m_file_watcher = m_data_store->make_watcher();
+	if (!m_file_watcher) {
+		m_log.warn("hot reload not supported by DataLoader");
+		return false;
+	}
+	return true;
+}
 
 auto App::get_features() const -> FeatureFlags {
 	auto ret = do_get_native_features();
@@ -89,15 +123,40 @@ auto App::get_display_ratio() const -> glm::vec2 {
 }
 
 void App::start_next_frame() {
+	Profiler::self().next_frame();
 	m_events.clear();
 	m_drops.clear();
+	m_file_changes.clear();
 	m_dt.update();
+	if (m_fixed_dt) { m_dt.dt = *m_fixed_dt; }
 }
 
 void App::pre_tick() {
+	m_job_system->run_main_jobs();
 	m_gesture_recognizer.update(get_active_pointers());
 	m_audio_streamer->tick(get_dt());
 	m_timer.tick(get_dt());
+	poll_file_changes();
+}
+
+void App::poll_file_changes() {
+	if (!m_file_watcher) { return; }
+	m_file_changes = m_file_watcher->poll();
+	if (m_file_changes.empty()) { return; }
+
+	auto& pipeline_cache = get_pipeline_cache();
+	for (auto const& uri : m_file_changes) {
+		m_log.debug("file modified: '{}'", uri);
+		pipeline_cache.invalidate(uri);
+	}
+}
+
+void App::record_render_stats() {
+	auto const& stats = get_render_stats();
+	// frames that were not rendered (eg while minimized) leave the stats unchanged.
+	if (stats.frame == m_render_stats_frame) { return; }
+	m_render_stats_frame = stats.frame;
+	m_render_stats_history.push(stats);
 }
 
 void App::push_event(Event event) {
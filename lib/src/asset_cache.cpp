@@ -0,0 +1,355 @@
+#include <fmt/format.h>
+#include <bave/asset_cache.hpp>
+#include <bave/graphics/detail/image_uploader.hpp>
+#include <algorithm>
+#include <concepts>
+
+namespace bave {
+namespace {
+constexpr std::string_view mip_v{"mip"};
+
+[[nodiscard]] auto make_key(AssetCache::Type const type, std::string_view const uri, std::string_view const variant) -> std::string {
+	return fmt::format("{}:{}:{}", static_cast<int>(type), variant, uri);
+}
+
+// sum of all mip levels in the image's format (block compressed formats are a fraction of RGBA).
+[[nodiscard]] auto get_texture_bytes(Texture const& texture) -> std::size_t {
+	auto const image = texture.get_image();
+	if (!image) { return 0; }
+	auto const extent = image->get_extent();
+	auto const ret = detail::compute_image_size(image->get_format(), extent, image->get_mip_levels());
+	// unknown format: assume RGBA.
+	if (ret == 0) { return static_cast<std::size_t>(extent.width) * static_cast<std::size_t>(extent.height) * 4; }
+	return static_cast<std::size_t>(ret);
+}
+
+// bucket for candidates with identical contents: matches are confirmed by comparing bytes.
+[[nodiscard]] auto make_content_key(AssetCache::Type const type, std::string_view const variant, std::span<std::byte const> bytes) -> std::string {
+	auto const hash = std::hash<std::string_view>{}(DataStore::as_string_view(bytes));
+	return fmt::format("{}:{}:{}:{:x}", static_cast<int>(type), variant, bytes.size(), hash);
+}
+} // namespace
+
+AssetCache::AssetCache(NotNull<DataStore const*> data_store, NotNull<RenderDevice*> render_device, CreateInfo const& create_info)
+	: m_data_store(data_store), m_render_device(render_device), m_loader(data_store, render_device), m_dedupe(create_info.dedupe), m_budget(create_info.budget) {
+	m_loader.prefer_compressed = create_info.prefer_compressed;
+	m_loader.prefer_baked_fonts = create_info.prefer_baked_fonts;
+}
+
+auto AssetCache::load_texture(std::string_view const uri, bool const mip_map) -> std::shared_ptr<Texture> {
+	return get_or_load<Texture>(
+		Type::eTexture, uri, mip_map, [&] { return m_loader.load_texture(uri, mip_map); },
+		[](Texture const& texture) { return get_texture_bytes(texture); });
+}
+
+auto AssetCache::load_texture_9slice(std::string_view const uri) -> std::shared_ptr<Texture9Slice> {
+	return get_or_load<Texture9Slice>(
+		Type::eTexture9Slice, uri, false, [&] { return m_loader.load_texture_9slice(uri); },
+		[](Texture9Slice const& texture) { return get_texture_bytes(texture); });
+}
+
+auto AssetCache::load_texture_atlas(std::string_view const uri, bool const mip_map) -> std::shared_ptr<TextureAtlas> {
+	return get_or_load<TextureAtlas>(
+		Type::eTextureAtlas, uri, mip_map, [&] { return m_loader.load_texture_atlas(uri, mip_map); },
+		[](TextureAtlas const& texture) { return get_texture_bytes(texture); });
+}
+
+auto AssetCache::load_font(std::string_view const uri, std::span<TextHeight const> preload) -> std::shared_ptr<Font> {
+	// measured by the size of the font file read by the load.
+	auto size = std::size_t{};
+	auto const load = [&] {
+		auto file_bytes = m_loader.load_font_bytes(uri);
+		size = file_bytes.size();
+		return m_loader.load_font(uri, std::move(file_bytes), preload);
+	};
+	return get_or_load<Font>(Type::eFont, uri, false, load, [&size](Font const& /*font*/) { return size; });
+}
+
+auto AssetCache::load_audio_clip(std::string_view const uri) -> std::shared_ptr<AudioClip> {
+	// measured by the size of the compressed stream read by the load.
+	auto size = std::size_t{};
+	auto const load = [&]() -> std::shared_ptr<AudioClip> {
+		auto const bytes = m_loader.load_bytes(uri);
+		if (bytes.empty()) { return {}; }
+		size = bytes.size();
+		return m_loader.load_audio_clip(uri, bytes);
+	};
+	return get_or_load<AudioClip>(Type::eAudioClip, uri, false, load, [&size](AudioClip const& /*clip*/) { return size; });
+}
+
+auto AssetCache::load_anim_timeline(std::string_view const uri) -> std::shared_ptr<AnimTimeline> {
+	return get_or_load<AnimTimeline>(
+		Type::eAnimTimeline, uri, false, [&] { return m_loader.load_anim_timeline(uri); },
+		[](AnimTimeline const& timeline) { return sizeof(AnimTimeline) + timeline.tiles.size() * sizeof(std::string); });
+}
+
+auto AssetCache::contains(Type const type, std::string_view const uri) const -> bool {
+	auto lock = std::scoped_lock{m_mutex};
+	if (std::any_of(m_entries.begin(), m_entries.end(), [type, uri](auto const& it) { return it.second.type == type && it.second.uri == uri; })) {
+		return true;
+	}
+	auto const prefix = fmt::format("{}:", static_cast<int>(type));
+	return std::any_of(m_aliases.begin(), m_aliases.end(), [&](auto const& it) {
+		std::string_view const key = it.first;
+		if (!key.starts_with(prefix)) { return false; }
+		auto const variant_end = key.find(':', prefix.size());
+		return variant_end != std::string_view::npos && key.substr(variant_end + 1) == uri;
+	});
+}
+
+auto AssetCache::reload(std::span<std::string const> uris) -> std::size_t {
+	if (uris.empty()) { return {}; }
+
+	auto candidates = std::vector<std::pair<std::string, Entry>>{};
+	{
+		auto lock = std::scoped_lock{m_mutex};
+		candidates.assign(m_entries.begin(), m_entries.end());
+	}
+	// is_modified() may read JSON: check without holding the lock.
+	std::erase_if(candidates, [&](auto const& candidate) { return !is_modified(candidate.second, uris); });
+	if (candidates.empty()) { return {}; }
+
+	auto modified = std::vector<Entry>{};
+	{
+		auto lock = std::scoped_lock{m_mutex};
+		for (auto const& [key, candidate] : candidates) {
+			auto const it = m_entries.find(key);
+			// erased (or replaced) meanwhile.
+			if (it == m_entries.end() || it->second.asset != candidate.asset) { continue; }
+			modified.push_back(it->second);
+			switch (it->second.type) {
+			case Type::eTexture:
+			case Type::eTexture9Slice:
+			case Type::eTextureAtlas:
+				// contents no longer match the content key.
+				release_content(it);
+				it->second.content_key.clear();
+				break;
+			default: erase(it); break;
+			}
+		}
+	}
+
+	// load without holding the lock, uploading all reloaded images in one batch.
+	// images are owned via shared_ptr: staged uploads remain valid when moved into their targets.
+	auto uploader = detail::ImageUploader{m_render_device};
+	auto ret = std::size_t{};
+	for (auto const& entry : modified) {
+		switch (entry.type) {
+		case Type::eTexture: ret += reload_in_place(entry, m_loader.load_texture(entry.uri, entry.mip_map, &uploader)); break;
+		case Type::eTexture9Slice: ret += reload_in_place(entry, m_loader.load_texture_9slice(entry.uri, &uploader)); break;
+		case Type::eTextureAtlas: ret += reload_in_place(entry, m_loader.load_texture_atlas(entry.uri, entry.mip_map, &uploader)); break;
+		default: ++ret; break;
+		}
+	}
+	uploader.submit();
+	return ret;
+}
+
+void AssetCache::set_budget(std::size_t const bytes) {
+	auto lock = std::scoped_lock{m_mutex};
+	m_budget = bytes;
+	evict(m_budget);
+}
+
+auto AssetCache::get_budget() const -> std::size_t {
+	auto lock = std::scoped_lock{m_mutex};
+	return m_budget;
+}
+
+auto AssetCache::trim() -> std::size_t {
+	auto lock = std::scoped_lock{m_mutex};
+	return evict(0);
+}
+
+void AssetCache::clear() {
+	auto lock = std::scoped_lock{m_mutex};
+	m_entries.clear();
+	m_contents.clear();
+	m_aliases.clear();
+	m_stats = {};
+}
+
+auto AssetCache::get_stats(Type const type) const -> Stats {
+	auto lock = std::scoped_lock{m_mutex};
+	return m_stats[type];
+}
+
+auto AssetCache::get_total_stats() const -> Stats {
+	auto lock = std::scoped_lock{m_mutex};
+	auto ret = Stats{};
+	for (auto const& stats : m_stats) {
+		ret.count += stats.count;
+		ret.bytes += stats.bytes;
+	}
+	return ret;
+}
+
+template <typename T, typename F, typename G>
+auto AssetCache::get_or_load(Type const type, std::string_view const uri, bool const mip_map, F load, G measure) -> std::shared_ptr<T> {
+	auto const variant = mip_map ? mip_v : std::string_view{};
+	auto key = make_key(type, uri, variant);
+	if (auto ret = find(key)) { return std::static_pointer_cast<T>(std::move(ret)); }
+
+	auto content_key = std::string{};
+	if (m_dedupe) {
+		if (auto const bytes = m_data_store->map(uri)) {
+			content_key = make_content_key(type, variant, bytes.get_bytes());
+			if (auto ret = find_content(content_key, key, bytes.get_bytes())) { return std::static_pointer_cast<T>(std::move(ret)); }
+		}
+	}
+
+	// load without holding the lock: concurrent misses on the same key are resolved in insert().
+	std::shared_ptr<T> asset = load();
+	if (!asset) { return {}; }
+
+	auto entry = Entry{
+		.asset = asset,
+		.uri = std::string{uri},
+		.content_key = std::move(content_key),
+		.type = type,
+		.mip_map = mip_map,
+		.bytes = measure(*asset),
+	};
+	return std::static_pointer_cast<T>(insert(std::move(key), std::move(entry)));
+}
+
+template <typename T>
+auto AssetCache::reload_in_place(Entry const& entry, std::shared_ptr<T> fresh) -> std::size_t {
+	if (!fresh) {
+		m_log.warn("failed to reload: '{}'", entry.uri);
+		return 0;
+	}
+
+	auto& target = *std::static_pointer_cast<T>(entry.asset);
+	// draws on other threads keep using target: swap its image (they bind the old or the new one), rather than replacing target itself.
+	if constexpr (std::same_as<T, TextureAtlas>) { target.m_sheet = std::move(fresh->m_sheet); }
+	if constexpr (std::same_as<T, Texture9Slice>) { target.m_slice = fresh->m_slice; }
+	target.replace_image(fresh->get_image());
+
+	auto const bytes = get_texture_bytes(target);
+	auto lock = std::scoped_lock{m_mutex};
+	auto& stats = m_stats[entry.type];
+	if (auto const it = std::find_if(m_entries.begin(), m_entries.end(), [&entry](auto const& it) { return it.second.asset == entry.asset; });
+		it != m_entries.end()) {
+		stats.bytes = stats.bytes - it->second.bytes + bytes;
+		it->second.bytes = bytes;
+	}
+	m_log.info("reloaded: '{}'", entry.uri);
+	return 1;
+}
+
+auto AssetCache::is_modified(Entry const& entry, std::span<std::string const> uris) const -> bool {
+	auto const contains = [uris](std::string_view const uri) { return std::find(uris.begin(), uris.end(), uri) != uris.end(); };
+	if (contains(entry.uri)) { return true; }
+	if (entry.type != Type::eTexture9Slice && entry.type != Type::eTextureAtlas) { return false; }
+	// JSON assets also depend on the image they reference.
+	auto const json = m_data_store->read_json(entry.uri);
+	return json && contains(json["image"].as_string());
+}
+
+auto AssetCache::find(std::string const& key) -> std::shared_ptr<void> {
+	auto lock = std::scoped_lock{m_mutex};
+	auto it = m_entries.find(key);
+	if (it == m_entries.end()) {
+		auto const alias = m_aliases.find(key);
+		if (alias == m_aliases.end()) { return {}; }
+		it = m_entries.find(alias->second);
+		if (it == m_entries.end()) { return {}; }
+	}
+	it->second.last_used = ++m_clock;
+	return it->second.asset;
+}
+
+auto AssetCache::find_content(std::string const& content_key, std::string const& key, std::span<std::byte const> bytes) -> std::shared_ptr<void> {
+	auto candidate = std::string{};
+	auto candidate_uri = std::string{};
+	{
+		auto lock = std::scoped_lock{m_mutex};
+		auto const content = m_contents.find(content_key);
+		if (content == m_contents.end()) { return {}; }
+		auto const it = m_entries.find(content->second);
+		if (it == m_entries.end()) { return {}; }
+		candidate = it->first;
+		candidate_uri = it->second.uri;
+	}
+
+	// content keys may collide: compare bytes without holding the lock.
+	auto const candidate_bytes = m_data_store->map(candidate_uri);
+	if (!std::ranges::equal(candidate_bytes.get_bytes(), bytes)) { return {}; }
+
+	auto lock = std::scoped_lock{m_mutex};
+	auto const it = m_entries.find(candidate);
+	if (it == m_entries.end()) { return {}; }
+	m_aliases.insert_or_assign(key, it->first);
+	it->second.last_used = ++m_clock;
+	return it->second.asset;
+}
+
+auto AssetCache::insert(std::string key, Entry entry) -> std::shared_ptr<void> {
+	auto lock = std::scoped_lock{m_mutex};
+	if (auto const it = m_entries.find(key); it != m_entries.end()) {
+		// another thread loaded the same asset first.
+		it->second.last_used = ++m_clock;
+		return it->second.asset;
+	}
+
+	entry.last_used = ++m_clock;
+	auto& stats = m_stats[entry.type];
+	++stats.count;
+	stats.bytes += entry.bytes;
+	// the first entry with a content key is its owner, any others (concurrent loads, collisions) are only used if it is erased.
+	if (!entry.content_key.empty()) { m_contents.try_emplace(entry.content_key, key); }
+	auto ret = entry.asset;
+	m_entries.insert_or_assign(std::move(key), std::move(entry));
+
+	evict(m_budget);
+	return ret;
+}
+
+auto AssetCache::evict(std::size_t const budget) -> std::size_t {
+	auto ret = std::size_t{};
+	auto const get_total_bytes = [this] {
+		auto total = std::size_t{};
+		for (auto const& stats : m_stats) { total += stats.bytes; }
+		return total;
+	};
+	// budget 0 evicts every candidate, including those with no estimated bytes.
+	while (budget == 0 || get_total_bytes() > budget) {
+		// least recently used entry only owned by the cache.
+		auto lru = m_entries.end();
+		for (auto it = m_entries.begin(); it != m_entries.end(); ++it) {
+			if (it->second.asset.use_count() > 1) { continue; }
+			if (lru == m_entries.end() || it->second.last_used < lru->second.last_used) { lru = it; }
+		}
+		if (lru == m_entries.end()) { break; }
+		erase(lru);
+		++ret;
+	}
+	if (ret > 0) { m_log.debug("evicted {} asset(s)", ret); }
+	return ret;
+}
+
+void AssetCache::erase(EntryMap::iterator it) {
+	auto& stats = m_stats[it->second.type];
+	--stats.count;
+	stats.bytes -= it->second.bytes;
+	release_content(it);
+	std::erase_if(m_aliases, [&key = it->first](auto const& alias) { return alias.second == key; });
+	m_entries.erase(it);
+}
+
+void AssetCache::release_content(EntryMap::iterator it) {
+	auto const& content_key = it->second.content_key;
+	if (content_key.empty()) { return; }
+	auto const content = m_contents.find(content_key);
+	if (content == m_contents.end() || content->second != it->first) { return; }
+	// hand ownership over to another entry with the same content key, if any.
+	auto const is_successor = [&](auto const& other) { return other.first != it->first && other.second.content_key == content_key; };
+	if (auto const successor = std::find_if(m_entries.begin(), m_entries.end(), is_successor); successor != m_entries.end()) {
+		content->second = successor->first;
+	} else {
+		m_contents.erase(content);
+	}
+}
+} // namespace bave
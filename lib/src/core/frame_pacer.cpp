@@ -0,0 +1,37 @@
+#include <bave/core/frame_pacer.hpp>
+#include <algorithm>
+#include <thread>
+
+namespace bave {
+namespace {
+// weight of the latest sample in the average latency.
+constexpr float latency_weight_v{0.1f};
+} // namespace
+
+void FramePacer::set_target_fps(int const fps) {
+	m_target_fps = std::max(fps, 0);
+	m_period = m_target_fps > 0 ? std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>{1.0 / m_target_fps}) : Clock::duration{};
+	m_deadline = {};
+}
+
+void FramePacer::wait() {
+	if (m_period <= Clock::duration{}) { return; }
+
+	auto const now = Clock::now();
+	if (now < m_deadline) {
+		std::this_thread::sleep_until(m_deadline);
+		m_deadline += m_period;
+		return;
+	}
+
+	// missed the deadline: keep the cadence if only just, else restart it (instead of catching up with a burst of frames).
+	m_deadline = now - m_deadline > m_period ? now + m_period : m_deadline + m_period;
+}
+
+void FramePacer::mark_present() {
+	if (m_input == Clock::time_point{}) { return; }
+	m_latency = Clock::now() - m_input;
+	m_average_latency = m_average_latency == Seconds{} ? m_latency : m_average_latency + latency_weight_v * (m_latency - m_average_latency);
+	m_input = {};
+}
+} // namespace bave
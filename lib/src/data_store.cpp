@@ -34,6 +34,13 @@ auto DataStore::read_bytes(std::string_view uri) const -> std::vector<std::byte>
 	return {};
 }
 
+auto DataStore::map(std::string_view uri) const -> DataView {
+	if (uri.empty() || !m_loader) { return {}; }
+	auto ret = m_loader->map(uri);
+	if (!ret.is_valid()) { m_log.warn("failed to map data at: '{}'", uri); }
+	return ret;
+}
+
 auto DataStore::read_string(std::string_view uri) const -> std::string {
 	if (uri.empty() || !m_loader) { return {}; }
 	auto ret = std::string{};
@@ -43,9 +50,14 @@ auto DataStore::read_string(std::string_view uri) const -> std::string {
 }
 
 auto DataStore::read_json(std::string_view uri) const -> dj::Json {
-	auto str = read_string(uri);
-	if (str.empty()) { return {}; }
-	return dj::Json::parse(str);
+	auto const view = map(uri);
+	if (!view) { return {}; }
+	return dj::Json::parse(as_string_view(view));
+}
+
+auto DataStore::make_watcher() const -> std::unique_ptr<FileWatcher> {
+	if (!m_loader) { return {}; }
+	return m_loader->make_watcher();
 }
 
 auto DataStore::to_spir_v(std::string_view const glsl) const -> std::string {
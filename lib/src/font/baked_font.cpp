@@ -0,0 +1,150 @@
+#include <bave/font/baked_font.hpp>
+#include <bave/font/detail/font_atlas.hpp>
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstring>
+
+namespace bave {
+namespace {
+constexpr auto magic_v = std::array{std::byte{'B'}, std::byte{'V'}, std::byte{'F'}, std::byte{'A'}};
+
+struct Writer {
+	std::vector<std::byte>& out; // NOLINT(cppcoreguidelines-avoid-const-or-ref-data-members)
+
+	void u32(std::uint32_t const value) const {
+		for (int i = 0; i < 4; ++i) { out.push_back(static_cast<std::byte>((value >> (i * 8)) & 0xff)); }
+	}
+
+	void i32(std::int32_t const value) const { u32(static_cast<std::uint32_t>(value)); }
+	void ivec2(glm::ivec2 const value) const {
+		i32(value.x);
+		i32(value.y);
+	}
+};
+
+struct Reader {
+	std::span<std::byte const> bytes{};
+	bool failed{};
+
+	auto take(std::size_t const count) -> std::span<std::byte const> {
+		if (failed || bytes.size() < count) {
+			failed = true;
+			return {};
+		}
+		auto const ret = bytes.subspan(0, count);
+		bytes = bytes.subspan(count);
+		return ret;
+	}
+
+	auto u32() -> std::uint32_t {
+		auto const in = take(4);
+		if (in.empty()) { return {}; }
+		auto ret = std::uint32_t{};
+		for (int i = 0; i < 4; ++i) { ret |= static_cast<std::uint32_t>(in[static_cast<std::size_t>(i)]) << (i * 8); }
+		return ret;
+	}
+
+	auto i32() -> std::int32_t { return static_cast<std::int32_t>(u32()); }
+	auto ivec2() -> glm::ivec2 {
+		auto const x = i32();
+		return {x, i32()};
+	}
+};
+} // namespace
+
+auto BakedFont::bake(detail::GlyphSlot::Factory& slot_factory, std::span<TextHeight const> heights, InclusiveRange<Codepoint> const codepoints,
+					 float const scale) -> BakedFont {
+	auto ret = BakedFont{.scale = scale};
+	for (auto height : heights) {
+		height = clamp_text_height(height);
+		if (ret.find_atlas(height) != nullptr) { continue; }
+		auto atlas = detail::FontAtlas::bake(slot_factory, scale_text_height(height, scale), codepoints);
+		atlas.height = height;
+		ret.atlases.push_back(std::move(atlas));
+	}
+	return ret;
+}
+
+auto BakedFont::deserialize(std::span<std::byte const> bytes) -> bool {
+	auto reader = Reader{.bytes = bytes};
+	auto const magic = reader.take(magic_v.size());
+	if (reader.failed || !std::equal(magic.begin(), magic.end(), magic_v.begin())) { return false; }
+	if (reader.u32() != version_v) { return false; }
+
+	auto ret = BakedFont{};
+	ret.scale = std::bit_cast<float>(reader.u32());
+	auto const atlas_count = reader.u32();
+	for (std::uint32_t a = 0; a < atlas_count && !reader.failed; ++a) {
+		auto atlas = Atlas{};
+		atlas.height = static_cast<TextHeight>(reader.i32());
+		atlas.codepoints.lo = static_cast<Codepoint>(reader.i32());
+		atlas.codepoints.hi = static_cast<Codepoint>(reader.i32());
+		if (atlas.codepoints.hi < atlas.codepoints.lo) { return false; }
+		atlas.extent = reader.ivec2();
+		if (atlas.extent.x <= 0 || atlas.extent.y <= 0) { return false; }
+		auto const glyph_count = reader.u32();
+		if (glyph_count > reader.bytes.size()) { return false; }
+		atlas.glyphs.reserve(glyph_count);
+		for (std::uint32_t g = 0; g < glyph_count; ++g) {
+			auto glyph = Glyph{};
+			glyph.codepoint = static_cast<Codepoint>(reader.i32());
+			glyph.advance = reader.ivec2();
+			glyph.extent = reader.ivec2();
+			glyph.left_top = reader.ivec2();
+			glyph.rect.lt = reader.ivec2();
+			glyph.rect.rb = reader.ivec2();
+			atlas.glyphs.push_back(glyph);
+		}
+		// extent is untrusted: both are positive, multiply without overflow.
+		auto const alpha = reader.take(static_cast<std::size_t>(atlas.extent.x) * static_cast<std::size_t>(atlas.extent.y));
+		if (reader.failed) { return false; }
+		atlas.alpha.resize(alpha.size());
+		std::memcpy(atlas.alpha.data(), alpha.data(), alpha.size());
+		ret.atlases.push_back(std::move(atlas));
+	}
+	if (reader.failed) { return false; }
+
+	*this = std::move(ret);
+	return true;
+}
+
+auto BakedFont::serialize() const -> std::vector<std::byte> {
+	auto ret = std::vector<std::byte>{};
+	auto writer = Writer{ret};
+	ret.insert(ret.end(), magic_v.begin(), magic_v.end());
+	writer.u32(version_v);
+	writer.u32(std::bit_cast<std::uint32_t>(scale));
+	writer.u32(static_cast<std::uint32_t>(atlases.size()));
+	for (auto const& atlas : atlases) {
+		writer.i32(static_cast<std::int32_t>(atlas.height));
+		writer.i32(static_cast<std::int32_t>(atlas.codepoints.lo));
+		writer.i32(static_cast<std::int32_t>(atlas.codepoints.hi));
+		writer.ivec2(atlas.extent);
+		writer.u32(static_cast<std::uint32_t>(atlas.glyphs.size()));
+		for (auto const& glyph : atlas.glyphs) {
+			writer.i32(static_cast<std::int32_t>(glyph.codepoint));
+			writer.ivec2(glyph.advance);
+			writer.ivec2(glyph.extent);
+			writer.ivec2(glyph.left_top);
+			writer.ivec2(glyph.rect.lt);
+			writer.ivec2(glyph.rect.rb);
+		}
+		auto const alpha = std::as_bytes(std::span{atlas.alpha});
+		ret.insert(ret.end(), alpha.begin(), alpha.end());
+	}
+	return ret;
+}
+
+auto BakedFont::find_atlas(TextHeight const height) const -> Ptr<Atlas const> {
+	auto const it = std::find_if(atlases.begin(), atlases.end(), [height](Atlas const& atlas) { return atlas.height == height; });
+	if (it == atlases.end()) { return {}; }
+	return &*it;
+}
+
+auto BakedFont::Atlas::find_glyph(Codepoint const codepoint) const -> Ptr<Glyph const> {
+	auto const it = std::find_if(glyphs.begin(), glyphs.end(), [codepoint](Glyph const& glyph) { return glyph.codepoint == codepoint; });
+	if (it == glyphs.end()) { return {}; }
+	return &*it;
+}
+} // namespace bave
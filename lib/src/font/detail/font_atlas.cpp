@@ -1,55 +1,156 @@
 #include <bave/font/detail/font_atlas.hpp>
+#include <glm/common.hpp>
 
 namespace bave::detail {
-FontAtlas::FontAtlas(NotNull<RenderDevice*> render_device, NotNull<GlyphSlot::Factory*> slot_factory, TextHeight const height) : m_page(slot_factory, height) {
+namespace {
+constexpr int avg_glyphs_per_line_v = 8;
+// glyph quads sample upright UV rects: no rotation.
+constexpr auto layout_v = Pixmap::Builder::Layout{.packing = Pixmap::Builder::Packing::eSkyline, .sort_by_height = true};
+
+template <typename Func>
+void for_each_codepoint(InclusiveRange<Codepoint> const range, Func func) {
+	func(Codepoint::eTofu);
+	for (auto codepoint = static_cast<int>(range.lo); codepoint <= static_cast<int>(range.hi); ++codepoint) {
+		if (static_cast<Codepoint>(codepoint) == Codepoint::eTofu) { continue; }
+		func(static_cast<Codepoint>(codepoint));
+	}
+}
+
+struct GlyphPacker {
 	struct Entry {
 		Codepoint codepoint{};
 		Glyph glyph{};
 	};
 
-	static constexpr int avg_glyphs_per_line = 8;
-
-	auto const max_width = static_cast<int>(height) * avg_glyphs_per_line;
-	auto const pad = static_cast<int>(scale_text_height(height, 0.1f));
+	Pixmap::Builder builder;
+	std::vector<Entry> entries{};
 
-	auto builder = Pixmap::Builder{max_width, glm::ivec2{pad}};
-	auto entries = std::vector<Entry>{};
+	explicit GlyphPacker(TextHeight const height)
+		: builder(static_cast<int>(height) * avg_glyphs_per_line_v, glm::ivec2{static_cast<int>(scale_text_height(height, 0.1f))}, layout_v) {}
 
-	auto const add_codepoint = [&](Codepoint const codepoint) {
-		auto slot = m_page.slot_for(codepoint);
+	void add(Codepoint const codepoint, GlyphSlot slot) {
 		if (!slot) { return; }
-
-		auto glyph = Glyph{
+		auto const glyph = Glyph{
 			.advance = {slot.advance.x >> 6, slot.advance.y >> 6},
 			.extent = slot.pixmap.get_extent(),
 			.left_top = slot.left_top,
 		};
-		auto entry = Entry{.codepoint = codepoint, .glyph = glyph};
-		if (slot.has_pixmap()) { builder.add(static_cast<Pixmap::Atlas::Id>(codepoint), std::move(slot.pixmap)); }
+		add(codepoint, glyph, std::move(slot.pixmap));
+	}
+
+	void add(Codepoint const codepoint, Glyph const& glyph, Pixmap pixmap) {
+		if (!pixmap.is_empty()) { builder.add(static_cast<Pixmap::Atlas::Id>(codepoint), std::move(pixmap)); }
+		entries.push_back(Entry{.codepoint = codepoint, .glyph = glyph});
+	}
+};
 
-		entries.push_back(entry);
+[[nodiscard]] auto make_glyph(BakedFont::Glyph const& in, glm::vec2 const atlas_extent) -> Glyph {
+	return Glyph{
+		.advance = in.advance,
+		.extent = in.extent,
+		.left_top = in.left_top,
+		.uv_rect = {.lt = glm::vec2{in.rect.lt} / atlas_extent, .rb = glm::vec2{in.rect.rb} / atlas_extent},
 	};
+}
+
+[[nodiscard]] auto make_pixmap(BakedFont::Atlas const& atlas, Rect<int> const& rect) -> Pixmap {
+	auto const extent = rect.rb - rect.lt;
+	if (extent.x <= 0 || extent.y <= 0) { return Pixmap{glm::ivec2{}}; }
+	auto const offset = static_cast<std::size_t>(Index2D{rect.lt.x, rect.lt.y}.flatten(atlas.extent.x));
+	if (offset >= atlas.alpha.size()) { return Pixmap{glm::ivec2{}}; }
+	return Pixmap::from_alpha(std::span{atlas.alpha}.subspan(offset), extent, atlas.extent.x);
+}
+} // namespace
 
-	add_codepoint(Codepoint::eTofu);
+FontAtlas::FontAtlas(NotNull<RenderDevice*> render_device, NotNull<GlyphSlot::Factory*> slot_factory, TextHeight const height,
+					 InclusiveRange<Codepoint> const codepoints)
+	: m_page(slot_factory, height) {
+	auto packer = GlyphPacker{height};
+	for_each_codepoint(codepoints, [&](Codepoint const codepoint) { packer.add(codepoint, m_page.slot_for(codepoint)); });
 
-	for (auto codepoint = Codepoint::eAsciiFirst; codepoint != Codepoint::eAsciiLast; codepoint = static_cast<Codepoint>(static_cast<int>(codepoint) + 1)) {
-		add_codepoint(codepoint);
+	auto atlas = packer.builder.build(blank_v);
+	upload(render_device, atlas.pixmap.get_bitmap_view());
+
+	for (auto& entry : packer.entries) {
+		entry.glyph.uv_rect = atlas.uvs[static_cast<Pixmap::Atlas::Id>(entry.codepoint)];
+		m_glyphs.insert_or_assign(entry.codepoint, entry.glyph);
 	}
+}
 
-	auto atlas = builder.build(blank_v);
-	auto bitmap = atlas.pixmap.make_bitmap();
-	auto texture = std::make_shared<Texture>(render_device, bitmap.get_bitmap_view(), true);
-	texture->sampler.mag = Texture::Filter::eLinear;
-	m_texture = std::move(texture);
+FontAtlas::FontAtlas(NotNull<RenderDevice*> render_device, NotNull<GlyphSlot::Factory*> slot_factory, BakedFont::Atlas const& baked, TextHeight const height)
+	: m_page(slot_factory, height) {
+	struct Missing {
+		Codepoint codepoint{};
+		GlyphSlot slot{};
+	};
+
+	// only codepoints in the baked range: glyphs outside it are not expected in the atlas.
+	auto missing = std::vector<Missing>{};
+	for_each_codepoint(baked.codepoints, [&](Codepoint const codepoint) {
+		if (baked.find_glyph(codepoint) != nullptr) { return; }
+		if (auto slot = m_page.slot_for(codepoint)) { missing.push_back(Missing{.codepoint = codepoint, .slot = std::move(slot)}); }
+	});
 
-	for (auto& entry : entries) {
+	if (missing.empty()) {
+		// upload baked pixels as-is: only expand coverage into white Rgba.
+		auto const pixmap = Pixmap::from_alpha(baked.alpha, baked.extent, baked.extent.x);
+		upload(render_device, pixmap.get_bitmap_view());
+
+		auto const atlas_extent = glm::vec2{baked.extent};
+		for (auto const& glyph : baked.glyphs) { m_glyphs.insert_or_assign(glyph.codepoint, make_glyph(glyph, atlas_extent)); }
+		return;
+	}
+
+	// repack baked glyphs along with those rasterized at runtime.
+	auto packer = GlyphPacker{height};
+	for (auto const& glyph : baked.glyphs) { packer.add(glyph.codepoint, make_glyph(glyph, {1.0f, 1.0f}), make_pixmap(baked, glyph.rect)); }
+	for (auto& entry : missing) { packer.add(entry.codepoint, std::move(entry.slot)); }
+
+	auto atlas = packer.builder.build(blank_v);
+	upload(render_device, atlas.pixmap.get_bitmap_view());
+
+	for (auto& entry : packer.entries) {
 		entry.glyph.uv_rect = atlas.uvs[static_cast<Pixmap::Atlas::Id>(entry.codepoint)];
 		m_glyphs.insert_or_assign(entry.codepoint, entry.glyph);
 	}
 }
 
+auto FontAtlas::bake(GlyphSlot::Factory& slot_factory, TextHeight const height, InclusiveRange<Codepoint> const codepoints) -> BakedFont::Atlas {
+	auto page = GlyphPage{&slot_factory, height};
+	auto packer = GlyphPacker{height};
+	for_each_codepoint(codepoints, [&](Codepoint const codepoint) { packer.add(codepoint, page.slot_for(codepoint)); });
+
+	auto const atlas = packer.builder.build(blank_v);
+	auto ret = BakedFont::Atlas{.height = height, .codepoints = codepoints, .extent = atlas.pixmap.get_extent()};
+	ret.alpha = atlas.pixmap.make_alpha();
+
+	auto const atlas_extent = glm::vec2{ret.extent};
+	ret.glyphs.reserve(packer.entries.size());
+	for (auto const& entry : packer.entries) {
+		auto glyph = BakedFont::Glyph{
+			.codepoint = entry.codepoint,
+			.advance = entry.glyph.advance,
+			.extent = entry.glyph.extent,
+			.left_top = entry.glyph.left_top,
+		};
+		if (auto const it = atlas.uvs.find(static_cast<Pixmap::Atlas::Id>(entry.codepoint)); it != atlas.uvs.end()) {
+			glyph.rect.lt = glm::ivec2{glm::round(it->second.lt * atlas_extent)};
+			glyph.rect.rb = glm::ivec2{glm::round(it->second.rb * atlas_extent)};
+		}
+		ret.glyphs.push_back(glyph);
+	}
+	return ret;
+}
+
 auto FontAtlas::glyph_for(Codepoint codepoint) const -> Glyph {
 	if (auto const it = m_glyphs.find(codepoint); it != m_glyphs.end()) { return it->second; }
 	return {};
 }
+
+void FontAtlas::upload(NotNull<RenderDevice*> render_device, BitmapView const bitmap) {
+	auto texture = std::make_shared<Texture>(render_device, bitmap, true);
+	texture->sampler.mag = Texture::Filter::eLinear;
+	texture->update_sampler();
+	m_texture = std::move(texture);
+}
 } // namespace bave::detail
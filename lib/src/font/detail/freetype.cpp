@@ -1,9 +1,20 @@
 #include <src/font/detail/freetype.hpp>
+#include <algorithm>
+#include <cstdlib>
+#include <mutex>
 
 #if defined(BAVE_USE_FREETYPE)
 
 namespace bave::detail {
-void FreetypeGlyphFactory::Deleter::operator()(FT_Face face) const noexcept { FT_Done_Face(face); }
+namespace {
+// creating and destroying faces modifies the FT_Library, which is not thread safe.
+auto g_library_mutex = std::mutex{}; // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+} // namespace
+
+void FreetypeGlyphFactory::Deleter::operator()(FT_Face face) const noexcept {
+	auto lock = std::scoped_lock{g_library_mutex};
+	FT_Done_Face(face);
+}
 
 FreetypeGlyphFactory::FreetypeGlyphFactory(FT_Face face, std::vector<std::byte> bytes) : m_face(face), m_font_bytes(std::move(bytes)) {}
 
@@ -21,14 +32,19 @@ auto FreetypeGlyphFactory::slot_for(Codepoint codepoint) const -> GlyphSlot {
 	if (m_face.get()->glyph == nullptr) { return {}; }
 	auto ret = GlyphSlot{.codepoint = codepoint};
 	auto const& glyph = *m_face.get()->glyph;
-	auto const cols = static_cast<int>(glyph.bitmap.width);
-	ret.pixmap = Pixmap{glm::ivec2{cols, glyph.bitmap.rows}, blank_v};
-	for (int row = 0; row < static_cast<int>(glyph.bitmap.rows); ++row) {
-		for (int col = 0; col < static_cast<int>(glyph.bitmap.width); ++col) {
-			auto const index = Index2D{col, row};
-			// NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
-			ret.pixmap.at(index) = Rgba{.channels = {0xff, 0xff, 0xff, glyph.bitmap.buffer[index.flatten(cols)]}};
+	auto const extent = glm::ivec2{glyph.bitmap.width, glyph.bitmap.rows};
+	if (extent.x > 0 && extent.y > 0 && glyph.bitmap.buffer != nullptr) {
+		auto const stride = std::abs(glyph.bitmap.pitch);
+		auto const alpha = std::span{glyph.bitmap.buffer, static_cast<std::size_t>((extent.y - 1) * stride + extent.x)};
+		ret.pixmap = Pixmap::from_alpha(alpha, extent, stride);
+		// negative pitch: rows are stored bottom-up.
+		if (glyph.bitmap.pitch < 0) {
+			for (int top = 0, bottom = extent.y - 1; top < bottom; ++top, --bottom) {
+				std::ranges::swap_ranges(ret.pixmap.get_row(top), ret.pixmap.get_row(bottom));
+			}
 		}
+	} else {
+		ret.pixmap = Pixmap{extent, blank_v};
 	}
 	ret.left_top = {glyph.bitmap_left, glyph.bitmap_top};
 	ret.advance = {static_cast<int>(m_face.get()->glyph->advance.x), static_cast<int>(m_face.get()->glyph->advance.y)};
@@ -44,6 +60,7 @@ Freetype::Freetype() {
 auto Freetype::load(std::vector<std::byte> bytes) const -> std::unique_ptr<GlyphSlot::Factory> {
 	if (m_lib == nullptr) { return {}; }
 	auto* face = FT_Face{};
+	auto lock = std::scoped_lock{g_library_mutex};
 	// NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
 	if (FT_New_Memory_Face(m_lib, reinterpret_cast<FT_Byte const*>(bytes.data()), static_cast<FT_Long>(bytes.size()), 0, &face) != FT_Err_Ok) { return {}; }
 	return std::make_unique<FreetypeGlyphFactory>(face, std::move(bytes));
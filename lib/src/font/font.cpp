@@ -4,6 +4,13 @@
 #include <algorithm>
 
 namespace bave {
+namespace {
+auto null_slot_factory() -> detail::GlyphSlot::Factory& {
+	static auto ret = detail::GlyphSlot::Factory::Null{};
+	return ret;
+}
+} // namespace
+
 Font::Font(NotNull<RenderDevice*> render_device) : m_render_device(render_device) { create_font_atlas(TextHeight::eDefault); }
 
 auto Font::load_from_bytes(std::vector<std::byte> file_bytes, float scale) -> bool {
@@ -14,6 +21,28 @@ auto Font::load_from_bytes(std::vector<std::byte> file_bytes, float scale) -> bo
 	return true;
 }
 
+auto Font::load_baked(BakedFont baked) -> bool {
+	if (baked.atlases.empty()) { return false; }
+	auto const scale = std::clamp(baked.scale, scale_limit_v.lo, scale_limit_v.hi);
+	if (scale != m_scale) { m_atlases.clear(); }
+	m_codepoints = baked.atlases.front().codepoints;
+	for (auto& atlas : baked.atlases) {
+		m_codepoints.lo = std::min(m_codepoints.lo, atlas.codepoints.lo);
+		m_codepoints.hi = std::max(m_codepoints.hi, atlas.codepoints.hi);
+		auto const height = clamp_text_height(atlas.height);
+		m_atlases.erase(height);
+		m_baked.insert_or_assign(height, std::move(atlas));
+	}
+	m_scale = scale;
+	m_has_baked = true;
+	return true;
+}
+
+auto Font::bake(std::span<TextHeight const> heights, InclusiveRange<Codepoint> const codepoints) const -> BakedFont {
+	if (!m_slot_factory) { return {}; }
+	return BakedFont::bake(*m_slot_factory, heights, codepoints, m_scale);
+}
+
 auto Font::create_font_atlas(TextHeight const height) -> bool { return get_font_atlas(height) != nullptr; }
 
 auto Font::glyph_for(TextHeight height, Codepoint codepoint) -> Glyph {
@@ -35,8 +64,13 @@ auto Font::get_font_atlas(TextHeight height) -> Ptr<detail::FontAtlas const> {
 
 	if (!is_loaded()) { return {}; }
 
+	auto* slot_factory = m_slot_factory ? m_slot_factory.get() : &null_slot_factory();
 	auto const scaled_height = scale_text_height(height, m_scale);
-	auto [it, _] = m_atlases.insert_or_assign(height, detail::FontAtlas{m_render_device, m_slot_factory.get(), scaled_height});
+	if (auto baked = m_baked.extract(height)) {
+		auto [it, _] = m_atlases.insert_or_assign(height, detail::FontAtlas{m_render_device, slot_factory, baked.mapped(), scaled_height});
+		return &it->second;
+	}
+	auto [it, _] = m_atlases.insert_or_assign(height, detail::FontAtlas{m_render_device, slot_factory, scaled_height, m_codepoints});
 	return &it->second;
 }
 
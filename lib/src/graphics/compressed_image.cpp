@@ -0,0 +1,92 @@
+#include <bave/graphics/compressed_image.hpp>
+#include <bave/graphics/detail/render_resource.hpp>
+#include <algorithm>
+#include <array>
+#include <numeric>
+
+namespace bave {
+namespace {
+constexpr auto identifier_v = std::array<std::uint8_t, 12>{0xab, 0x4b, 0x54, 0x58, 0x20, 0x32, 0x30, 0xbb, 0x0d, 0x0a, 0x1a, 0x0a};
+// identifier + header (9 x u32) + index (4 x u32 + 2 x u64).
+constexpr std::size_t level_index_offset_v{80};
+constexpr std::size_t level_entry_size_v{24};
+
+auto read_u32(std::span<std::byte const> bytes, std::size_t const offset) -> std::uint32_t {
+	auto ret = std::uint32_t{};
+	for (std::size_t i = 0; i < 4; ++i) { ret |= static_cast<std::uint32_t>(bytes[offset + i]) << (i * 8); }
+	return ret;
+}
+
+auto read_u64(std::span<std::byte const> bytes, std::size_t const offset) -> std::uint64_t {
+	return static_cast<std::uint64_t>(read_u32(bytes, offset)) | static_cast<std::uint64_t>(read_u32(bytes, offset + 4)) << 32;
+}
+} // namespace
+
+auto CompressedImage::is_ktx2(std::span<std::byte const> bytes) -> bool {
+	if (bytes.size() < identifier_v.size()) { return false; }
+	return std::equal(identifier_v.begin(), identifier_v.end(), bytes.begin(), [](std::uint8_t const a, std::byte const b) { return std::byte{a} == b; });
+}
+
+auto CompressedImage::load_from_ktx2(DataView bytes) -> bool {
+	auto const data = bytes.get_bytes();
+	if (data.size() < level_index_offset_v || !is_ktx2(data)) { return false; }
+
+	auto const format = static_cast<vk::Format>(read_u32(data, 12));
+	auto const width = read_u32(data, 20);
+	auto const height = read_u32(data, 24);
+	auto const depth = read_u32(data, 28);
+	auto const layers = read_u32(data, 32);
+	auto const faces = read_u32(data, 36);
+	auto const level_count = std::max(read_u32(data, 40), 1u);
+	auto const supercompression = read_u32(data, 44);
+
+	// VK_FORMAT_UNDEFINED: Basis Universal payloads need transcoding.
+	if (format == vk::Format::eUndefined || supercompression != 0) { return false; }
+	if (width == 0 || height == 0 || depth > 1 || layers > 1 || faces != 1) { return false; }
+	// more levels than the full mip chain is invalid for a Vulkan image.
+	if (level_count > detail::RenderImage::compute_mip_levels(vk::Extent2D{width, height})) { return false; }
+	if (level_index_offset_v + level_count * level_entry_size_v > data.size()) { return false; }
+	// level sizes cannot be validated for unknown formats.
+	if (detail::get_format_block(format).size == 0) { return false; }
+
+	auto levels = std::vector<Level>{};
+	levels.reserve(level_count);
+	for (std::uint32_t level = 0; level < level_count; ++level) {
+		auto const entry = level_index_offset_v + level * level_entry_size_v;
+		auto const offset = read_u64(data, entry);
+		auto const size = read_u64(data, entry + 8);
+		if (offset > data.size() || size > data.size() - offset) { return false; }
+		auto const extent = vk::Extent2D{std::max(width >> level, 1u), std::max(height >> level, 1u)};
+		// the whole level extent is copied to the image.
+		if (size < detail::compute_level_size(format, extent)) { return false; }
+		levels.push_back(Level{
+			.bytes = data.subspan(static_cast<std::size_t>(offset), static_cast<std::size_t>(size)),
+			.extent = detail::to_glm_vec<int>(extent),
+		});
+	}
+
+	m_bytes = std::move(bytes);
+	m_format = format;
+	m_levels = std::move(levels);
+	return true;
+}
+
+auto CompressedImage::get_size() const -> std::size_t {
+	return std::accumulate(m_levels.begin(), m_levels.end(), std::size_t{}, [](std::size_t const sum, Level const& level) { return sum + level.bytes.size(); });
+}
+
+auto CompressedImage::is_block_compressed() const -> bool {
+	// BC1 - BC7, ETC2 / EAC, ASTC LDR are contiguous ranges in VkFormat.
+	auto const value = static_cast<int>(m_format);
+	auto const in_range = [value](vk::Format const first, vk::Format const last) { return value >= static_cast<int>(first) && value <= static_cast<int>(last); };
+	return in_range(vk::Format::eBc1RgbUnormBlock, vk::Format::eAstc12x12SrgbBlock);
+}
+
+auto CompressedImage::get_rgba_bitmap() const -> BitmapView {
+	if (m_levels.empty()) { return {}; }
+	if (m_format != vk::Format::eR8G8B8A8Srgb && m_format != vk::Format::eR8G8B8A8Unorm) { return {}; }
+	auto const& level = m_levels.front();
+	if (level.bytes.size() != static_cast<std::size_t>(level.extent.x * level.extent.y * 4)) { return {}; }
+	return BitmapView{.bytes = level.bytes, .extent = level.extent};
+}
+} // namespace bave
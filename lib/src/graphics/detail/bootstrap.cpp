@@ -98,7 +98,7 @@ auto get_ranked_gpus(vk::Instance const instance, vk::SurfaceKHR const surface)
 		auto const properties = device.getQueueFamilyProperties();
 		for (size_t i = 0; i < properties.size(); ++i) {
 			auto const family = static_cast<std::uint32_t>(i);
-			if (device.getSurfaceSupportKHR(family, surface) == 0) { continue; }
+			if (surface && device.getSurfaceSupportKHR(family, surface) == 0) { continue; }
 			if (!(properties[i].queueFlags & queue_flags_v)) { continue; }
 			out_family = family;
 			return true;
@@ -123,7 +123,7 @@ auto get_ranked_gpus(vk::Instance const instance, vk::SurfaceKHR const surface)
 	return ret;
 }
 
-auto make_device(Gpu const& gpu) -> vk::UniqueDevice {
+auto make_device(Gpu const& gpu, bool const swapchain) -> vk::UniqueDevice {
 	static constexpr float priority_v = 1.0f;
 	static constexpr std::array required_extensions_v = {
 		VK_KHR_SWAPCHAIN_EXTENSION_NAME,
@@ -131,6 +131,8 @@ auto make_device(Gpu const& gpu) -> vk::UniqueDevice {
 		VK_KHR_PORTABILITY_SUBSET_EXTENSION_NAME
 #endif
 	};
+	// headless devices don't need (and software rasterizers may not support) VK_KHR_swapchain.
+	auto const required_extensions = std::span{required_extensions_v}.subspan(swapchain ? 0 : 1);
 
 	auto qci = vk::DeviceQueueCreateInfo{{}, gpu.queue_family, 1, &priority_v};
 	auto dci = vk::DeviceCreateInfo{};
@@ -141,7 +143,7 @@ auto make_device(Gpu const& gpu) -> vk::UniqueDevice {
 	enabled.samplerAnisotropy = available_features.samplerAnisotropy;
 	enabled.sampleRateShading = available_features.sampleRateShading;
 	auto const available_extensions = gpu.device.enumerateDeviceExtensionProperties();
-	for (auto const* ext : required_extensions_v) {
+	for (auto const* ext : required_extensions) {
 		auto const found = [ext](vk::ExtensionProperties const& props) { return std::string_view{props.extensionName} == ext; };
 		if (std::find_if(available_extensions.begin(), available_extensions.end(), found) == available_extensions.end()) {
 			throw Error{"Required extension '{}' not supported by selected GPU '{}'", ext, gpu.properties.deviceName.data()};
@@ -150,8 +152,8 @@ auto make_device(Gpu const& gpu) -> vk::UniqueDevice {
 
 	dci.queueCreateInfoCount = 1;
 	dci.pQueueCreateInfos = &qci;
-	dci.enabledExtensionCount = static_cast<std::uint32_t>(required_extensions_v.size());
-	dci.ppEnabledExtensionNames = required_extensions_v.data();
+	dci.enabledExtensionCount = static_cast<std::uint32_t>(required_extensions.size());
+	dci.ppEnabledExtensionNames = required_extensions.data();
 	dci.pEnabledFeatures = &enabled;
 
 	auto ret = gpu.device.createDeviceUnique(dci);
@@ -169,7 +171,7 @@ auto InstanceBuilder::build() -> Result {
 }
 
 DeviceBuilder::DeviceBuilder(vk::Instance instance, vk::SurfaceKHR surface) : m_instance(instance), m_surface(surface) {
-	if (!m_instance || !m_surface) { throw Error{"Uninitialized Vulkan Instance/Surface"}; }
+	if (!m_instance) { throw Error{"Uninitialized Vulkan Instance"}; }
 	m_gpus = get_ranked_gpus(m_instance, m_surface);
 	if (m_gpus.empty()) { throw Error{"No suitable Vulkan GPU found"}; }
 	gpu = m_gpus.front();
@@ -177,7 +179,7 @@ DeviceBuilder::DeviceBuilder(vk::Instance instance, vk::SurfaceKHR surface) : m_
 
 auto DeviceBuilder::build() const -> Result {
 	if (!gpu.device) { throw Error{"Uninitialized GPU"}; }
-	auto ret = Result{.device = make_device(gpu)};
+	auto ret = Result{.device = make_device(gpu, !!m_surface)};
 	ret.queue = ret.device->getQueue(gpu.queue_family, 0);
 	return ret;
 }
@@ -25,6 +25,9 @@ class DeviceBuilder {
 		vk::Queue queue{};
 	};
 
+	/// \brief Constructor.
+	/// \param instance Vulkan Instance.
+	/// \param surface Surface to present to, null for a headless device.
 	explicit DeviceBuilder(vk::Instance instance, vk::SurfaceKHR surface);
 
 	Gpu gpu{};
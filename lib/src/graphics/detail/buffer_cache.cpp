@@ -37,6 +37,7 @@ BufferCache::BufferCache(NotNull<RenderDevice*> render_device) : m_render_device
 
 auto BufferCache::allocate(BufferType const type) -> RenderBuffer& {
 	auto const index = static_cast<std::size_t>(type);
+	auto lock = std::scoped_lock{m_mutex};
 	auto& pool = m_maps.at(m_render_device->get_frame_index()).at(index);
 	if (pool.next >= pool.buffers.size()) {
 		pool.buffers.emplace_back(m_render_device, to_usage(type));
@@ -50,9 +51,22 @@ auto BufferCache::allocate(BufferType const type) -> RenderBuffer& {
 	return pool.buffers[pool.next++];
 }
 
+auto BufferCache::buffer_count() const -> std::size_t {
+	auto lock = std::scoped_lock{m_mutex};
+	auto ret = std::size_t{};
+	for (auto const& map : m_maps) {
+		for (auto const& pool : map) { ret += pool.buffers.size(); }
+	}
+	return ret;
+}
+
 auto BufferCache::next_frame() -> void {
+	auto lock = std::scoped_lock{m_mutex};
 	for (auto& pool : m_maps.at(m_render_device->get_frame_index())) { pool.next = {}; }
 }
 
-auto BufferCache::clear() -> void { m_maps = {}; }
+auto BufferCache::clear() -> void {
+	auto lock = std::scoped_lock{m_mutex};
+	m_maps = {};
+}
 } // namespace bave::detail
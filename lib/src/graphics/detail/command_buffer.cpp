@@ -1,24 +1,198 @@
 #include <bave/core/error.hpp>
 #include <bave/graphics/detail/command_buffer.hpp>
 #include <bave/graphics/render_device.hpp>
+#include <algorithm>
+#include <iterator>
+#include <limits>
+#include <utility>
 
 namespace bave::detail {
-CommandBuffer::CommandBuffer(RenderDevice const& render_device)
-	: m_pool(render_device.get_device().createCommandPoolUnique({vk::CommandPoolCreateFlagBits::eTransient})) {
-	auto const cbai = vk::CommandBufferAllocateInfo{*m_pool, vk::CommandBufferLevel::ePrimary, 1};
-	if (render_device.get_device().allocateCommandBuffers(&cbai, &m_cb) != vk::Result::eSuccess) { throw Error{"Failed to allocate Vulkan Command Buffer"}; }
-	m_cb.begin({vk::CommandBufferUsageFlagBits::eOneTimeSubmit});
+CommandPools::Pool::Pool(vk::Device device, std::uint32_t queue_family) : m_device(device) {
+	static constexpr auto flags_v = vk::CommandPoolCreateFlagBits::eTransient | vk::CommandPoolCreateFlagBits::eResetCommandBuffer;
+	m_pool = m_device.createCommandPoolUnique(vk::CommandPoolCreateInfo{flags_v, queue_family});
 }
 
-auto CommandBuffer::submit(RenderDevice& render_device) -> void {
-	if (!m_cb) { return; }
-	m_cb.end();
+CommandPools::Pool::~Pool() {
+	auto fences = std::vector<vk::Fence>{};
+	for (auto const& submission : m_in_flight) {
+		if (!submission.complete) { fences.push_back(*submission.fence); }
+	}
+	if (fences.empty()) { return; }
+	[[maybe_unused]] auto const result = m_device.waitForFences(fences, vk::True, std::numeric_limits<std::uint64_t>::max());
+}
+
+auto CommandPools::Pool::acquire() -> vk::CommandBuffer {
+	// resources of completed submissions are released here.
+	poll(true);
+
+	auto ret = vk::CommandBuffer{};
+	if (!m_free_cbs.empty()) {
+		ret = m_free_cbs.back();
+		m_free_cbs.pop_back();
+	} else {
+		auto const cbai = vk::CommandBufferAllocateInfo{*m_pool, vk::CommandBufferLevel::ePrimary, 1};
+		if (m_device.allocateCommandBuffers(&cbai, &ret) != vk::Result::eSuccess) { throw Error{"Failed to allocate Vulkan Command Buffer"}; }
+	}
+	// implicitly resets recycled command buffers.
+	ret.begin({vk::CommandBufferUsageFlagBits::eOneTimeSubmit});
+	return ret;
+}
+
+void CommandPools::Pool::release(vk::CommandBuffer cb) {
+	// recording command buffers cannot be begun again without an explicit reset.
+	cb.reset({});
+	m_free_cbs.push_back(cb);
+}
+
+auto CommandPools::Pool::submit(RenderDevice& render_device, vk::CommandBuffer cb, std::vector<Resource> resources, bool const wait) -> bool {
+	cb.end();
+	auto fence = acquire_fence();
 	auto vsi = vk::SubmitInfo{};
 	vsi.commandBufferCount = 1;
-	vsi.pCommandBuffers = &m_cb;
-	auto fence = render_device.get_device().createFenceUnique({});
-	render_device.queue_submit(vsi, *fence);
-	render_device.wait_for(*fence);
-	m_cb = vk::CommandBuffer{};
+	vsi.pCommandBuffers = &cb;
+	if (!render_device.queue_submit(vsi, *fence)) {
+		recycle(cb, std::move(fence));
+		return false;
+	}
+
+	if (wait) {
+		render_device.wait_for(*fence);
+		m_device.resetFences(*fence);
+		recycle(cb, std::move(fence));
+		return true;
+	}
+
+	auto lock = std::scoped_lock{m_mutex};
+	m_in_flight.push_back(Submission{.cb = cb, .fence = std::move(fence), .resources = std::move(resources)});
+	return true;
+}
+
+auto CommandPools::Pool::poll(bool const recycle) -> std::vector<Resource> {
+	auto ret = std::vector<Resource>{};
+	auto completed = std::vector<Submission>{};
+	{
+		auto lock = std::scoped_lock{m_mutex};
+		for (auto& submission : m_in_flight) {
+			if (!submission.complete && m_device.getFenceStatus(*submission.fence) == vk::Result::eSuccess) { submission.complete = true; }
+			if (!submission.complete) { continue; }
+			std::move(submission.resources.begin(), submission.resources.end(), std::back_inserter(ret));
+			submission.resources.clear();
+		}
+		if (recycle) {
+			// only the owning thread may touch command buffers (and reset fences).
+			auto const it = std::stable_partition(m_in_flight.begin(), m_in_flight.end(), [](Submission const& s) { return !s.complete; });
+			std::move(it, m_in_flight.end(), std::back_inserter(completed));
+			m_in_flight.erase(it, m_in_flight.end());
+		}
+	}
+	for (auto& submission : completed) {
+		m_device.resetFences(*submission.fence);
+		this->recycle(submission.cb, std::move(submission.fence));
+	}
+	return ret;
+}
+
+auto CommandPools::Pool::acquire_fence() -> vk::UniqueFence {
+	if (m_free_fences.empty()) { return m_device.createFenceUnique({}); }
+	auto ret = std::move(m_free_fences.back());
+	m_free_fences.pop_back();
+	return ret;
+}
+
+void CommandPools::Pool::recycle(vk::CommandBuffer cb, vk::UniqueFence fence) {
+	m_free_cbs.push_back(cb);
+	m_free_fences.push_back(std::move(fence));
+}
+
+// releases the exiting thread's pools (of CommandPools that are still alive).
+struct CommandPools::ThreadExit {
+	std::vector<std::weak_ptr<Shared>> shared{};
+
+	ThreadExit() = default;
+	ThreadExit(ThreadExit const&) = delete;
+	ThreadExit(ThreadExit&&) = delete;
+	auto operator=(ThreadExit const&) -> ThreadExit& = delete;
+	auto operator=(ThreadExit&&) -> ThreadExit& = delete;
+
+	~ThreadExit() {
+		auto const thread = std::this_thread::get_id();
+		for (auto const& weak : shared) {
+			if (auto const locked = weak.lock()) { release(*locked, thread); }
+		}
+	}
+};
+
+CommandPools::CommandPools(vk::Device device, std::uint32_t queue_family) : m_device(device), m_queue_family(queue_family) {}
+
+CommandPools::~CommandPools() {
+	// threads exiting later may still hold m_shared: destroy pools now, while the device is alive.
+	auto lock = std::unique_lock{m_shared->mutex};
+	m_shared->pools.clear();
+}
+
+auto CommandPools::get() -> Pool& {
+	auto const thread = std::this_thread::get_id();
+	{
+		auto lock = std::shared_lock{m_shared->mutex};
+		if (auto const it = m_shared->pools.find(thread); it != m_shared->pools.end()) { return *it->second; }
+	}
+	thread_local auto t_exit = ThreadExit{};
+	std::erase_if(t_exit.shared, [](std::weak_ptr<Shared> const& weak) { return weak.expired(); });
+	t_exit.shared.emplace_back(m_shared);
+
+	auto pool = std::make_unique<Pool>(m_device, m_queue_family);
+	auto lock = std::unique_lock{m_shared->mutex};
+	auto const [it, _] = m_shared->pools.try_emplace(thread, std::move(pool));
+	return *it->second;
+}
+
+void CommandPools::release_thread() { release(*m_shared, std::this_thread::get_id()); }
+
+void CommandPools::release(Shared& shared, std::thread::id const thread) {
+	// the pool is destroyed under the lock: ~CommandPools (and the device) cannot complete meanwhile.
+	auto lock = std::unique_lock{shared.mutex};
+	shared.pools.erase(thread);
+}
+
+auto CommandPools::pool_count() const -> std::size_t {
+	auto lock = std::shared_lock{m_shared->mutex};
+	return m_shared->pools.size();
+}
+
+auto CommandPools::in_flight_count() const -> std::size_t {
+	auto lock = std::shared_lock{m_shared->mutex};
+	auto ret = std::size_t{};
+	for (auto const& [_, pool] : m_shared->pools) {
+		auto pool_lock = std::scoped_lock{pool->m_mutex};
+		ret += static_cast<std::size_t>(std::count_if(pool->m_in_flight.begin(), pool->m_in_flight.end(), [](auto const& s) { return !s.complete; }));
+	}
+	return ret;
+}
+
+void CommandPools::next_frame() {
+	auto released = std::vector<Resource>{};
+	{
+		auto lock = std::shared_lock{m_shared->mutex};
+		for (auto const& [_, pool] : m_shared->pools) { std::ranges::move(pool->poll(false), std::back_inserter(released)); }
+	}
+	// resources of other threads' submissions are destroyed on this thread, outside the lock.
+	released.clear();
+}
+
+CommandBuffer::CommandBuffer(RenderDevice const& render_device) : m_pool(&render_device.get_command_pools().get()), m_cb(m_pool->acquire()) {}
+
+CommandBuffer::~CommandBuffer() {
+	if (!m_cb) { return; }
+	m_pool->release(m_cb);
+}
+
+auto CommandBuffer::submit(RenderDevice& render_device) -> void { do_submit(render_device, true); }
+
+auto CommandBuffer::submit_deferred(RenderDevice& render_device) -> void { do_submit(render_device, false); }
+
+void CommandBuffer::do_submit(RenderDevice& render_device, bool const wait) {
+	if (!m_cb) { return; }
+	auto const cb = std::exchange(m_cb, vk::CommandBuffer{});
+	m_pool->submit(render_device, cb, std::move(m_resources), wait);
 }
 } // namespace bave::detail
@@ -0,0 +1,103 @@
+#include <bave/graphics/detail/gpu_profiler.hpp>
+#include <algorithm>
+
+namespace bave::detail {
+namespace {
+constexpr auto query_stride_v = 2 * sizeof(std::uint64_t);
+
+auto make_query_pool(vk::Device device) -> vk::UniqueQueryPool {
+	auto qpci = vk::QueryPoolCreateInfo{};
+	qpci.queryType = vk::QueryType::eTimestamp;
+	qpci.queryCount = GpuProfiler::max_queries_v;
+	return device.createQueryPoolUnique(qpci);
+}
+} // namespace
+
+GpuProfiler::GpuProfiler(NotNull<RenderDevice const*> render_device) : m_render_device(render_device) {
+	auto const& gpu = m_render_device->get_gpu();
+	auto const queue_families = gpu.device.getQueueFamilyProperties();
+	auto const valid_bits = gpu.queue_family < queue_families.size() ? queue_families[gpu.queue_family].timestampValidBits : 0u;
+	if (valid_bits == 0 || gpu.properties.limits.timestampPeriod <= 0.0f) { return; }
+
+	m_period = gpu.properties.limits.timestampPeriod;
+	m_mask = valid_bits >= 64 ? ~std::uint64_t{} : (std::uint64_t{1} << valid_bits) - 1;
+	for (auto& slot : m_slots) { slot.pool = make_query_pool(m_render_device->get_device()); }
+	m_results.resize(2 * max_queries_v);
+}
+
+void GpuProfiler::begin_frame(vk::CommandBuffer const command_buffer) {
+	if (!is_supported()) { return; }
+
+	auto& slot = m_slots.at(m_render_device->get_frame_index());
+	if (slot.recording) { resolve(slot); }
+
+	slot.recording = Profiler::self().is_enabled();
+	if (!slot.recording) { return; }
+
+	command_buffer.resetQueryPool(*slot.pool, 0, max_queries_v);
+	slot.pending.clear();
+	slot.next_query = 0;
+	slot.depth = 0;
+	slot.profiler_frame = Profiler::self().get_frame_index();
+}
+
+auto GpuProfiler::begin_scope(vk::CommandBuffer const command_buffer, std::string_view const name) -> std::optional<Scope> {
+	if (!is_supported()) { return {}; }
+	auto& slot = m_slots.at(m_render_device->get_frame_index());
+	if (!slot.recording || slot.next_query + 2 > max_queries_v) { return {}; }
+
+	auto const ret = static_cast<Scope>(slot.pending.size());
+	command_buffer.writeTimestamp(vk::PipelineStageFlagBits::eTopOfPipe, *slot.pool, slot.next_query);
+	slot.pending.push_back(Pending{.name = name, .query = slot.next_query, .depth = slot.depth++});
+	slot.next_query += 2;
+	return ret;
+}
+
+void GpuProfiler::end_scope(vk::CommandBuffer const command_buffer, std::optional<Scope> const scope) {
+	if (!scope) { return; }
+	auto& slot = m_slots.at(m_render_device->get_frame_index());
+	if (!slot.recording || *scope >= slot.pending.size()) { return; }
+
+	--slot.depth;
+	command_buffer.writeTimestamp(vk::PipelineStageFlagBits::eBottomOfPipe, *slot.pool, slot.pending[*scope].query + 1);
+}
+
+void GpuProfiler::resolve(Slot& slot) {
+	slot.recording = false;
+	if (slot.next_query == 0) { return; }
+
+	// the frame's fence has been waited on: results are either available or were never written.
+	static constexpr auto flags_v = vk::QueryResultFlagBits::e64 | vk::QueryResultFlagBits::eWithAvailability;
+	auto const result = m_render_device->get_device().getQueryPoolResults(*slot.pool, 0, slot.next_query, slot.next_query * query_stride_v, m_results.data(),
+																		   query_stride_v, flags_v);
+	if (result != vk::Result::eSuccess && result != vk::Result::eNotReady) { return; }
+
+	auto const value = [&](std::uint32_t const query) { return m_results[2 * query] & m_mask; };
+	auto const available = [&](std::uint32_t const query) { return m_results[2 * query + 1] != 0; };
+	auto const to_ns = [&](std::uint64_t const ticks) {
+		return std::chrono::nanoseconds{static_cast<std::int64_t>(static_cast<double>(ticks) * static_cast<double>(m_period))};
+	};
+
+	auto origin = std::optional<std::uint64_t>{};
+	for (auto const& pending : slot.pending) {
+		if (!available(pending.query)) { continue; }
+		origin = origin ? std::min(*origin, value(pending.query)) : value(pending.query);
+	}
+	if (!origin) { return; }
+
+	m_samples.clear();
+	for (auto const& pending : slot.pending) {
+		if (!available(pending.query) || !available(pending.query + 1)) { continue; }
+		auto const begin = value(pending.query);
+		auto const end = value(pending.query + 1);
+		m_samples.push_back(Profiler::GpuSample{
+			.name = pending.name,
+			.offset = to_ns((begin - *origin) & m_mask),
+			.duration = to_ns((end - begin) & m_mask),
+			.depth = pending.depth,
+		});
+	}
+
+	Profiler::self().add_gpu_samples(slot.profiler_frame, m_samples);
+}
+} // namespace bave::detail
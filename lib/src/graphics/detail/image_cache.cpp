@@ -1,31 +1,161 @@
+#include <bave/core/hash_combine.hpp>
 #include <bave/graphics/detail/image_cache.hpp>
 #include <bave/graphics/render_device.hpp>
+#include <algorithm>
+#include <iterator>
+#include <utility>
 
 namespace bave::detail {
+auto ImageCache::Hasher::operator()(Key const& key) const -> std::size_t {
+	return make_combined_hash(key.format, static_cast<VkImageUsageFlags>(key.usage), key.aspect, key.tiling, key.layout, key.samples, key.view_type,
+							  key.extent.width, key.extent.height, key.mip_levels, key.mip_map, key.lazily_allocated);
+}
+
+void ImageCache::Recycler::operator()(RenderImage* image) const {
+	auto owned = std::unique_ptr<RenderImage>{image};
+	auto pool = this->pool.lock();
+	// cache has been destroyed: owned image is destroyed here.
+	if (!pool) { return; }
+
+	auto const size = owned->get_render_device().get_device().getImageMemoryRequirements(owned->get_image()).size;
+	auto const key = make_key(*owned);
+	auto lock = std::scoped_lock{pool->mutex};
+	pool->buckets[key].push_back(Entry{.image = std::move(owned), .size = size, .released = pool->frame});
+	++pool->free_count;
+	pool->free_bytes += size;
+}
+
+ImageCache::ImageCache(NotNull<RenderDevice*> render_device) : m_render_device(render_device) {}
+
 auto ImageCache::allocate(RenderImage::CreateInfo const& create_info, vk::Extent2D extent) -> std::shared_ptr<RenderImage> {
-	auto lock = std::scoped_lock{m_mutex};
-	for (auto const& image : m_images) {
-		if (image.use_count() == 1) {
-			*image = RenderImage{m_render_device, create_info, extent};
-			return image;
+	extent.width = std::max(extent.width, 1u);
+	extent.height = std::max(extent.height, 1u);
+	auto const key = make_key(create_info, extent);
+	auto reused = std::unique_ptr<RenderImage>{};
+	{
+		auto lock = std::scoped_lock{m_pool->mutex};
+		if (auto it = m_pool->buckets.find(key); it != m_pool->buckets.end() && !it->second.empty()) {
+			// most recently released: most likely to still be resident.
+			auto& entry = it->second.back();
+			reused = std::move(entry.image);
+			--m_pool->free_count;
+			m_pool->free_bytes -= entry.size;
+			it->second.pop_back();
 		}
 	}
+	if (reused) { return make_recycled(std::move(reused)); }
+
+	auto ret = make_recycled(std::make_unique<RenderImage>(m_render_device, create_info, extent));
+	m_log.debug("new Vulkan Image created (total: {})", ++m_pool->image_count);
+	return ret;
+}
 
-	m_images.push_back(std::make_shared<RenderImage>(m_render_device, create_info, extent));
-	m_log.debug("new Vulkan Image created (total: {})", m_images.size());
+auto ImageCache::get_trim_policy() const -> TrimPolicy {
+	auto lock = std::scoped_lock{m_pool->mutex};
+	return m_pool->policy;
+}
 
-	return m_images.back();
+void ImageCache::set_trim_policy(TrimPolicy const& policy) {
+	auto lock = std::scoped_lock{m_pool->mutex};
+	m_pool->policy = policy;
 }
 
-auto ImageCache::image_count() const -> std::size_t {
-	auto lock = std::scoped_lock{m_mutex};
-	return m_images.size();
+auto ImageCache::image_count() const -> std::size_t { return m_pool->image_count; }
+
+auto ImageCache::free_count() const -> std::size_t {
+	auto lock = std::scoped_lock{m_pool->mutex};
+	return m_pool->free_count;
+}
+
+auto ImageCache::next_frame() -> void {
+	auto evicted = std::vector<std::unique_ptr<RenderImage>>{};
+	{
+		auto lock = std::scoped_lock{m_pool->mutex};
+		auto& pool = *m_pool;
+		++pool.frame;
+		if (pool.free_count == 0) { return; }
+
+		auto const& policy = pool.policy;
+		for (auto it = pool.buckets.begin(); it != pool.buckets.end();) {
+			// entries are in release order: idle ones are at the front.
+			auto& entries = it->second;
+			auto const is_active = [&](Entry const& entry) { return pool.frame - entry.released <= policy.max_idle_frames; };
+			auto const idle_end = std::find_if(entries.begin(), entries.end(), is_active);
+			for (auto entry = entries.begin(); entry != idle_end; ++entry) {
+				--pool.free_count;
+				pool.free_bytes -= entry->size;
+				evicted.push_back(std::move(entry->image));
+			}
+			entries.erase(entries.begin(), idle_end);
+			it = entries.empty() ? pool.buckets.erase(it) : std::next(it);
+		}
+
+		while (pool.free_count > policy.max_free_images || pool.free_bytes > policy.max_free_bytes) { evicted.push_back(evict_oldest(pool)); }
+	}
+
+	if (evicted.empty()) { return; }
+	m_pool->image_count -= evicted.size();
+	m_log.debug("{} free Vulkan Images trimmed (total: {})", evicted.size(), m_pool->image_count.load());
+}
+
+auto ImageCache::trim() -> void {
+	auto buckets = std::unordered_map<Key, std::vector<Entry>, Hasher>{};
+	auto count = std::size_t{};
+	{
+		auto lock = std::scoped_lock{m_pool->mutex};
+		std::swap(buckets, m_pool->buckets);
+		count = std::exchange(m_pool->free_count, 0);
+		m_pool->free_bytes = 0;
+	}
+
+	if (count == 0) { return; }
+	m_pool->image_count -= count;
+	m_log.debug("{} free Vulkan Images destroyed", count);
 }
 
 auto ImageCache::clear() -> void {
 	m_render_device->get_device().waitIdle();
-	auto lock = std::scoped_lock{m_mutex};
-	m_log.debug("{} Vulkan Images destroyed", m_images.size());
-	m_images.clear();
+	trim();
+}
+
+auto ImageCache::make_key(RenderImage::CreateInfo const& create_info, vk::Extent2D const extent) -> Key {
+	return Key{
+		.format = create_info.format,
+		.usage = create_info.usage,
+		.aspect = create_info.aspect,
+		.tiling = create_info.tiling,
+		.layout = create_info.layout,
+		.samples = create_info.samples,
+		.view_type = create_info.view_type,
+		.extent = extent,
+		.mip_levels = RenderImage::compute_mip_levels(create_info, extent),
+		.mip_map = create_info.mip_map,
+		.lazily_allocated = create_info.lazily_allocated,
+	};
+}
+
+auto ImageCache::make_key(RenderImage const& image) -> Key {
+	auto ret = make_key(image.get_create_info(), image.get_extent());
+	ret.mip_levels = image.get_mip_levels();
+	return ret;
+}
+
+auto ImageCache::make_recycled(std::unique_ptr<RenderImage> image) -> std::shared_ptr<RenderImage> {
+	return std::shared_ptr<RenderImage>{image.release(), Recycler{.pool = m_pool}};
+}
+
+auto ImageCache::evict_oldest(Pool& pool) -> std::unique_ptr<RenderImage> {
+	auto oldest = pool.buckets.end();
+	for (auto it = pool.buckets.begin(); it != pool.buckets.end(); ++it) {
+		if (oldest == pool.buckets.end() || it->second.front().released < oldest->second.front().released) { oldest = it; }
+	}
+
+	auto& entries = oldest->second;
+	auto ret = std::move(entries.front());
+	entries.erase(entries.begin());
+	if (entries.empty()) { pool.buckets.erase(oldest); }
+	--pool.free_count;
+	pool.free_bytes -= ret.size;
+	return std::move(ret.image);
 }
 } // namespace bave::detail
@@ -0,0 +1,210 @@
+#include <bave/core/is_positive.hpp>
+#include <bave/graphics/detail/command_buffer.hpp>
+#include <bave/graphics/detail/image_uploader.hpp>
+#include <bave/graphics/render_device.hpp>
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstring>
+
+namespace bave::detail {
+namespace {
+constexpr std::size_t channels_v{4};
+
+auto to_linear(std::byte const srgb) -> float {
+	static auto const lut = [] {
+		auto ret = std::array<float, 256>{};
+		for (std::size_t i = 0; i < ret.size(); ++i) {
+			auto const c = static_cast<float>(i) / 255.0f;
+			ret.at(i) = c <= 0.04045f ? c / 12.92f : std::pow((c + 0.055f) / 1.055f, 2.4f);
+		}
+		return ret;
+	}();
+	return lut.at(std::to_integer<std::size_t>(srgb));
+}
+
+auto to_srgb(float const linear) -> std::byte {
+	auto const c = linear <= 0.0031308f ? linear * 12.92f : 1.055f * std::pow(linear, 1.0f / 2.4f) - 0.055f;
+	return static_cast<std::byte>(std::clamp(std::lround(c * 255.0f), 0l, 255l));
+}
+
+// 2x2 box filter of an 8-bit, 4 channel level, colour averaged in linear space if srgb (alpha is always linear).
+auto downsample(std::span<std::byte const> src, vk::Extent2D const src_extent, bool const srgb) -> std::vector<std::byte> {
+	auto const dst_extent = vk::Extent2D{std::max(src_extent.width / 2, 1u), std::max(src_extent.height / 2, 1u)};
+	auto ret = std::vector<std::byte>(std::size_t{dst_extent.width} * dst_extent.height * channels_v);
+	auto const texel = [&](std::uint32_t const x, std::uint32_t const y) {
+		return (std::size_t{std::min(y, src_extent.height - 1)} * src_extent.width + std::min(x, src_extent.width - 1)) * channels_v;
+	};
+	for (std::uint32_t y = 0; y < dst_extent.height; ++y) {
+		for (std::uint32_t x = 0; x < dst_extent.width; ++x) {
+			auto const texels = std::array{texel(2 * x, 2 * y), texel(2 * x + 1, 2 * y), texel(2 * x, 2 * y + 1), texel(2 * x + 1, 2 * y + 1)};
+			auto const out = (std::size_t{y} * dst_extent.width + x) * channels_v;
+			for (std::size_t channel = 0; channel < channels_v; ++channel) {
+				auto const gamma = srgb && channel < 3;
+				auto sum = 0.0f;
+				for (auto const t : texels) {
+					auto const value = src[t + channel];
+					sum += gamma ? to_linear(value) : static_cast<float>(std::to_integer<int>(value)) / 255.0f;
+				}
+				auto const average = sum / static_cast<float>(texels.size());
+				ret[out + channel] = gamma ? to_srgb(average) : static_cast<std::byte>(std::lround(average * 255.0f));
+			}
+		}
+	}
+	return ret;
+}
+
+auto make_barrier(RenderImage const& image, vk::ImageLayout const from, vk::ImageLayout const to, std::uint32_t const base_level,
+				  std::uint32_t const level_count) -> vk::ImageMemoryBarrier {
+	auto ret = vk::ImageMemoryBarrier{};
+	ret.image = image.get_image();
+	ret.oldLayout = from;
+	ret.newLayout = to;
+	ret.srcAccessMask = ret.dstAccessMask = vk::AccessFlagBits::eMemoryRead | vk::AccessFlagBits::eMemoryWrite;
+	ret.subresourceRange = vk::ImageSubresourceRange{vk::ImageAspectFlagBits::eColor, base_level, level_count, 0, 1};
+	return ret;
+}
+
+auto level_offset(vk::Extent2D const extent, std::uint32_t const level) -> vk::Offset3D {
+	return {static_cast<std::int32_t>(std::max(extent.width >> level, 1u)), static_cast<std::int32_t>(std::max(extent.height >> level, 1u)), 1};
+}
+} // namespace
+
+ImageUploader::~ImageUploader() {
+	try {
+		submit();
+	} catch (std::exception const& e) { m_log.error("failed to submit {} staged upload(s): {}", m_uploads.size(), e.what()); }
+}
+
+auto ImageUploader::upload(RenderImage& image, BitmapView const bitmap, glm::ivec2 const top_left) -> bool {
+	if (image.get_view_type() == vk::ImageViewType::eCube || !is_positive(bitmap.extent)) { return false; }
+	auto const image_extent = to_glm_vec<int>(image.get_extent());
+	auto const write_extent = bitmap.extent + top_left;
+	if (top_left.x < 0 || top_left.y < 0 || write_extent.x > image_extent.x || write_extent.y > image_extent.y) { return false; }
+
+	// barriers of a batch assume each image is written at most once.
+	auto const is_target = [&image](Upload const& upload) { return upload.image == &image; };
+	if (std::any_of(m_uploads.begin(), m_uploads.end(), is_target)) { submit(); }
+
+	auto const full = top_left == glm::ivec2{} && bitmap.extent == image_extent;
+	auto const format = image.get_format();
+	auto const mip_levels = image.get_mip_levels();
+	auto upload = Upload{
+		.image = &image,
+		.initial_layout = full ? vk::ImageLayout::eUndefined : image.get_layout(),
+		.blit_mips = mip_levels > 1,
+	};
+
+	auto levels = std::vector<std::vector<std::byte>>{};
+	if (upload.blit_mips && !m_render_device->is_linear_filter_supported(format)) {
+		if (full && (is_rgba(format) || is_bgra(format)) && bitmap.bytes.size() == static_cast<std::size_t>(bitmap.extent.x * bitmap.extent.y) * channels_v) {
+			levels.reserve(mip_levels - 1);
+			auto src = bitmap.bytes;
+			auto extent = image.get_extent();
+			for (std::uint32_t level = 1; level < mip_levels; ++level) {
+				levels.push_back(downsample(src, extent, is_srgb(format)));
+				src = levels.back();
+				extent = vk::Extent2D{std::max(extent.width / 2, 1u), std::max(extent.height / 2, 1u)};
+			}
+			upload.blit_mips = false;
+		} else {
+			upload.filter = vk::Filter::eNearest;
+		}
+	}
+
+	auto size = bitmap.bytes.size();
+	for (auto const& level : levels) { size += level.size(); }
+	upload.staging = std::make_shared<RenderBuffer>(m_render_device, vk::BufferUsageFlagBits::eTransferSrc | vk::BufferUsageFlagBits::eTransferDst, size);
+	auto* mapped = static_cast<std::byte*>(upload.staging->get_mapped());
+
+	auto const base_isrl = vk::ImageSubresourceLayers{vk::ImageAspectFlagBits::eColor, 0, 0, 1};
+	auto const base_extent = vk::Extent3D{to_vk_extent(bitmap.extent), 1};
+	upload.regions.emplace_back(0, 0, 0, base_isrl, vk::Offset3D{top_left.x, top_left.y, 0}, base_extent);
+	std::memcpy(mapped, bitmap.bytes.data(), bitmap.bytes.size());
+
+	// 4 byte texels: offsets of subsequent levels remain aligned.
+	auto offset = bitmap.bytes.size();
+	for (std::uint32_t level = 1; level <= levels.size(); ++level) {
+		auto const& bytes = levels[level - 1];
+		std::memcpy(mapped + offset, bytes.data(), bytes.size()); // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+		auto const isrl = vk::ImageSubresourceLayers{vk::ImageAspectFlagBits::eColor, level, 0, 1};
+		auto const level_extent = level_offset(image.get_extent(), level);
+		auto const extent = vk::Extent3D{static_cast<std::uint32_t>(level_extent.x), static_cast<std::uint32_t>(level_extent.y), 1};
+		upload.regions.emplace_back(offset, 0, 0, isrl, vk::Offset3D{}, extent);
+		offset += bytes.size();
+	}
+
+	m_uploads.push_back(std::move(upload));
+	return true;
+}
+
+void ImageUploader::submit() {
+	if (m_uploads.empty()) { return; }
+
+	auto cmd = CommandBuffer{*m_render_device};
+	auto barriers = std::vector<vk::ImageMemoryBarrier>{};
+	barriers.reserve(2 * m_uploads.size());
+	auto const barrier = [&](vk::PipelineStageFlags const src, vk::PipelineStageFlags const dst) {
+		if (barriers.empty()) { return; }
+		cmd.get().pipelineBarrier(src, dst, {}, {}, {}, barriers);
+		barriers.clear();
+	};
+	static constexpr auto all_v = vk::PipelineStageFlags{vk::PipelineStageFlagBits::eAllCommands};
+	static constexpr auto transfer_v = vk::PipelineStageFlags{vk::PipelineStageFlagBits::eTransfer};
+
+	// all levels of all images: transfer destinations.
+	for (auto const& upload : m_uploads) {
+		auto const& image = *upload.image;
+		barriers.push_back(make_barrier(image, upload.initial_layout, vk::ImageLayout::eTransferDstOptimal, 0, image.get_mip_levels()));
+	}
+	barrier(all_v, transfer_v);
+
+	auto max_levels = std::uint32_t{};
+	for (auto const& upload : m_uploads) {
+		cmd.get().copyBufferToImage(upload.staging->get_buffer(), upload.image->get_image(), vk::ImageLayout::eTransferDstOptimal, upload.regions);
+		if (upload.blit_mips) { max_levels = std::max(max_levels, upload.image->get_mip_levels()); }
+	}
+
+	// mip chains, one level of all images at a time: a single barrier per level.
+	for (std::uint32_t level = 0; level + 1 < max_levels; ++level) {
+		for (auto const& upload : m_uploads) {
+			if (!upload.blit_mips || level + 1 >= upload.image->get_mip_levels()) { continue; }
+			barriers.push_back(make_barrier(*upload.image, vk::ImageLayout::eTransferDstOptimal, vk::ImageLayout::eTransferSrcOptimal, level, 1));
+		}
+		barrier(transfer_v, transfer_v);
+
+		for (auto const& upload : m_uploads) {
+			auto const& image = *upload.image;
+			if (!upload.blit_mips || level + 1 >= image.get_mip_levels()) { continue; }
+			auto const src_isrl = vk::ImageSubresourceLayers{vk::ImageAspectFlagBits::eColor, level, 0, 1};
+			auto const dst_isrl = vk::ImageSubresourceLayers{vk::ImageAspectFlagBits::eColor, level + 1, 0, 1};
+			auto const region = vk::ImageBlit{
+				src_isrl,
+				{vk::Offset3D{}, level_offset(image.get_extent(), level)},
+				dst_isrl,
+				{vk::Offset3D{}, level_offset(image.get_extent(), level + 1)},
+			};
+			cmd.get().blitImage(image.get_image(), vk::ImageLayout::eTransferSrcOptimal, image.get_image(), vk::ImageLayout::eTransferDstOptimal, region,
+								upload.filter);
+		}
+	}
+
+	// blitted mip chains: all but the last level are transfer sources.
+	for (auto const& upload : m_uploads) {
+		auto const& image = *upload.image;
+		auto const last = image.get_mip_levels() - 1;
+		if (upload.blit_mips) {
+			barriers.push_back(make_barrier(image, vk::ImageLayout::eTransferSrcOptimal, image.get_layout(), 0, last));
+			barriers.push_back(make_barrier(image, vk::ImageLayout::eTransferDstOptimal, image.get_layout(), last, 1));
+		} else {
+			barriers.push_back(make_barrier(image, vk::ImageLayout::eTransferDstOptimal, image.get_layout(), 0, image.get_mip_levels()));
+		}
+	}
+	barrier(transfer_v, all_v);
+
+	for (auto& upload : m_uploads) { cmd.keep_alive(std::move(upload.staging)); }
+	m_uploads.clear();
+	cmd.submit_deferred(*m_render_device);
+}
+} // namespace bave::detail
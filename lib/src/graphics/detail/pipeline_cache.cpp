@@ -5,6 +5,7 @@
 #include <vulkan/vulkan_hash.hpp>
 #include <cstddef>
 #include <map>
+#include <mutex>
 
 namespace bave::detail {
 namespace {
@@ -45,12 +46,13 @@ struct PipelineShaderLayout {
 };
 } // namespace
 
-PipelineCache::Key::Key(Program shader, State state)
-	: shader(shader), state(state), cached_hash(make_combined_hash(shader.vertex, shader.fragment, state.topology, state.polygon_mode)) {}
+PipelineCache::Key::Key(Program shader, State state, Pass pass)
+	: shader(shader), state(state), pass(pass),
+	  cached_hash(make_combined_hash(shader.vertex, shader.fragment, state.topology, state.polygon_mode, pass.render_pass, pass.samples)) {}
 
 PipelineCache::PipelineCache(vk::RenderPass render_pass, NotNull<RenderDevice*> render_device, NotNull<DataStore const*> data_store)
-	: m_shader_cache(render_device->get_device(), data_store), m_descriptor_cache(render_device), m_render_pass(render_pass),
-	  m_samples(render_device->get_sample_count()) {
+	: m_render_device(render_device), m_shader_cache(render_device->get_device(), data_store), m_descriptor_cache(render_device),
+	  m_backbuffer{.render_pass = render_pass, .samples = render_device->get_sample_count()} {
 	auto pipeline_shader_layout = PipelineShaderLayout::make(render_device->get_device());
 
 	m_descriptor_set_layouts = std::move(pipeline_shader_layout).descriptor_set_layouts;
@@ -71,36 +73,74 @@ PipelineCache::PipelineCache(vk::RenderPass render_pass, NotNull<RenderDevice*>
 	};
 }
 
-auto PipelineCache::load_pipeline(Program shader, State state) -> vk::Pipeline {
+auto PipelineCache::load_pipeline(Program shader, State state) -> vk::Pipeline { return load_pipeline(shader, state, m_backbuffer); }
+
+auto PipelineCache::load_pipeline(Program shader, State state, Pass pass) -> vk::Pipeline {
 	if (!shader.vertex || !shader.fragment) {
 		m_log.warn("null vertex/fragment shader");
 		return {};
 	}
 
-	auto const key = Key{shader, state};
-	auto itr = m_pipelines.find(key);
-	if (itr == m_pipelines.end()) {
-		auto ret = build(key);
-		if (!ret) { return {}; }
-		auto const [inserted, _] = m_pipelines.insert_or_assign(key, std::move(ret));
-		itr = inserted;
-
-		m_log.debug("new Vulkan Pipeline created '{}' (total: {})", key.hash(), m_pipelines.size());
+	auto const key = Key{shader, state, pass};
+	{
+		auto lock = std::shared_lock{m_mutex};
+		if (auto const itr = m_pipelines.find(key); itr != m_pipelines.end()) { return *itr->second; }
 	}
-	assert(itr != m_pipelines.end());
+
+	// build outside the lock, so that threads building different pipelines don't block each other.
+	auto ret = build(key);
+	if (!ret) { return {}; }
+	auto lock = std::unique_lock{m_mutex};
+	// another thread may have built the same pipeline meanwhile: keep the first.
+	auto const [itr, inserted] = m_pipelines.try_emplace(key, std::move(ret));
+	if (inserted) { m_log.debug("new Vulkan Pipeline created '{}' (total: {})", key.hash(), m_pipelines.size()); }
 	return *itr->second;
 }
 
+auto PipelineCache::pipeline_count() const -> std::size_t {
+	auto lock = std::shared_lock{m_mutex};
+	return m_pipelines.size();
+}
+
 void PipelineCache::clear_loaded() {
 	auto const pc = pipeline_count();
 	auto const sc = shader_count();
 	if (pc == 0 && sc == 0) { return; }
 	m_shader_cache.get_device().waitIdle();
-	m_pipelines.clear();
+	{
+		auto lock = std::unique_lock{m_mutex};
+		m_pipelines.clear();
+	}
 	m_shader_cache.clear();
 	m_log.info("{} Vulkan Pipeline(s) and {} Shader Module(s) destroyed", pc, sc);
 }
 
+auto PipelineCache::invalidate(std::string_view const uri) -> bool {
+	auto modules = m_shader_cache.invalidate(uri);
+	if (modules.empty()) { return false; }
+
+	auto& defer_queue = m_render_device->get_defer_queue();
+	auto invalidated = std::size_t{};
+	{
+		auto lock = std::unique_lock{m_mutex};
+		for (auto const& module : modules) {
+			for (auto it = m_pipelines.begin(); it != m_pipelines.end();) {
+				if (it->first.shader.vertex != *module && it->first.shader.fragment != *module) {
+					++it;
+					continue;
+				}
+				defer_queue.push(std::make_shared<vk::UniquePipeline>(std::move(it->second)));
+				it = m_pipelines.erase(it);
+				++invalidated;
+			}
+		}
+	}
+	for (auto& module : modules) { defer_queue.push(std::make_shared<vk::UniqueShaderModule>(std::move(module))); }
+
+	m_log.info("{} Vulkan Pipeline(s) and {} Shader Module(s) invalidated", invalidated, modules.size());
+	return true;
+}
+
 auto PipelineCache::build(Key const& key) -> vk::UniquePipeline {
 	auto shader_stages = std::array<vk::PipelineShaderStageCreateInfo, 2>{};
 	shader_stages[0].stage = vk::ShaderStageFlagBits::eVertex;
@@ -158,11 +198,11 @@ auto PipelineCache::build(Key const& key) -> vk::UniquePipeline {
 	gpci.pViewportState = &pvsci;
 
 	auto pmsci = vk::PipelineMultisampleStateCreateInfo{};
-	pmsci.rasterizationSamples = m_samples;
+	pmsci.rasterizationSamples = key.pass.samples;
 	pmsci.sampleShadingEnable = vk::False;
 	gpci.pMultisampleState = &pmsci;
 
-	gpci.renderPass = m_render_pass;
+	gpci.renderPass = key.pass.render_pass;
 	gpci.layout = *m_pipeline_layout;
 
 	auto ret = vk::Pipeline{};
@@ -0,0 +1,32 @@
+#include <bave/core/error.hpp>
+#include <bave/graphics/detail/record_arena.hpp>
+#include <bave/graphics/render_device.hpp>
+
+namespace bave::detail {
+RecordArena::RecordArena(NotNull<RenderDevice*> render_device)
+	: buffer_cache(render_device), descriptor_cache(render_device), m_render_device(render_device) {
+	auto const cpci = vk::CommandPoolCreateInfo{vk::CommandPoolCreateFlagBits::eTransient, render_device->get_gpu().queue_family};
+	for (auto& pool : m_pools) { pool.command_pool = render_device->get_device().createCommandPoolUnique(cpci); }
+}
+
+auto RecordArena::allocate_command_buffer() -> vk::CommandBuffer {
+	auto& pool = m_pools.at(m_render_device->get_frame_index());
+	if (pool.next >= pool.command_buffers.size()) {
+		auto const cbai = vk::CommandBufferAllocateInfo{*pool.command_pool, vk::CommandBufferLevel::eSecondary, 1};
+		auto command_buffer = vk::CommandBuffer{};
+		if (m_render_device->get_device().allocateCommandBuffers(&cbai, &command_buffer) != vk::Result::eSuccess) {
+			throw Error{"Failed to allocate Vulkan Command Buffer"};
+		}
+		pool.command_buffers.push_back(command_buffer);
+	}
+	return pool.command_buffers[pool.next++];
+}
+
+auto RecordArena::next_frame() -> void {
+	auto& pool = m_pools.at(m_render_device->get_frame_index());
+	m_render_device->get_device().resetCommandPool(*pool.command_pool);
+	pool.next = 0;
+	buffer_cache.next_frame();
+	descriptor_cache.next_frame();
+}
+} // namespace bave::detail
@@ -2,11 +2,15 @@
 #include <bave/core/is_positive.hpp>
 #include <bave/graphics/detail/command_buffer.hpp>
 #include <bave/graphics/detail/image_barrier.hpp>
+#include <bave/graphics/detail/image_uploader.hpp>
 #include <bave/graphics/detail/render_resource.hpp>
 #include <bave/graphics/detail/utils.hpp>
 #include <bave/graphics/render_device.hpp>
 #include <algorithm>
+#include <array>
 #include <cmath>
+#include <cstring>
+#include <memory>
 
 namespace bave::detail {
 namespace {
@@ -119,28 +123,6 @@ struct MipMapWriter {
 	}
 };
 
-struct CopyBufferToImage {
-	vk::Image target_image{};
-	vk::Extent2D image_extent{};
-	vk::Offset2D target_offset{};
-	vk::Buffer source_bytes{};
-	vk::Extent2D source_extent{};
-	std::uint32_t array_layers{1};
-	std::uint32_t mip_levels{1};
-
-	auto operator()(vk::CommandBuffer const cmd, vk::ImageLayout const layout) const {
-		auto const isrl = vk::ImageSubresourceLayers(vk::ImageAspectFlagBits::eColor, 0, 0, array_layers);
-		auto const vk_extent = vk::Extent3D{source_extent, 1u};
-		auto const bic = vk::BufferImageCopy({}, {}, {}, isrl, vk::Offset3D{target_offset, 0}, vk_extent);
-		auto barrier = ImageBarrier{target_image, mip_levels, array_layers};
-		barrier.set_full_barrier(vk::ImageLayout::eUndefined, vk::ImageLayout::eTransferDstOptimal).transition(cmd);
-		cmd.copyBufferToImage(source_bytes, target_image, vk::ImageLayout::eTransferDstOptimal, bic);
-		barrier.set_full_barrier(vk::ImageLayout::eTransferDstOptimal, layout).transition(cmd);
-
-		if (mip_levels > 1) { MipMapWriter{barrier, image_extent, cmd, mip_levels, array_layers}(); }
-	}
-};
-
 struct CopyImage {
 	vk::Image image{};
 	vk::ImageLayout layout{};
@@ -213,6 +195,12 @@ auto RenderImage::compute_mip_levels(vk::Extent2D extent) -> std::uint32_t {
 	return static_cast<std::uint32_t>(std::floor(std::log2(std::max(extent.width, extent.height)))) + 1u;
 }
 
+auto RenderImage::compute_mip_levels(CreateInfo const& create_info, vk::Extent2D const extent) -> std::uint32_t {
+	if (!create_info.mip_map) { return 1; }
+	auto const full = compute_mip_levels(extent);
+	return create_info.mip_levels == 0 ? full : std::min(create_info.mip_levels, full);
+}
+
 RenderImage::RenderImage(NotNull<RenderDevice*> render_device, CreateInfo const& info, vk::Extent2D extent) : m_render_device(render_device) {
 	if (extent.width == 0) { extent.width = 1; }
 	if (extent.height == 0) { extent.height = 1; }
@@ -225,72 +213,185 @@ auto RenderImage::copy_from(BitmapView const bitmap) -> bool {
 
 	auto const extent = to_vk_extent(bitmap.extent);
 	if (m_extent != extent) { recreate(extent); }
-	auto staging = RenderBuffer{
-		m_render_device,
-		vk::BufferUsageFlagBits::eTransferSrc | vk::BufferUsageFlagBits::eTransferDst,
-		bitmap.bytes.size(),
-	};
-
-	std::memcpy(staging.get_mapped(), bitmap.bytes.data(), bitmap.bytes.size());
-
-	auto cmd = detail::CommandBuffer{*m_render_device};
-	CopyBufferToImage{
-		.target_image = m_image,
-		.image_extent = m_extent,
-		.target_offset = {},
-		.source_bytes = staging.get_buffer(),
-		.source_extent = extent,
-		.array_layers = 1,
-		.mip_levels = m_mip_levels,
-	}(cmd.get(), m_create_info.layout);
-
-	cmd.submit(*m_render_device);
-
-	return true;
+	return ImageUploader{m_render_device}.upload(*this, bitmap);
 }
 
 void RenderImage::recreate(vk::Extent2D extent) {
 	if (extent.width == 0 || extent.height == 0) { return; }
 	if (extent == m_extent) { return; }
 
-	auto const mip_levels = m_create_info.mip_map ? compute_mip_levels(extent) : 1;
+	create(extent, compute_mip_levels(m_create_info, extent));
+}
+
+void RenderImage::create(vk::Extent2D const extent, std::uint32_t const mip_levels) {
 	auto vma_image = VmaImage::make(*m_render_device, m_create_info, extent, mip_levels);
 
+	auto cmd = detail::CommandBuffer{*m_render_device};
+	if (m_image) {
+		// deferred submits to the previous image may still be executing: this one completes after them.
+		cmd.keep_alive(std::make_shared<Retired>(Retired{.image = std::move(m_image), .view = std::move(m_view)}));
+	}
+
 	m_image = {vma_image.image, Deleter{.allocator = m_render_device->get_allocator(), .allocation = vma_image.allocation}};
 	m_view = std::move(vma_image.image_view);
 	m_extent = extent;
 	m_mip_levels = mip_levels;
 
-	auto cmd = detail::CommandBuffer{*m_render_device};
 	auto barrier = ImageBarrier{m_image, mip_levels, 1};
 	barrier.set_full_barrier(vk::ImageLayout::eUndefined, m_create_info.layout).transition(cmd);
-	cmd.submit(*m_render_device);
+	cmd.submit_deferred(*m_render_device);
 }
 
-auto RenderImage::overwrite(BitmapView const bitmap, glm::ivec2 top_left) -> bool {
-	if (m_create_info.view_type == vk::ImageViewType::eCube || !is_positive(bitmap.extent)) { return false; }
+auto RenderImage::copy_levels(vk::Format const format, vk::Extent2D const extent, std::span<Layer const> levels) -> bool {
+	if (m_create_info.view_type == vk::ImageViewType::eCube || levels.empty() || extent.width == 0 || extent.height == 0) { return false; }
+	// mipLevels beyond the full chain is invalid, and each region copies its full level extent out of the staging buffer.
+	if (levels.size() > compute_mip_levels(extent)) { return false; }
+	for (std::uint32_t level = 0; level < static_cast<std::uint32_t>(levels.size()); ++level) {
+		auto const level_extent = vk::Extent2D{std::max(extent.width >> level, 1u), std::max(extent.height >> level, 1u)};
+		auto const level_size = compute_level_size(format, level_extent);
+		if (level_size == 0 || levels[level].size() < level_size) { return false; }
+	}
+
+	// buffer offsets must be multiples of the texel block size (at most 16 bytes).
+	static constexpr vk::DeviceSize align_v{16};
+	auto const align = [](vk::DeviceSize const offset) { return (offset + align_v - 1) & ~(align_v - 1); };
+	auto offsets = std::vector<vk::DeviceSize>{};
+	offsets.reserve(levels.size());
+	auto size = vk::DeviceSize{};
+	for (auto const& level : levels) {
+		offsets.push_back(size);
+		size = align(size + level.size());
+	}
 
-	auto const overwrite_extent = bitmap.extent + top_left;
-	auto const current_extent = glm::ivec2{m_extent.width, m_extent.height};
-	if (overwrite_extent.x > current_extent.x || overwrite_extent.y > current_extent.y) { return false; }
+	auto staging = std::make_shared<RenderBuffer>(m_render_device, vk::BufferUsageFlagBits::eTransferSrc | vk::BufferUsageFlagBits::eTransferDst, size);
+	auto* mapped = static_cast<std::byte*>(staging->get_mapped());
+	for (std::size_t i = 0; i < levels.size(); ++i) {
+		std::memcpy(mapped + offsets[i], levels[i].data(), levels[i].size()); // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+	}
 
-	auto staging = RenderBuffer{m_render_device, vk::BufferUsageFlagBits::eTransferSrc | vk::BufferUsageFlagBits::eTransferDst, bitmap.bytes.size_bytes()};
-	std::memcpy(staging.get_mapped(), bitmap.bytes.data(), bitmap.bytes.size_bytes());
+	auto const mip_levels = static_cast<std::uint32_t>(levels.size());
+	if (format != m_create_info.format || extent != m_extent || mip_levels != m_mip_levels) {
+		m_create_info.format = format;
+		m_create_info.mip_map = mip_levels > 1;
+		m_create_info.mip_levels = mip_levels;
+		create(extent, mip_levels);
+	}
+
+	auto regions = std::vector<vk::BufferImageCopy>{};
+	regions.reserve(levels.size());
+	for (std::uint32_t level = 0; level < static_cast<std::uint32_t>(levels.size()); ++level) {
+		auto const isrl = vk::ImageSubresourceLayers{vk::ImageAspectFlagBits::eColor, level, 0, 1};
+		auto const level_extent = vk::Extent3D{std::max(extent.width >> level, 1u), std::max(extent.height >> level, 1u), 1};
+		regions.emplace_back(offsets[level], 0, 0, isrl, vk::Offset3D{}, level_extent);
+	}
 
 	auto cmd = detail::CommandBuffer{*m_render_device};
-	auto const offset = glm::ivec2{top_left};
-	CopyBufferToImage{
-		.target_image = m_image,
-		.image_extent = m_extent,
-		.target_offset = {offset.x, offset.y},
-		.source_bytes = staging.get_buffer(),
-		.source_extent = to_vk_extent(bitmap.extent),
-		.array_layers = 1,
-		.mip_levels = m_mip_levels,
-	}(cmd.get(), m_create_info.layout);
+	auto barrier = ImageBarrier{m_image, m_mip_levels, 1};
+	barrier.set_full_barrier(m_create_info.layout, vk::ImageLayout::eTransferDstOptimal).transition(cmd);
+	cmd.get().copyBufferToImage(staging->get_buffer(), m_image, vk::ImageLayout::eTransferDstOptimal, regions);
+	barrier.set_full_barrier(vk::ImageLayout::eTransferDstOptimal, m_create_info.layout).transition(cmd);
+	cmd.keep_alive(std::move(staging));
+	cmd.submit_deferred(*m_render_device);
 
+	return true;
+}
+
+auto RenderImage::overwrite(BitmapView const bitmap, glm::ivec2 top_left) -> bool { return ImageUploader{m_render_device}.upload(*this, bitmap, top_left); }
+
+auto RenderImage::read_back() const -> std::optional<Bitmap> {
+	auto const bgra = is_bgra(m_create_info.format);
+	if (m_create_info.view_type == vk::ImageViewType::eCube || (!bgra && !is_rgba(m_create_info.format))) { return {}; }
+
+	static constexpr std::size_t channels_v{4};
+	auto const size = std::size_t{m_extent.width} * m_extent.height * channels_v;
+	auto staging = RenderBuffer{m_render_device, vk::BufferUsageFlagBits::eTransferDst, size};
+
+	auto cmd = detail::CommandBuffer{*m_render_device};
+	auto const isrl = vk::ImageSubresourceLayers{vk::ImageAspectFlagBits::eColor, 0, 0, 1};
+	auto const bic = vk::BufferImageCopy{{}, {}, {}, isrl, vk::Offset3D{}, vk::Extent3D{m_extent, 1}};
+	auto barrier = ImageBarrier{m_image, m_mip_levels, 1};
+	barrier.set_full_barrier(m_create_info.layout, vk::ImageLayout::eTransferSrcOptimal).transition(cmd);
+	cmd.get().copyImageToBuffer(m_image, vk::ImageLayout::eTransferSrcOptimal, staging.get_buffer(), bic);
+	barrier.set_full_barrier(vk::ImageLayout::eTransferSrcOptimal, m_create_info.layout).transition(cmd);
 	cmd.submit(*m_render_device);
 
-	return true;
+	auto bytes = std::vector<std::byte>(size);
+	std::memcpy(bytes.data(), staging.get_mapped(), size);
+	if (bgra) {
+		for (std::size_t i = 0; i < size; i += channels_v) { std::swap(bytes[i], bytes[i + 2]); }
+	}
+	return Bitmap{std::move(bytes), to_glm_vec<int>(m_extent)};
+}
+
+auto get_format_block(vk::Format const format) -> FormatBlock {
+	static constexpr auto block_4x4_v = vk::Extent2D{4, 4};
+	// ASTC LDR: unorm and srgb variants of each block extent are adjacent.
+	static constexpr auto astc_extents_v = std::array<vk::Extent2D, 14>{{
+		{4, 4}, {5, 4}, {5, 5}, {6, 5}, {6, 6}, {8, 5}, {8, 6}, {8, 8}, {10, 5}, {10, 6}, {10, 8}, {10, 10}, {12, 10}, {12, 12},
+	}};
+
+	switch (format) {
+	case vk::Format::eR8Unorm:
+	case vk::Format::eR8Srgb: return FormatBlock{.size = 1};
+	case vk::Format::eR8G8Unorm:
+	case vk::Format::eR8G8Srgb: return FormatBlock{.size = 2};
+	case vk::Format::eR8G8B8A8Unorm:
+	case vk::Format::eR8G8B8A8Srgb:
+	case vk::Format::eB8G8R8A8Unorm:
+	case vk::Format::eB8G8R8A8Srgb:
+	case vk::Format::eA8B8G8R8UnormPack32:
+	case vk::Format::eA8B8G8R8SrgbPack32: return FormatBlock{.size = 4};
+	case vk::Format::eR16G16B16A16Sfloat: return FormatBlock{.size = 8};
+	case vk::Format::eR32G32B32A32Sfloat: return FormatBlock{.size = 16};
+	case vk::Format::eBc1RgbUnormBlock:
+	case vk::Format::eBc1RgbSrgbBlock:
+	case vk::Format::eBc1RgbaUnormBlock:
+	case vk::Format::eBc1RgbaSrgbBlock:
+	case vk::Format::eBc4UnormBlock:
+	case vk::Format::eBc4SnormBlock:
+	case vk::Format::eEtc2R8G8B8UnormBlock:
+	case vk::Format::eEtc2R8G8B8SrgbBlock:
+	case vk::Format::eEtc2R8G8B8A1UnormBlock:
+	case vk::Format::eEtc2R8G8B8A1SrgbBlock:
+	case vk::Format::eEacR11UnormBlock:
+	case vk::Format::eEacR11SnormBlock: return FormatBlock{.extent = block_4x4_v, .size = 8};
+	case vk::Format::eBc2UnormBlock:
+	case vk::Format::eBc2SrgbBlock:
+	case vk::Format::eBc3UnormBlock:
+	case vk::Format::eBc3SrgbBlock:
+	case vk::Format::eBc5UnormBlock:
+	case vk::Format::eBc5SnormBlock:
+	case vk::Format::eBc6HUfloatBlock:
+	case vk::Format::eBc6HSfloatBlock:
+	case vk::Format::eBc7UnormBlock:
+	case vk::Format::eBc7SrgbBlock:
+	case vk::Format::eEtc2R8G8B8A8UnormBlock:
+	case vk::Format::eEtc2R8G8B8A8SrgbBlock:
+	case vk::Format::eEacR11G11UnormBlock:
+	case vk::Format::eEacR11G11SnormBlock: return FormatBlock{.extent = block_4x4_v, .size = 16};
+	default: break;
+	}
+
+	auto const value = static_cast<int>(format);
+	if (value >= static_cast<int>(vk::Format::eAstc4x4UnormBlock) && value <= static_cast<int>(vk::Format::eAstc12x12SrgbBlock)) {
+		auto const index = static_cast<std::size_t>(value - static_cast<int>(vk::Format::eAstc4x4UnormBlock)) / 2;
+		return FormatBlock{.extent = astc_extents_v.at(index), .size = 16};
+	}
+	return {};
+}
+
+auto compute_level_size(vk::Format const format, vk::Extent2D const extent) -> vk::DeviceSize {
+	auto const block = get_format_block(format);
+	auto const blocks_x = (vk::DeviceSize{extent.width} + block.extent.width - 1) / block.extent.width;
+	auto const blocks_y = (vk::DeviceSize{extent.height} + block.extent.height - 1) / block.extent.height;
+	return blocks_x * blocks_y * block.size;
+}
+
+auto compute_image_size(vk::Format const format, vk::Extent2D const extent, std::uint32_t const mip_levels) -> vk::DeviceSize {
+	auto ret = vk::DeviceSize{};
+	for (std::uint32_t level = 0; level < mip_levels; ++level) {
+		ret += compute_level_size(format, vk::Extent2D{std::max(extent.width >> level, 1u), std::max(extent.height >> level, 1u)});
+	}
+	return ret;
 }
 } // namespace bave::detail
@@ -1,5 +1,6 @@
 #include <bave/core/hash_combine.hpp>
 #include <bave/graphics/detail/sampler_cache.hpp>
+#include <mutex>
 
 namespace bave::detail {
 namespace {
@@ -29,23 +30,38 @@ constexpr auto from(Texture::Border const border) -> vk::BorderColor {
 } // namespace
 
 auto SamplerCache::Hasher::operator()(Texture::Sampler const& sampler) const -> std::size_t {
-	return make_combined_hash(sampler.min, sampler.mag, sampler.wrap_s, sampler.wrap_t, sampler.border);
+	return make_combined_hash(sampler.min, sampler.mag, sampler.wrap_s, sampler.wrap_t, sampler.border, sampler.mip, sampler.lod_bias);
+}
+
+SamplerCache::SamplerCache(vk::Device device) : m_device(device) {
+	// samplers used by default by Textures (with and without mip maps), RenderTextures and font atlases.
+	static constexpr auto clamp_edge_v = Texture::Sampler{.wrap_s = Texture::Wrap::eClampEdge, .wrap_t = Texture::Wrap::eClampEdge};
+	static constexpr auto nearest_v = Texture::Sampler{.min = Texture::Filter::eNearest, .mag = Texture::Filter::eNearest};
+	static constexpr auto trilinear_v = Texture::Sampler{.mip = Texture::Filter::eLinear};
+	for (auto const& sampler : {Texture::Sampler{}, clamp_edge_v, nearest_v, trilinear_v}) { get(sampler); }
 }
 
 auto SamplerCache::get(Texture::Sampler const& sampler) -> vk::Sampler {
-	if (auto it = m_map.find(sampler); it != m_map.end()) { return *it->second; }
+	{
+		auto lock = std::shared_lock{m_mutex};
+		if (auto it = m_map.find(sampler); it != m_map.end()) { return *it->second; }
+	}
 	auto sci = vk::SamplerCreateInfo{};
 	sci.minFilter = from(sampler.min);
 	sci.magFilter = from(sampler.mag);
 	sci.anisotropyEnable = anisotropy > 0.0f ? 1 : 0;
 	sci.maxAnisotropy = anisotropy;
 	sci.borderColor = from(sampler.border);
-	sci.mipmapMode = vk::SamplerMipmapMode::eNearest;
+	sci.mipmapMode = sampler.mip == Texture::Filter::eLinear ? vk::SamplerMipmapMode::eLinear : vk::SamplerMipmapMode::eNearest;
+	sci.mipLodBias = sampler.lod_bias;
 	sci.addressModeU = from(sampler.wrap_s);
 	sci.addressModeV = from(sampler.wrap_t);
 	sci.addressModeW = from(sampler.wrap_s);
 	sci.maxLod = VK_LOD_CLAMP_NONE;
-	auto [it, _] = m_map.insert_or_assign(sampler, m_device.createSamplerUnique(sci));
+	auto ret = m_device.createSamplerUnique(sci);
+	auto lock = std::unique_lock{m_mutex};
+	// another thread may have created the same sampler meanwhile: keep the first.
+	auto [it, _] = m_map.try_emplace(sampler, std::move(ret));
 	return *it->second;
 }
 } // namespace bave::detail
@@ -1,16 +1,34 @@
 #include <bave/graphics/detail/shader_cache.hpp>
 #include <bave/logger.hpp>
+#include <mutex>
 
 namespace bave::detail {
+namespace {
+constexpr std::string_view spir_v_suffix_v{".spv"};
+
+auto matches(std::string_view const key, std::string_view const uri) -> bool {
+	if (key == uri) { return true; }
+	return uri.size() == key.size() + spir_v_suffix_v.size() && uri.starts_with(key) && uri.ends_with(spir_v_suffix_v);
+}
+} // namespace
+
 auto ShaderCache::load(std::string_view const uri) -> vk::ShaderModule {
 	if (uri.empty()) { return {}; }
 
-	if (auto it = m_modules.find(uri); it != m_modules.end()) { return *it->second; }
+	{
+		auto lock = std::shared_lock{m_mutex};
+		if (auto it = m_modules.find(uri); it != m_modules.end()) { return *it->second; }
+		// don't hit the data store again for a missing / broken shader.
+		if (m_failed.contains(uri)) { return {}; }
+	}
 
 	auto const spir_v_uri = get_data_store().to_spir_v(uri);
-	if (spir_v_uri.empty()) { return {}; }
-	auto const spir_v_bytes = get_data_store().read_bytes(spir_v_uri);
-	if (spir_v_bytes.empty()) { return {}; }
+	auto const spir_v = spir_v_uri.empty() ? DataView{} : get_data_store().map(spir_v_uri);
+	if (!spir_v) {
+		set_failed(uri);
+		return {};
+	}
+	auto const spir_v_bytes = spir_v.get_bytes();
 	auto const smci = vk::ShaderModuleCreateInfo{
 		{},
 		spir_v_bytes.size(),
@@ -19,12 +37,51 @@ auto ShaderCache::load(std::string_view const uri) -> vk::ShaderModule {
 	auto shader_module = m_device.createShaderModuleUnique(smci);
 	if (!shader_module) {
 		m_log.error("failed to load shader: '{}'", uri);
+		set_failed(uri);
 		return {};
 	}
 
-	auto [it, _] = m_modules.insert_or_assign(std::string{uri}, std::move(shader_module));
-	m_log.debug("new Vulkan Shader Module created '{}' (total: {})", uri, m_modules.size());
+	auto lock = std::unique_lock{m_mutex};
+	// another thread may have loaded the same URI meanwhile: keep the first.
+	auto [it, inserted] = m_modules.try_emplace(std::string{uri}, std::move(shader_module));
+	if (inserted) { m_log.debug("new Vulkan Shader Module created '{}' (total: {})", uri, m_modules.size()); }
 
 	return *it->second;
 }
+
+auto ShaderCache::shader_count() const -> std::size_t {
+	auto lock = std::shared_lock{m_mutex};
+	return m_modules.size();
+}
+
+void ShaderCache::clear() {
+	auto lock = std::unique_lock{m_mutex};
+	m_modules.clear();
+	m_failed.clear();
+	m_generation.fetch_add(1, std::memory_order_release);
+}
+
+auto ShaderCache::invalidate(std::string_view const uri) -> std::vector<vk::UniqueShaderModule> {
+	auto ret = std::vector<vk::UniqueShaderModule>{};
+	auto lock = std::unique_lock{m_mutex};
+	for (auto it = m_modules.begin(); it != m_modules.end();) {
+		auto const& key = it->first;
+		if (!matches(key, uri)) {
+			++it;
+			continue;
+		}
+		m_log.info("invalidated Shader Module: '{}'", key);
+		ret.push_back(std::move(it->second));
+		it = m_modules.erase(it);
+	}
+	// the file may have been fixed (or created).
+	auto const failed = std::erase_if(m_failed, [uri](std::string const& key) { return matches(key, uri); });
+	if (!ret.empty() || failed > 0) { m_generation.fetch_add(1, std::memory_order_release); }
+	return ret;
+}
+
+void ShaderCache::set_failed(std::string_view const uri) {
+	auto lock = std::unique_lock{m_mutex};
+	m_failed.emplace(uri);
+}
 } // namespace bave::detail
@@ -0,0 +1,383 @@
+#include <stb/stb_image.h>
+#include <bave/graphics/image_decoder.hpp>
+#include <glm/vec3.hpp>
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+
+namespace bave {
+namespace {
+auto read_u32_be(std::span<std::byte const> in) -> std::uint32_t {
+	auto ret = std::uint32_t{};
+	for (std::size_t i = 0; i < 4; ++i) { ret = (ret << 8) | static_cast<std::uint32_t>(in[i]); }
+	return ret;
+}
+
+auto has_signature(std::span<std::byte const> bytes, std::span<char const> signature) -> bool {
+	if (bytes.size() < signature.size()) { return false; }
+	return std::equal(signature.begin(), signature.end(), bytes.begin(), [](char const a, std::byte const b) { return static_cast<std::byte>(a) == b; });
+}
+
+constexpr auto png_signature_v = std::array{'\x89', 'P', 'N', 'G', '\r', '\n', '\x1a', '\n'};
+constexpr auto qoi_signature_v = std::array{'q', 'o', 'i', 'f'};
+
+namespace png {
+enum : std::uint8_t { eGray = 0, eRgb = 2, ePalette = 3, eGrayAlpha = 4, eRgba = 6 };
+enum : std::uint8_t { eNone = 0, eSub = 1, eUp = 2, eAvg = 3, ePaeth = 4 };
+
+struct Header {
+	std::uint32_t width{};
+	std::uint32_t height{};
+	std::uint8_t colour_type{};
+	int channels{};
+};
+
+auto get_channels(std::uint8_t const colour_type) -> int {
+	switch (colour_type) {
+	case eGray: return 1;
+	case eRgb: return 3;
+	case ePalette: return 1;
+	case eGrayAlpha: return 2;
+	case eRgba: return 4;
+	default: return 0;
+	}
+}
+
+auto paeth(int const a, int const b, int const c) -> int {
+	auto const p = a + b - c;
+	auto const pa = std::abs(p - a);
+	auto const pb = std::abs(p - b);
+	auto const pc = std::abs(p - c);
+	if (pa <= pb && pa <= pc) { return a; }
+	if (pb <= pc) { return b; }
+	return c;
+}
+
+// Sub for 4 channels: SWAR byte-wise add of whole pixels (no carries across channels).
+void unfilter_sub_4(std::uint8_t* dst, std::uint8_t const* src, std::size_t const length) {
+	auto left = std::uint32_t{};
+	for (std::size_t i = 0; i < length; i += 4) {
+		auto pixel = std::uint32_t{};
+		std::memcpy(&pixel, src + i, 4); // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+		auto const sum = ((pixel & 0x7f7f7f7fu) + (left & 0x7f7f7f7fu)) ^ ((pixel ^ left) & 0x80808080u);
+		std::memcpy(dst + i, &sum, 4); // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+		left = sum;
+	}
+}
+
+// dst may alias src: each byte of src is read before the same byte of dst is written.
+// prev is the reconstructed previous row (zeroes for the first row).
+// returns false for unknown filter types.
+// NOLINTBEGIN(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+template <int Bpp>
+auto unfilter(std::uint8_t const filter, std::uint8_t* dst, std::uint8_t const* src, std::uint8_t const* prev, std::size_t const length) -> bool {
+	switch (filter) {
+	case eNone: std::memmove(dst, src, length); return true;
+	case eSub:
+		if constexpr (Bpp == 4) {
+			unfilter_sub_4(dst, src, length);
+		} else {
+			for (std::size_t i = 0; i < Bpp; ++i) { dst[i] = src[i]; }
+			for (std::size_t i = Bpp; i < length; ++i) { dst[i] = static_cast<std::uint8_t>(src[i] + dst[i - Bpp]); }
+		}
+		return true;
+	case eUp:
+		// no loop-carried dependency: vectorized by the compiler.
+		for (std::size_t i = 0; i < length; ++i) { dst[i] = static_cast<std::uint8_t>(src[i] + prev[i]); }
+		return true;
+	case eAvg:
+		for (std::size_t i = 0; i < Bpp; ++i) { dst[i] = static_cast<std::uint8_t>(src[i] + (prev[i] >> 1)); }
+		for (std::size_t i = Bpp; i < length; ++i) { dst[i] = static_cast<std::uint8_t>(src[i] + ((dst[i - Bpp] + prev[i]) >> 1)); }
+		return true;
+	case ePaeth:
+		for (std::size_t i = 0; i < Bpp; ++i) { dst[i] = static_cast<std::uint8_t>(src[i] + prev[i]); }
+		for (std::size_t i = Bpp; i < length; ++i) { dst[i] = static_cast<std::uint8_t>(src[i] + paeth(dst[i - Bpp], prev[i], prev[i - Bpp])); }
+		return true;
+	default: return false;
+	}
+}
+// NOLINTEND(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+
+using Unfilter = bool (*)(std::uint8_t, std::uint8_t*, std::uint8_t const*, std::uint8_t const*, std::size_t);
+
+auto get_unfilter(int const channels) -> Unfilter {
+	switch (channels) {
+	case 1: return &unfilter<1>;
+	case 2: return &unfilter<2>;
+	case 3: return &unfilter<3>;
+	default: return &unfilter<4>;
+	}
+}
+
+struct Chunks {
+	Header header{};
+	std::span<std::byte const> palette{};
+	std::span<std::byte const> transparency{};
+	std::vector<std::span<std::byte const>> data{};
+};
+
+auto parse(std::span<std::byte const> bytes, Chunks& out) -> bool {
+	bytes = bytes.subspan(png_signature_v.size());
+	auto has_header = false;
+	while (bytes.size() >= 12) {
+		auto const length = read_u32_be(bytes);
+		if (bytes.size() - 12 < length) { return false; }
+		auto const type = std::string_view{reinterpret_cast<char const*>(bytes.data() + 4), 4}; // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+		auto const data = bytes.subspan(8, length);
+		bytes = bytes.subspan(12 + length);
+
+		if (type == "IHDR") {
+			if (length != 13) { return false; }
+			auto const bit_depth = static_cast<std::uint8_t>(data[8]);
+			auto const colour_type = static_cast<std::uint8_t>(data[9]);
+			auto const interlace = static_cast<std::uint8_t>(data[12]);
+			if (bit_depth != 8 || interlace != 0) { return false; }
+			out.header = Header{.width = read_u32_be(data), .height = read_u32_be(data.subspan(4)), .colour_type = colour_type};
+			out.header.channels = get_channels(colour_type);
+			if (out.header.channels == 0 || out.header.width == 0 || out.header.height == 0) { return false; }
+			has_header = true;
+		} else if (type == "PLTE") {
+			out.palette = data;
+		} else if (type == "tRNS") {
+			out.transparency = data;
+		} else if (type == "IDAT") {
+			out.data.push_back(data);
+		} else if (type == "IEND") {
+			break;
+		}
+	}
+	return has_header && !out.data.empty() && (out.header.colour_type != ePalette || !out.palette.empty());
+}
+
+auto inflate(Chunks const& chunks, std::span<std::byte> out) -> bool {
+	auto joined = std::vector<std::byte>{};
+	auto compressed = chunks.data.front();
+	if (chunks.data.size() > 1) {
+		for (auto const data : chunks.data) { joined.insert(joined.end(), data.begin(), data.end()); }
+		compressed = joined;
+	}
+	// NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+	auto const length = stbi_zlib_decode_buffer(reinterpret_cast<char*>(out.data()), static_cast<int>(out.size()), reinterpret_cast<char const*>(compressed.data()),
+												static_cast<int>(compressed.size()));
+	return length == static_cast<int>(out.size());
+}
+
+// NOLINTBEGIN(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+struct Expander {
+	Chunks const& chunks;
+	std::array<std::uint32_t, 256> palette{};
+
+	explicit Expander(Chunks const& chunks) : chunks(chunks) {
+		if (chunks.header.colour_type != ePalette) { return; }
+		for (std::size_t i = 0; i < palette.size() && (i + 1) * 3 <= chunks.palette.size(); ++i) {
+			auto const alpha = i < chunks.transparency.size() ? chunks.transparency[i] : std::byte{0xff};
+			auto const rgba = std::array{chunks.palette[i * 3], chunks.palette[i * 3 + 1], chunks.palette[i * 3 + 2], alpha};
+			std::memcpy(&palette[i], rgba.data(), 4);
+		}
+	}
+
+	void operator()(std::uint8_t* dst, std::uint8_t const* src, std::size_t const width) const {
+		switch (chunks.header.colour_type) {
+		case eGray:
+			for (std::size_t i = 0; i < width; ++i) { set(dst + i * 4, src[i], src[i], src[i], 0xff); }
+			break;
+		case eGrayAlpha:
+			for (std::size_t i = 0; i < width; ++i) { set(dst + i * 4, src[i * 2], src[i * 2], src[i * 2], src[i * 2 + 1]); }
+			break;
+		case eRgb:
+			for (std::size_t i = 0; i < width; ++i) { set(dst + i * 4, src[i * 3], src[i * 3 + 1], src[i * 3 + 2], 0xff); }
+			break;
+		case ePalette:
+			for (std::size_t i = 0; i < width; ++i) { std::memcpy(dst + i * 4, &palette[src[i]], 4); }
+			break;
+		default: break;
+		}
+		apply_colour_key(dst, width);
+	}
+
+	static void set(std::uint8_t* dst, std::uint8_t const r, std::uint8_t const g, std::uint8_t const b, std::uint8_t const a) {
+		dst[0] = r;
+		dst[1] = g;
+		dst[2] = b;
+		dst[3] = a;
+	}
+
+	// tRNS for gray / RGB: 16-bit samples, pixels matching the key are transparent.
+	void apply_colour_key(std::uint8_t* dst, std::size_t const width) const {
+		auto const& key = chunks.transparency;
+		auto const type = chunks.header.colour_type;
+		if ((type == eGray && key.size() < 2) || (type == eRgb && key.size() < 6) || (type != eGray && type != eRgb)) { return; }
+		auto const r = static_cast<std::uint8_t>(key[1]);
+		auto const g = type == eRgb ? static_cast<std::uint8_t>(key[3]) : r;
+		auto const b = type == eRgb ? static_cast<std::uint8_t>(key[5]) : r;
+		for (std::size_t i = 0; i < width; ++i) {
+			auto* pixel = dst + i * 4;
+			if (pixel[0] == r && pixel[1] == g && pixel[2] == b) { pixel[3] = 0; }
+		}
+	}
+};
+// NOLINTEND(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+} // namespace png
+
+namespace qoi {
+constexpr std::size_t header_size_v{14};
+constexpr std::size_t padding_v{8};
+
+enum : std::uint8_t { eIndex = 0x00, eDiff = 0x40, eLuma = 0x80, eRun = 0xc0, eRgb = 0xfe, eRgba = 0xff, eMask = 0xc0 };
+
+struct Pixel {
+	std::uint8_t r{};
+	std::uint8_t g{};
+	std::uint8_t b{};
+	std::uint8_t a{};
+
+	[[nodiscard]] auto hash() const -> std::size_t { return (r * 3 + g * 5 + b * 7 + a * 11) % 64; }
+};
+} // namespace qoi
+
+class StbBitmap : public IBitmapViewSource {
+  public:
+	StbBitmap(StbBitmap const&) = delete;
+	StbBitmap(StbBitmap&&) = delete;
+	auto operator=(StbBitmap const&) -> StbBitmap& = delete;
+	auto operator=(StbBitmap&&) -> StbBitmap& = delete;
+
+	explicit StbBitmap(stbi_uc* data, glm::ivec2 const extent) : m_data(data), m_extent(extent) {}
+
+	~StbBitmap() override { stbi_image_free(m_data); }
+
+	[[nodiscard]] auto get_bitmap_view() const -> BitmapView final {
+		auto const size = static_cast<std::size_t>(m_extent.x) * static_cast<std::size_t>(m_extent.y) * 4;
+		return BitmapView{.bytes = {reinterpret_cast<std::byte const*>(m_data), size}, .extent = m_extent}; // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+	}
+
+  private:
+	stbi_uc* m_data{};
+	glm::ivec2 m_extent{};
+};
+} // namespace
+
+auto PngDecoder::can_decode(std::span<std::byte const> bytes) const -> bool { return has_signature(bytes, png_signature_v); }
+
+auto PngDecoder::decode(std::span<std::byte const> bytes) const -> std::unique_ptr<IBitmapViewSource> {
+	if (!can_decode(bytes)) { return {}; }
+	auto chunks = png::Chunks{};
+	if (!png::parse(bytes, chunks)) { return {}; }
+
+	auto const& header = chunks.header;
+	auto const width = static_cast<std::size_t>(header.width);
+	auto const height = static_cast<std::size_t>(header.height);
+	auto const stride = width * static_cast<std::size_t>(header.channels);
+	if (height * (stride + 1) > static_cast<std::size_t>(std::numeric_limits<int>::max())) { return {}; }
+
+	// each row is prefixed by its filter type.
+	auto filtered = std::vector<std::byte>(height * (stride + 1));
+	if (!png::inflate(chunks, filtered)) { return {}; }
+
+	auto pixels = std::vector<std::byte>(width * height * 4);
+	auto* const out = reinterpret_cast<std::uint8_t*>(pixels.data()); // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+	auto* const in = reinterpret_cast<std::uint8_t*>(filtered.data()); // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+	auto const zeroes = std::vector<std::uint8_t>(stride);
+	auto const unfilter = png::get_unfilter(header.channels);
+
+	// NOLINTBEGIN(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+	if (header.colour_type == png::eRgba) {
+		// reconstruct straight into the output.
+		for (std::size_t y = 0; y < height; ++y) {
+			auto const* row = in + y * (stride + 1);
+			auto const* prev = y == 0 ? zeroes.data() : out + (y - 1) * stride;
+			if (!unfilter(row[0], out + y * stride, row + 1, prev, stride)) { return {}; }
+		}
+	} else {
+		// reconstruct in place, then expand to RGBA.
+		auto const expand = png::Expander{chunks};
+		for (std::size_t y = 0; y < height; ++y) {
+			auto* row = in + y * (stride + 1);
+			auto const* prev = y == 0 ? zeroes.data() : row - stride;
+			if (!unfilter(row[0], row + 1, row + 1, prev, stride)) { return {}; }
+			expand(out + y * width * 4, row + 1, width);
+		}
+	}
+	// NOLINTEND(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+
+	return std::make_unique<Bitmap>(std::move(pixels), glm::ivec2{header.width, header.height});
+}
+
+auto QoiDecoder::can_decode(std::span<std::byte const> bytes) const -> bool {
+	return bytes.size() >= qoi::header_size_v + qoi::padding_v && has_signature(bytes, qoi_signature_v);
+}
+
+auto QoiDecoder::decode(std::span<std::byte const> bytes) const -> std::unique_ptr<IBitmapViewSource> {
+	if (!can_decode(bytes)) { return {}; }
+	auto const width = read_u32_be(bytes.subspan(4));
+	auto const height = read_u32_be(bytes.subspan(8));
+	auto const channels = static_cast<std::uint8_t>(bytes[12]);
+	if (width == 0 || height == 0 || (channels != 3 && channels != 4)) { return {}; }
+	auto const count = static_cast<std::size_t>(width) * static_cast<std::size_t>(height);
+	if (count > static_cast<std::size_t>(std::numeric_limits<int>::max()) / 4) { return {}; }
+
+	auto pixels = std::vector<std::byte>(count * 4);
+	auto const in = bytes.subspan(qoi::header_size_v, bytes.size() - qoi::header_size_v - qoi::padding_v);
+	auto index = std::array<qoi::Pixel, 64>{};
+	auto pixel = qoi::Pixel{.a = 0xff};
+	auto run = 0;
+	auto pos = std::size_t{};
+	auto const next = [&] { return static_cast<std::uint8_t>(in[pos++]); };
+	// ops are read only after checking that all their bytes are present.
+	auto const has = [&](std::size_t const count) { return in.size() - pos >= count; };
+
+	for (std::size_t i = 0; i < count; ++i) {
+		if (run > 0) {
+			--run;
+		} else if (has(1)) {
+			auto const op = next();
+			if (op == qoi::eRgb) {
+				if (!has(3)) { return {}; }
+				pixel.r = next();
+				pixel.g = next();
+				pixel.b = next();
+			} else if (op == qoi::eRgba) {
+				if (!has(4)) { return {}; }
+				pixel.r = next();
+				pixel.g = next();
+				pixel.b = next();
+				pixel.a = next();
+			} else if ((op & qoi::eMask) == qoi::eIndex) {
+				pixel = index.at(op);
+			} else if ((op & qoi::eMask) == qoi::eDiff) {
+				pixel.r = static_cast<std::uint8_t>(pixel.r + ((op >> 4) & 0x03) - 2);
+				pixel.g = static_cast<std::uint8_t>(pixel.g + ((op >> 2) & 0x03) - 2);
+				pixel.b = static_cast<std::uint8_t>(pixel.b + (op & 0x03) - 2);
+			} else if ((op & qoi::eMask) == qoi::eLuma) {
+				if (!has(1)) { return {}; }
+				auto const second = next();
+				auto const dg = (op & 0x3f) - 32;
+				pixel.r = static_cast<std::uint8_t>(pixel.r + dg - 8 + ((second >> 4) & 0x0f));
+				pixel.g = static_cast<std::uint8_t>(pixel.g + dg);
+				pixel.b = static_cast<std::uint8_t>(pixel.b + dg - 8 + (second & 0x0f));
+			} else {
+				run = op & 0x3f;
+			}
+			index.at(pixel.hash()) = pixel;
+		} else {
+			// truncated stream.
+			return {};
+		}
+		std::memcpy(&pixels[i * 4], &pixel, 4);
+	}
+
+	return std::make_unique<Bitmap>(std::move(pixels), glm::ivec2{width, height});
+}
+
+auto StbDecoder::decode(std::span<std::byte const> bytes) const -> std::unique_ptr<IBitmapViewSource> {
+	if (bytes.empty()) { return {}; }
+	auto extent = glm::ivec3{};
+	auto const* stbi_data = reinterpret_cast<stbi_uc const*>(bytes.data()); // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+	auto* ptr = stbi_load_from_memory(stbi_data, static_cast<int>(bytes.size_bytes()), &extent.x, &extent.y, &extent.z, 4);
+	if (ptr == nullptr) { return {}; }
+	return std::make_unique<StbBitmap>(ptr, glm::ivec2{extent});
+}
+} // namespace bave
@@ -1,36 +1,54 @@
-#include <stb/stb_image.h>
 #include <bave/graphics/image_file.hpp>
-#include <glm/vec3.hpp>
+#include <bave/graphics/raw_image.hpp>
+#include <array>
 
 namespace bave {
 struct ImageFile::Impl {
-	stbi_uc* stb_data{};
-	std::size_t size{};
-	glm::uvec2 extent{};
+	std::unique_ptr<IBitmapViewSource> decoded{};
+	std::string_view decoder{};
+	// set instead of decoded for RawImages.
+	DataView raw{};
 };
 
-void ImageFile::Deleter::operator()(Impl* ptr) const {
-	stbi_image_free(ptr->stb_data);
-	std::default_delete<Impl>{}(ptr);
+void ImageFile::Deleter::operator()(Impl* ptr) const { std::default_delete<Impl>{}(ptr); }
+
+auto ImageFile::get_default_decoders() -> Decoders {
+	static auto const qoi = QoiDecoder{};
+	static auto const png = PngDecoder{};
+	static auto const stb = StbDecoder{};
+	static auto const ret = std::array<Ptr<IImageDecoder const>, 3>{&qoi, &png, &stb};
+	return ret;
 }
 
-auto ImageFile::load_from_bytes(std::span<std::byte const> compressed) -> bool {
+auto ImageFile::load_from_bytes(std::span<std::byte const> compressed, Decoders const decoders) -> bool {
 	if (compressed.empty()) { return false; }
-	auto extent = glm::ivec3{};
-	auto const* stbi_data = reinterpret_cast<stbi_uc const*>(compressed.data()); // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
-	auto* ptr = stbi_load_from_memory(stbi_data, static_cast<int>(compressed.size_bytes()), &extent.x, &extent.y, &extent.z, 4);
-	if (ptr == nullptr) { return false; }
-	auto const size = static_cast<std::size_t>(extent.x * extent.y * 4);
-	m_impl = std::unique_ptr<Impl, Deleter>{new Impl{ptr, size, extent}};
+	if (!RawImage::view(compressed).bytes.empty()) { return load_from_bytes(DataView::from({compressed.begin(), compressed.end()})); }
+
+	for (auto const* decoder : decoders) {
+		if (decoder == nullptr || !decoder->can_decode(compressed)) { continue; }
+		auto decoded = decoder->decode(compressed);
+		if (!decoded) { continue; }
+		m_impl = std::unique_ptr<Impl, Deleter>{new Impl{.decoded = std::move(decoded), .decoder = decoder->get_name()}};
+		return true;
+	}
+	return false;
+}
+
+auto ImageFile::load_from_bytes(DataView bytes) -> bool {
+	auto const raw = RawImage::view(bytes);
+	if (raw.bytes.empty()) { return load_from_bytes(bytes.get_bytes()); }
+	m_impl = std::unique_ptr<Impl, Deleter>{new Impl{.decoder = "raw", .raw = std::move(bytes)}};
 	return true;
 }
 
 auto ImageFile::get_bitmap_view() const -> BitmapView {
 	if (!m_impl) { return {}; }
+	if (m_impl->raw) { return RawImage::view(m_impl->raw); }
+	return m_impl->decoded->get_bitmap_view();
+}
 
-	return BitmapView{
-		.bytes = {reinterpret_cast<std::byte const*>(m_impl->stb_data), m_impl->size}, // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
-		.extent = m_impl->extent,
-	};
+auto ImageFile::get_decoder_name() const -> std::string_view {
+	if (!m_impl) { return {}; }
+	return m_impl->decoder;
 }
 } // namespace bave
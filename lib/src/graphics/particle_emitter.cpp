@@ -32,11 +32,9 @@ void ParticleEmitter::respawn() {
 }
 
 void ParticleEmitter::tick(Seconds dt) {
-	refresh_particles(config.respawn || !m_ticked);
+	prepare_tick();
 	tick_particles(dt);
 	sync_instances();
-	set_shape(Quad{.size = config.quad_size});
-	m_ticked = true;
 }
 
 auto ParticleEmitter::make_particle() const -> Particle {
@@ -60,6 +58,17 @@ auto ParticleEmitter::make_particle() const -> Particle {
 	return ret;
 }
 
+void ParticleEmitter::prepare_tick() {
+	refresh_particles(config.respawn || !m_ticked);
+	// only regenerate geometry when the quad size changes, preserving the UV (set_uv() / set_tile()).
+	if (get_shape().size != config.quad_size) {
+		auto quad = get_shape();
+		quad.size = config.quad_size;
+		set_shape(quad);
+	}
+	m_ticked = true;
+}
+
 void ParticleEmitter::refresh_particles(bool const respawn) {
 	std::erase_if(m_particles, [](Particle const& p) { return p.elapsed >= p.ttl; });
 
@@ -68,13 +77,13 @@ void ParticleEmitter::refresh_particles(bool const respawn) {
 	}
 }
 
-void ParticleEmitter::tick_particles(Seconds const dt) {
+void ParticleEmitter::tick_particles(Seconds const dt, std::size_t const begin, std::size_t const end) {
 	auto const do_translate = modifiers.test(Modifier::eTranslate);
 	auto const do_rotate = modifiers.test(Modifier::eRotate);
 	auto const do_scale = modifiers.test(Modifier::eScale);
 	auto const do_tint = modifiers.test(Modifier::eTint);
 
-	for (auto& particle : m_particles) {
+	for (auto& particle : std::span{m_particles}.subspan(begin, end - begin)) {
 		particle.elapsed += dt;
 		auto const alpha = std::clamp(particle.elapsed / particle.ttl, 0.0f, 1.0f);
 		if (do_translate) { particle.translate(dt); }
@@ -92,4 +101,13 @@ void ParticleEmitter::sync_instances() {
 		instances.at(index) = RenderInstance{.transform = particle.transform, .tint = particle.tint};
 	}
 }
+
+void ParticleEmitter::bake_particles(std::span<RenderInstance::Baked> out, std::size_t const begin) const {
+	for (std::size_t index = 0; index < out.size(); ++index) {
+		auto const& particle = m_particles[begin + index];
+		auto transform = particle.transform;
+		transform.scale *= config.quad_size;
+		out[index] = RenderInstance{.transform = transform, .tint = particle.tint}.to_baked();
+	}
+}
 } // namespace bave
@@ -0,0 +1,103 @@
+#include <bave/graphics/particle_system.hpp>
+#include <bave/job_system.hpp>
+#include <algorithm>
+
+namespace bave {
+void ParticleSystem::draw(Shader& shader) const {
+	for (auto const& batch : m_batches) {
+		if (batch.count == 0) { continue; }
+		auto images = std::array<SamplerImage, Shader::max_textures_v>{};
+		for (std::size_t binding = 0; binding < batch.textures.size(); ++binding) {
+			if (auto const& texture = batch.textures.at(binding)) { images.at(binding) = texture->get_sampler_image(); }
+		}
+		shader.update_textures(images);
+		shader.draw(batch.quad.get_render_primitive(), std::span{m_baked}.subspan(batch.offset, batch.count));
+	}
+}
+
+auto ParticleSystem::make_unit_quad(UvRect const& uv) -> QuadShape {
+	auto ret = QuadShape{};
+	ret.set_shape(Quad{.size = glm::vec2{1.0f}, .uv = uv});
+	return ret;
+}
+
+void ParticleSystem::do_tick(Seconds const dt, Ptr<JobSystem> job_system) {
+	auto const for_each = [job_system](std::size_t const count, JobSystem::RangeFunc const& func) {
+		if (job_system == nullptr) {
+			func(0, count);
+			return;
+		}
+		job_system->parallel_for(count, func, 1);
+	};
+
+	// spawning and expiring particles is serial within an emitter.
+	for_each(emitters.size(), [this](std::size_t const begin, std::size_t const end) {
+		for (auto index = begin; index < end; ++index) { emitters[index].prepare_tick(); }
+	});
+
+	build_batches();
+
+	// simulate and bake each chunk straight into its slot of the shared buffer.
+	for_each(m_chunks.size(), [this, dt](std::size_t const begin, std::size_t const end) {
+		for (auto const& chunk : std::span{m_chunks}.subspan(begin, end - begin)) {
+			auto& emitter = emitters[chunk.emitter];
+			emitter.tick_particles(dt, chunk.begin, chunk.end);
+			emitter.bake_particles(std::span{m_baked}.subspan(chunk.offset, chunk.end - chunk.begin), chunk.begin);
+		}
+	});
+}
+
+void ParticleSystem::build_batches() {
+	std::swap(m_batches, m_previous_batches);
+	m_batches.clear();
+	m_emitter_batches.clear();
+	m_chunks.clear();
+
+	auto capacity = std::size_t{};
+	for (auto const& emitter : emitters) {
+		// emitters draw a sprite: its UV (set_uv() / set_tile()) selects the region of the texture.
+		auto const is_match = [&emitter](Batch const& batch) { return batch.textures == emitter.textures && batch.uv == emitter.get_uv(); };
+		auto it = std::ranges::find_if(m_batches, is_match);
+		if (it == m_batches.end()) {
+			m_batches.push_back(make_batch(emitter));
+			it = std::prev(m_batches.end());
+		}
+		it->count += emitter.active_particles();
+		m_emitter_batches.push_back(static_cast<std::size_t>(std::distance(m_batches.begin(), it)));
+		capacity += emitter.config.count;
+	}
+	// unmatched quads (and textures) are released.
+	m_previous_batches.clear();
+
+	auto total = std::size_t{};
+	for (auto& batch : m_batches) {
+		batch.offset = total;
+		total += batch.count;
+		batch.count = 0;
+	}
+	// pre-size for every emitter at full count, so that the buffer rarely reallocates.
+	m_baked.reserve(std::max(capacity, total));
+	m_baked.resize(total);
+
+	for (std::size_t index = 0; index < emitters.size(); ++index) {
+		auto& batch = m_batches[m_emitter_batches[index]];
+		auto const count = emitters[index].active_particles();
+		for (std::size_t begin = 0; begin < count; begin += chunk_size_v) {
+			auto const end = std::min(begin + chunk_size_v, count);
+			m_chunks.push_back(Chunk{.emitter = index, .begin = begin, .end = end, .offset = batch.offset + batch.count + begin});
+		}
+		batch.count += count;
+	}
+}
+
+auto ParticleSystem::make_batch(ParticleEmitter const& emitter) -> Batch {
+	auto ret = Batch{.textures = emitter.textures, .uv = emitter.get_uv()};
+	if (auto const it = std::ranges::find_if(m_previous_batches, [&ret](Batch const& batch) { return batch.uv == ret.uv; }); it != m_previous_batches.end()) {
+		ret.quad = std::move(it->quad);
+		m_previous_batches.erase(it);
+	} else {
+		ret.quad = make_unit_quad(ret.uv);
+	}
+	return ret;
+}
+} // namespace bave
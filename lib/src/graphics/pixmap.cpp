@@ -1,5 +1,10 @@
 #include <bave/core/error.hpp>
 #include <bave/graphics/pixmap.hpp>
+#include <glm/common.hpp>
+#include <algorithm>
+#include <numeric>
+#include <optional>
+#include <type_traits>
 #include <utility>
 
 namespace bave {
@@ -11,20 +16,272 @@ constexpr auto ceil_pot(int const size) -> int {
 }
 
 constexpr auto ceil_pot(glm::ivec2 const size) -> glm::ivec2 { return {ceil_pot(size.x), ceil_pot(size.y)}; }
+
+// Pixmap storage is reinterpreted as RGBA8 bytes.
+static_assert(sizeof(Rgba) == 4 && std::is_trivially_copyable_v<Rgba>);
+
+// each pixel is written as four bytes with no dependency across pixels: vectorized by the compiler.
+void expand_alpha(std::byte* dst, std::uint8_t const* alpha, std::size_t const count, Rgba const rgb) {
+	auto const r = static_cast<std::byte>(rgb.channels.x);
+	auto const g = static_cast<std::byte>(rgb.channels.y);
+	auto const b = static_cast<std::byte>(rgb.channels.z);
+	// NOLINTBEGIN(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+	for (std::size_t i = 0; i < count; ++i) {
+		dst[i * 4] = r;
+		dst[i * 4 + 1] = g;
+		dst[i * 4 + 2] = b;
+		dst[i * 4 + 3] = static_cast<std::byte>(alpha[i]);
+	}
+	// NOLINTEND(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+}
+
+namespace pack {
+struct Result {
+	// left-top of each sub-image.
+	std::vector<glm::ivec2> placements{};
+	// includes trailing padding.
+	glm::ivec2 used{};
+};
+
+// rows left to right, top to bottom; rows are separated by 2 * pad.y (as the original single-pass layout).
+auto shelf(std::span<glm::ivec2 const> sizes, std::span<std::size_t const> order, int const max_width, glm::ivec2 const pad) -> Result {
+	auto ret = Result{.placements = std::vector<glm::ivec2>(sizes.size())};
+	auto cursor = pad;
+	auto line_height = 0;
+	for (auto const index : order) {
+		auto const size = sizes[index];
+		if (cursor.x > pad.x && cursor.x + size.x + pad.x >= max_width) {
+			cursor.x = pad.x;
+			cursor.y += line_height + 2 * pad.y;
+			line_height = 0;
+		}
+		ret.placements[index] = cursor;
+		line_height = std::max(line_height, size.y);
+		cursor.x += size.x + pad.x;
+		ret.used.x = std::max(ret.used.x, cursor.x);
+		ret.used.y = std::max(ret.used.y, cursor.y + line_height + pad.y);
+	}
+	return ret;
+}
+
+// Packers below work on cells (sub-image + pad) in a bin offset by pad, so every sub-image has pad on all sides.
+struct Cell {
+	int x{};
+	int y{};
+	int w{};
+	int h{};
+
+	[[nodiscard]] constexpr auto contains(Cell const& o) const -> bool { return o.x >= x && o.y >= y && o.x + o.w <= x + w && o.y + o.h <= y + h; }
+	[[nodiscard]] constexpr auto overlaps(Cell const& o) const -> bool { return o.x < x + w && x < o.x + o.w && o.y < y + h && y < o.y + o.h; }
+};
+
+struct Candidate {
+	Cell cell{};
+	std::size_t slot{};
+	bool found{};
+
+	// lowest bottom edge, then leftmost.
+	[[nodiscard]] auto is_better(Cell const& other) const -> bool {
+		if (!found) { return true; }
+		if (other.y + other.h != cell.y + cell.h) { return other.y + other.h < cell.y + cell.h; }
+		return other.x < cell.x;
+	}
+};
+
+class Skyline {
+  public:
+	explicit Skyline(int const width) : m_width(width) { m_nodes.push_back(Cell{.w = width}); }
+
+	[[nodiscard]] auto find(glm::ivec2 const size, glm::ivec2 const pad) const -> Candidate {
+		auto ret = Candidate{};
+		auto const cell_size = size + pad;
+		for (std::size_t i = 0; i < m_nodes.size(); ++i) {
+			auto const y = fit(i, cell_size.x);
+			if (y < 0) { continue; }
+			auto const cell = Cell{.x = m_nodes[i].x, .y = y, .w = cell_size.x, .h = cell_size.y};
+			if (ret.is_better(cell)) { ret = Candidate{.cell = cell, .slot = i, .found = true}; }
+		}
+		return ret;
+	}
+
+	void place(Candidate const& candidate) {
+		auto const& cell = candidate.cell;
+		auto const index = static_cast<std::ptrdiff_t>(candidate.slot);
+		m_nodes.insert(m_nodes.begin() + index, Cell{.x = cell.x, .y = cell.y + cell.h, .w = cell.w});
+		auto const right = cell.x + cell.w;
+		for (auto it = m_nodes.begin() + index + 1; it != m_nodes.end() && it->x < right;) {
+			auto const shrink = right - it->x;
+			if (shrink < it->w) {
+				it->x += shrink;
+				it->w -= shrink;
+				break;
+			}
+			it = m_nodes.erase(it);
+		}
+		for (std::size_t i = 1; i < m_nodes.size();) {
+			if (m_nodes[i - 1].y == m_nodes[i].y) {
+				m_nodes[i - 1].w += m_nodes[i].w;
+				m_nodes.erase(m_nodes.begin() + static_cast<std::ptrdiff_t>(i));
+			} else {
+				++i;
+			}
+		}
+	}
+
+  private:
+	// returns the lowest y a cell of width can rest at, starting at node index, or -1 if it does not fit.
+	[[nodiscard]] auto fit(std::size_t index, int const width) const -> int {
+		if (m_nodes[index].x + width > m_width) { return -1; }
+		auto ret = 0;
+		for (auto remain = width; remain > 0 && index < m_nodes.size(); ++index) {
+			ret = std::max(ret, m_nodes[index].y);
+			remain -= m_nodes[index].w;
+		}
+		return ret;
+	}
+
+	int m_width{};
+	std::vector<Cell> m_nodes{};
+};
+
+class MaxRects {
+  public:
+	explicit MaxRects(int const width, int const height) { m_free.push_back(Cell{.w = width, .h = height}); }
+
+	[[nodiscard]] auto find(glm::ivec2 const size, glm::ivec2 const pad) const -> Candidate {
+		auto ret = Candidate{};
+		auto const cell_size = size + pad;
+		for (auto const& free : m_free) {
+			if (cell_size.x > free.w || cell_size.y > free.h) { continue; }
+			auto const cell = Cell{.x = free.x, .y = free.y, .w = cell_size.x, .h = cell_size.y};
+			if (ret.is_better(cell)) { ret = Candidate{.cell = cell, .found = true}; }
+		}
+		return ret;
+	}
+
+	void place(Candidate const& candidate) {
+		auto const& used = candidate.cell;
+		auto split = std::vector<Cell>{};
+		std::erase_if(m_free, [&](Cell const& free) {
+			if (!free.overlaps(used)) { return false; }
+			if (used.x > free.x) { split.push_back(Cell{.x = free.x, .y = free.y, .w = used.x - free.x, .h = free.h}); }
+			if (used.x + used.w < free.x + free.w) {
+				split.push_back(Cell{.x = used.x + used.w, .y = free.y, .w = free.x + free.w - used.x - used.w, .h = free.h});
+			}
+			if (used.y > free.y) { split.push_back(Cell{.x = free.x, .y = free.y, .w = free.w, .h = used.y - free.y}); }
+			if (used.y + used.h < free.y + free.h) {
+				split.push_back(Cell{.x = free.x, .y = used.y + used.h, .w = free.w, .h = free.y + free.h - used.y - used.h});
+			}
+			return true;
+		});
+		m_free.insert(m_free.end(), split.begin(), split.end());
+		prune();
+	}
+
+  private:
+	// remove free rects contained in others.
+	void prune() {
+		for (std::size_t i = 0; i < m_free.size(); ++i) {
+			for (std::size_t j = i + 1; j < m_free.size();) {
+				if (m_free[i].contains(m_free[j])) {
+					m_free.erase(m_free.begin() + static_cast<std::ptrdiff_t>(j));
+					continue;
+				}
+				if (m_free[j].contains(m_free[i])) {
+					m_free.erase(m_free.begin() + static_cast<std::ptrdiff_t>(i));
+					--i;
+					break;
+				}
+				++j;
+			}
+		}
+	}
+
+	std::vector<Cell> m_free{};
+};
+
+template <typename Packer>
+auto pack(Packer packer, std::span<glm::ivec2 const> sizes, std::span<std::size_t const> order, glm::ivec2 const pad) -> std::optional<Result> {
+	auto ret = Result{.placements = std::vector<glm::ivec2>(sizes.size())};
+	auto bottom_right = glm::ivec2{};
+	for (auto const index : order) {
+		auto const candidate = packer.find(sizes[index], pad);
+		if (!candidate.found) { return {}; }
+		packer.place(candidate);
+		auto const& cell = candidate.cell;
+		ret.placements[index] = glm::ivec2{cell.x, cell.y} + pad;
+		bottom_right = glm::max(bottom_right, glm::ivec2{cell.x + cell.w, cell.y + cell.h});
+	}
+	ret.used = bottom_right + pad;
+	return ret;
+}
+} // namespace pack
 } // namespace
 
 Pixmap::Pixmap(glm::ivec2 const size, Rgba const background) : m_extent(size), m_pixels(static_cast<std::size_t>(m_extent.x * m_extent.y), background) {}
 
+auto Pixmap::from_alpha(std::span<std::uint8_t const> alpha, glm::ivec2 const extent, int const stride, Rgba const rgb) -> Pixmap {
+	if (extent.x <= 0 || extent.y <= 0 || stride < extent.x) { return Pixmap{glm::ivec2{}}; }
+	auto const required = static_cast<std::size_t>((extent.y - 1) * stride + extent.x);
+	if (alpha.size() < required) { return Pixmap{glm::ivec2{}}; }
+
+	auto ret = Pixmap{extent, blank_v};
+	auto* dst = reinterpret_cast<std::byte*>(ret.m_pixels.data()); // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+	auto const width = static_cast<std::size_t>(extent.x);
+	if (stride == extent.x) {
+		expand_alpha(dst, alpha.data(), ret.m_pixels.size(), rgb);
+		return ret;
+	}
+	for (int row = 0; row < extent.y; ++row) {
+		auto const src = alpha.subspan(static_cast<std::size_t>(row * stride), width);
+		expand_alpha(dst + static_cast<std::size_t>(row) * width * 4, src.data(), width, rgb); // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+	}
+	return ret;
+}
+
 auto Pixmap::overwrite(Pixmap const& source, Index2D const left_top) -> bool {
 	auto const rb = Index2D{left_top.x + source.m_extent.x, left_top.y + source.m_extent.y};
-	if (rb.x > m_extent.x || rb.y > m_extent.y) { return false; }
+	if (left_top.x < 0 || left_top.y < 0 || rb.x > m_extent.x || rb.y > m_extent.y) { return false; }
 
+	auto const width = static_cast<std::size_t>(source.m_extent.x);
+	if (width == static_cast<std::size_t>(m_extent.x)) {
+		// full width: rows are contiguous in both.
+		std::copy(source.m_pixels.begin(), source.m_pixels.end(), get_row(left_top.y).begin());
+		return true;
+	}
 	for (int row = 0; row < source.m_extent.y; ++row) {
-		for (int col = 0; col < source.m_extent.x; ++col) { at({col + left_top.x, row + left_top.y}) = source.at({col, row}); }
+		auto const src = source.get_row(row);
+		std::copy(src.begin(), src.end(), get_row(left_top.y + row).subspan(static_cast<std::size_t>(left_top.x)).begin());
 	}
 	return true;
 }
 
+void Pixmap::fill(Rgba const rgba) { std::fill(m_pixels.begin(), m_pixels.end(), rgba); }
+
+auto Pixmap::fill(Rgba const rgba, Rect<int> const& rect) -> bool {
+	if (rect.lt.x < 0 || rect.lt.y < 0 || rect.rb.x > m_extent.x || rect.rb.y > m_extent.y) { return false; }
+	if (rect.rb.x <= rect.lt.x || rect.rb.y <= rect.lt.y) { return true; }
+
+	auto const width = static_cast<std::size_t>(rect.rb.x - rect.lt.x);
+	for (int row = rect.lt.y; row < rect.rb.y; ++row) {
+		auto const dst = get_row(row).subspan(static_cast<std::size_t>(rect.lt.x), width);
+		std::fill(dst.begin(), dst.end(), rgba);
+	}
+	return true;
+}
+
+auto Pixmap::get_row(int const row) const -> std::span<Rgba const> {
+	if (row < 0 || row >= m_extent.y) { return {}; }
+	auto const width = static_cast<std::size_t>(m_extent.x);
+	return std::span{m_pixels}.subspan(static_cast<std::size_t>(row) * width, width);
+}
+
+auto Pixmap::get_row(int const row) -> std::span<Rgba> {
+	if (row < 0 || row >= m_extent.y) { return {}; }
+	auto const width = static_cast<std::size_t>(m_extent.x);
+	return std::span{m_pixels}.subspan(static_cast<std::size_t>(row) * width, width);
+}
+
 auto Pixmap::at(Index2D index) const -> Rgba const& {
 	auto const idx = static_cast<std::size_t>(index.flatten(m_extent.x));
 	if (idx >= m_pixels.size()) { throw Error{"Out of bounds index: '{}x{}'", index.x, index.y}; }
@@ -35,51 +292,84 @@ auto Pixmap::at(Index2D index) -> Rgba& {
 	return const_cast<Rgba&>(std::as_const(*this).at(index)); // NOLINT(cppcoreguidelines-pro-type-const-cast)
 }
 
+auto Pixmap::get_bitmap_view() const -> BitmapView { return BitmapView{.bytes = std::as_bytes(std::span{m_pixels}), .extent = m_extent}; }
+
 auto Pixmap::make_bitmap() const -> Bitmap {
-	auto bytes = std::vector<std::byte>{};
-	bytes.reserve(m_pixels.size() * 4);
-	for (auto const& pixel : m_pixels) {
-		auto const pix_bytes = pixel.to_bytes();
-		bytes.insert(bytes.end(), pix_bytes.begin(), pix_bytes.end());
-	}
-	return Bitmap{std::move(bytes), m_extent};
+	auto const bytes = std::as_bytes(std::span{m_pixels});
+	return Bitmap{std::vector<std::byte>{bytes.begin(), bytes.end()}, m_extent};
 }
 
-Pixmap::Builder::Builder(int max_width, glm::ivec2 pad) : m_max_width(max_width > min_width_v ? ceil_pot(max_width) : min_width_v), m_pad(pad) {
-	m_data.cursor = m_pad;
+auto Pixmap::make_alpha() const -> std::vector<std::uint8_t> {
+	auto ret = std::vector<std::uint8_t>(m_pixels.size());
+	std::transform(m_pixels.begin(), m_pixels.end(), ret.begin(), [](Rgba const& rgba) { return rgba.channels.w; });
+	return ret;
 }
 
+Pixmap::Builder::Builder(int const max_width, glm::ivec2 const pad, Layout const& layout)
+	: m_max_width(max_width > min_width_v ? ceil_pot(max_width) : min_width_v), m_pad(pad), m_layout(layout) {}
+
 void Pixmap::Builder::add(Id id, Pixmap pixmap) {
 	if (pixmap.m_pixels.empty()) { return; }
-
-	if (m_data.cursor.x + pixmap.m_extent.x + m_pad.x >= m_max_width) { line_break(); }
-
-	auto const lt = m_data.cursor;
-	auto const rb = lt + pixmap.m_extent;
-	m_data.line_height = std::max(m_data.line_height, pixmap.m_extent.y);
-	m_entries.push_back(Entry{.pixmap = std::move(pixmap), .rect = {.lt = lt, .rb = rb}, .id = id});
-	m_data.cursor.x += pixmap.m_extent.x + m_pad.x;
-	m_data.size.x = std::max(m_data.size.x, m_data.cursor.x);
-	m_data.size.y = std::max(m_data.size.y, m_data.current_height + m_data.line_height + m_pad.y);
+	m_entries.push_back(Entry{.pixmap = std::move(pixmap), .id = id});
 }
 
 auto Pixmap::Builder::build(Rgba const background) const -> Atlas {
 	if (m_entries.empty()) { return {}; }
+
+	auto sizes = std::vector<glm::ivec2>{};
+	sizes.reserve(m_entries.size());
+	for (auto const& entry : m_entries) { sizes.push_back(entry.pixmap.m_extent); }
+
+	auto order = std::vector<std::size_t>(m_entries.size());
+	std::iota(order.begin(), order.end(), std::size_t{});
+	if (m_layout.sort_by_height) {
+		std::stable_sort(order.begin(), order.end(), [&](std::size_t const a, std::size_t const b) { return sizes[a].y > sizes[b].y; });
+	}
+
+	auto result = std::optional<pack::Result>{};
+	if (m_layout.packing == Packing::eShelf) {
+		result = pack::shelf(sizes, order, m_max_width, m_pad);
+	} else {
+		// search power-of-two widths for the smallest (then squarest) power-of-two atlas.
+		auto widest = 0;
+		auto total_height = 0;
+		for (auto const size : sizes) {
+			widest = std::max(widest, size.x);
+			total_height += size.y + m_pad.y;
+		}
+		auto const limit = std::max(m_max_width, ceil_pot(widest + 2 * m_pad.x));
+		auto best_extent = glm::ivec2{};
+		for (auto width = min_width_v; width <= limit; width <<= 1) {
+			auto const bin_width = width - m_pad.x;
+			auto attempt = m_layout.packing == Packing::eSkyline ? pack::pack(pack::Skyline{bin_width}, sizes, order, m_pad)
+																 : pack::pack(pack::MaxRects{bin_width, total_height}, sizes, order, m_pad);
+			if (!attempt) { continue; }
+			auto const extent = ceil_pot(attempt->used);
+			auto const area = std::int64_t{extent.x} * extent.y;
+			auto const best_area = std::int64_t{best_extent.x} * best_extent.y;
+			if (!result || area < best_area || (area == best_area && std::max(extent.x, extent.y) < std::max(best_extent.x, best_extent.y))) {
+				result = std::move(attempt);
+				best_extent = extent;
+			}
+		}
+	}
+	if (!result) { return {}; }
+
 	auto ret = Atlas{};
-	ret.pixmap = Pixmap{ceil_pot(m_data.size), background};
+	ret.pixmap = Pixmap{ceil_pot(result->used), background};
 	auto const fsize = glm::vec2{ret.pixmap.m_extent};
-	for (auto const& entry : m_entries) {
-		ret.pixmap.overwrite(entry.pixmap, {entry.rect.lt.x, entry.rect.lt.y});
-		auto const fu = glm::vec2{entry.rect.top_left()} / fsize;
-		auto const fv = glm::vec2{entry.rect.bottom_right()} / fsize;
+	for (std::size_t i = 0; i < m_entries.size(); ++i) {
+		auto const& entry = m_entries[i];
+		auto const lt = result->placements[i];
+		auto const extent = entry.pixmap.m_extent;
+		ret.pixmap.overwrite(entry.pixmap, {lt.x, lt.y});
+		auto const fu = glm::vec2{lt} / fsize;
+		auto const fv = glm::vec2{lt + extent} / fsize;
 		ret.uvs.insert_or_assign(entry.id, UvRect{.lt = fu, .rb = fv});
+		ret.stats.used_pixels += std::int64_t{extent.x} * extent.y;
 	}
+	ret.stats.count = m_entries.size();
+	ret.stats.total_pixels = std::int64_t{ret.pixmap.m_extent.x} * ret.pixmap.m_extent.y;
 	return ret;
 }
-
-void Pixmap::Builder::line_break() {
-	m_data.cursor.x = m_pad.x;
-	m_data.cursor.y += m_data.line_height + 2 * m_pad.y;
-	m_data.current_height = m_data.cursor.y;
-}
 } // namespace bave
@@ -0,0 +1,44 @@
+#include <bave/graphics/raw_image.hpp>
+#include <algorithm>
+#include <array>
+
+namespace bave {
+namespace {
+constexpr auto magic_v = std::array{std::byte{'B'}, std::byte{'V'}, std::byte{'R'}, std::byte{'I'}};
+
+void write_u32(std::span<std::byte> out, std::uint32_t const value) {
+	for (std::size_t i = 0; i < 4; ++i) { out[i] = static_cast<std::byte>((value >> (i * 8)) & 0xff); }
+}
+
+auto read_u32(std::span<std::byte const> in) -> std::uint32_t {
+	auto ret = std::uint32_t{};
+	for (std::size_t i = 0; i < 4; ++i) { ret |= static_cast<std::uint32_t>(in[i]) << (i * 8); }
+	return ret;
+}
+} // namespace
+
+auto RawImage::encode(BitmapView const bitmap) -> std::vector<std::byte> {
+	if (bitmap.extent.x <= 0 || bitmap.extent.y <= 0) { return {}; }
+	auto const size = static_cast<std::size_t>(bitmap.extent.x) * static_cast<std::size_t>(bitmap.extent.y) * 4;
+	if (bitmap.bytes.size() != size) { return {}; }
+
+	auto ret = std::vector<std::byte>(header_size_v + size);
+	auto const header = std::span{ret}.first(header_size_v);
+	std::copy(magic_v.begin(), magic_v.end(), header.begin());
+	write_u32(header.subspan(4), version_v);
+	write_u32(header.subspan(8), static_cast<std::uint32_t>(bitmap.extent.x));
+	write_u32(header.subspan(12), static_cast<std::uint32_t>(bitmap.extent.y));
+	std::copy(bitmap.bytes.begin(), bitmap.bytes.end(), ret.begin() + header_size_v);
+	return ret;
+}
+
+auto RawImage::view(std::span<std::byte const> bytes) -> BitmapView {
+	if (bytes.size() < header_size_v || !std::equal(magic_v.begin(), magic_v.end(), bytes.begin())) { return {}; }
+	if (read_u32(bytes.subspan(4)) != version_v) { return {}; }
+	auto const width = read_u32(bytes.subspan(8));
+	auto const height = read_u32(bytes.subspan(12));
+	auto const size = static_cast<std::size_t>(width) * static_cast<std::size_t>(height) * 4;
+	if (width == 0 || height == 0 || bytes.size() - header_size_v != size) { return {}; }
+	return BitmapView{.bytes = bytes.subspan(header_size_v), .extent = {static_cast<int>(width), static_cast<int>(height)}};
+}
+} // namespace bave
@@ -22,9 +22,11 @@ auto make_vma(vk::Instance instance, vk::PhysicalDevice physical_device, vk::Dev
 	return ret;
 }
 
-constexpr auto image_count(vk::SurfaceCapabilitiesKHR const& caps) noexcept -> std::uint32_t {
-	if (caps.maxImageCount < caps.minImageCount) { return std::max(3u, caps.minImageCount); }
-	return std::clamp(3u, caps.minImageCount, caps.maxImageCount);
+constexpr auto image_count(vk::SurfaceCapabilitiesKHR const& caps, std::uint32_t const frames_in_flight) noexcept -> std::uint32_t {
+	// one more image than frames in flight, so acquire doesn't block on presentation.
+	auto const desired = std::max(3u, frames_in_flight + 1);
+	if (caps.maxImageCount < caps.minImageCount) { return std::max(desired, caps.minImageCount); }
+	return std::clamp(desired, caps.minImageCount, caps.maxImageCount);
 }
 
 constexpr auto image_extent(vk::SurfaceCapabilitiesKHR const& caps, vk::Extent2D const fb) noexcept -> vk::Extent2D {
@@ -67,26 +69,36 @@ RenderDevice::RenderDevice(NotNull<detail::IWsi*> wsi, CreateInfo create_info) :
 		m_log.info("Vulkan Validation Layers loaded");
 	}
 
-	m_surface = vk::UniqueSurfaceKHR{wsi->make_surface(*m_instance), *m_instance};
-	if (!m_surface) { throw Error{"Failed to create Vulkan Surface"}; }
+	if (!wsi->is_headless()) {
+		m_surface = vk::UniqueSurfaceKHR{wsi->make_surface(*m_instance), *m_instance};
+		if (!m_surface) { throw Error{"Failed to create Vulkan Surface"}; }
+	}
 
 	auto device_builder = detail::DeviceBuilder{*m_instance, *m_surface};
 	m_gpu = m_wsi->select_gpu(device_builder.get_gpus());
 	m_samples = sample_count(m_gpu.device.getProperties().limits.sampledImageColorSampleCounts, create_info.desired_samples);
+	m_frame_index.count = std::clamp(std::size_t{create_info.frames_in_flight}, std::size_t{1}, detail::max_buffering_v);
 
 	auto device = device_builder.build();
 	if (!device.device) { throw Error{"Failed to create Vulkan Device"}; }
 	m_device = std::move(device.device);
 	m_queue = device.queue;
+	m_command_pools = std::make_unique<detail::CommandPools>(get_device(), m_gpu.queue_family);
 
 	m_allocator = {make_vma(get_instance(), get_gpu().device, get_device())};
 
-	m_swapchain.present_modes = get_gpu().device.getSurfacePresentModesKHR(get_surface());
-	m_swapchain.formats = detail::Swapchain::Formats::make(get_gpu().device.getSurfaceFormatsKHR(get_surface()));
-	m_swapchain.make_create_info(*m_surface, m_gpu.queue_family, create_info.swapchain_colour_space);
-	m_swapchain.create_info.compositeAlpha = composite_alpha(get_gpu().device.getSurfaceCapabilitiesKHR(get_surface()));
-
-	recreate_swapchain(wsi->get_framebuffer_extent());
+	if (is_headless()) {
+		auto const srgb = create_info.swapchain_colour_space == detail::ColourSpace::eSrgb;
+		m_swapchain.create_info.imageFormat = srgb ? vk::Format::eR8G8B8A8Srgb : vk::Format::eR8G8B8A8Unorm;
+		recreate_offscreen(wsi->get_framebuffer_extent());
+	} else {
+		m_swapchain.present_modes = get_gpu().device.getSurfacePresentModesKHR(get_surface());
+		m_swapchain.formats = detail::Swapchain::Formats::make(get_gpu().device.getSurfaceFormatsKHR(get_surface()));
+		m_swapchain.make_create_info(*m_surface, m_gpu.queue_family, create_info.swapchain_colour_space);
+		m_swapchain.create_info.compositeAlpha = composite_alpha(get_gpu().device.getSurfaceCapabilitiesKHR(get_surface()));
+
+		recreate_swapchain(wsi->get_framebuffer_extent());
+	}
 
 	m_buffer_cache = std::make_unique<detail::BufferCache>(this);
 	m_image_cache = std::make_unique<detail::ImageCache>(this);
@@ -100,6 +112,31 @@ RenderDevice::RenderDevice(NotNull<detail::IWsi*> wsi, CreateInfo create_info) :
 	m_log.info("using MSAA: {}x", static_cast<int>(m_samples));
 }
 
+auto RenderDevice::is_sampled_format_supported(vk::Format const format) const -> bool {
+	auto const features = m_gpu.device.getFormatProperties(format).optimalTilingFeatures;
+	return (features & vk::FormatFeatureFlagBits::eSampledImage) == vk::FormatFeatureFlagBits::eSampledImage;
+}
+
+auto RenderDevice::is_linear_filter_supported(vk::Format const format) const -> bool {
+	static constexpr auto required_v =
+		vk::FormatFeatureFlagBits::eBlitSrc | vk::FormatFeatureFlagBits::eBlitDst | vk::FormatFeatureFlagBits::eSampledImageFilterLinear;
+	auto const features = m_gpu.device.getFormatProperties(format).optimalTilingFeatures;
+	return (features & required_v) == required_v;
+}
+
+auto RenderDevice::get_memory_usage() const -> MemoryUsage {
+	VkPhysicalDeviceMemoryProperties const* properties{};
+	vmaGetMemoryProperties(m_allocator.get(), &properties);
+	auto budgets = std::array<VmaBudget, VK_MAX_MEMORY_HEAPS>{};
+	vmaGetHeapBudgets(m_allocator.get(), budgets.data());
+	auto ret = MemoryUsage{};
+	for (std::uint32_t i = 0; i < properties->memoryHeapCount; ++i) {
+		ret.used += budgets.at(i).usage;
+		ret.budget += budgets.at(i).budget;
+	}
+	return ret;
+}
+
 auto RenderDevice::project_to(glm::vec2 const target_space, glm::vec2 const fb_point) const -> glm::vec2 {
 	return Projector{.source = get_framebuffer_size(), .target = target_space}.project(fb_point);
 }
@@ -133,6 +170,8 @@ auto RenderDevice::acquire_next_image(vk::Fence wait, vk::Semaphore signal) -> A
 	auto const framebuffer = m_wsi->get_framebuffer_extent();
 	if (framebuffer.width == 0 || framebuffer.height == 0) { return {}; }
 
+	if (is_headless()) { return acquire_offscreen(wait); }
+
 	static constexpr auto wait_timeout_v = std::chrono::nanoseconds{std::chrono::seconds{3}};
 	if (!reset_fence(wait, wait_timeout_v.count())) { throw Error{"failed to wait for render fence"}; }
 	m_defer_queue.next_frame();
@@ -172,6 +211,16 @@ auto RenderDevice::submit_and_present(vk::SubmitInfo const& submit_info, vk::Fen
 		return false;
 	}
 
+	if (is_headless()) {
+		auto const submitted = queue_submit(submit_info, draw_signal);
+		m_frame_index.increment();
+		m_swapchain.active.image_index.reset();
+		m_buffer_cache->next_frame();
+		m_image_cache->next_frame();
+		m_command_pools->next_frame();
+		return submitted;
+	}
+
 	auto pi = vk::PresentInfoKHR{};
 	pi.pImageIndices = &*m_swapchain.active.image_index;
 	pi.pSwapchains = &*m_swapchain.active.swapchain;
@@ -189,6 +238,8 @@ auto RenderDevice::submit_and_present(vk::SubmitInfo const& submit_info, vk::Fen
 
 	m_swapchain.active.image_index.reset();
 	m_buffer_cache->next_frame();
+	m_image_cache->next_frame();
+	m_command_pools->next_frame();
 
 	switch (result) {
 	case vk::Result::eSuccess:
@@ -201,6 +252,7 @@ auto RenderDevice::submit_and_present(vk::SubmitInfo const& submit_info, vk::Fen
 }
 
 auto RenderDevice::recreate_surface() -> bool {
+	if (is_headless()) { return false; }
 	if (m_swapchain.active.image_index.has_value()) {
 		m_log.error("cannot recreate surface in the middle of a render pass");
 		return false;
@@ -222,7 +274,7 @@ auto RenderDevice::recreate_swapchain(vk::Extent2D framebuffer) -> bool {
 	auto const caps = get_gpu().device.getSurfaceCapabilitiesKHR(get_surface());
 	info.imageExtent = image_extent(caps, framebuffer);
 	info.presentMode = m_swapchain.desired_present_mode;
-	info.minImageCount = image_count(caps);
+	info.minImageCount = image_count(caps, get_frames_in_flight());
 	info.oldSwapchain = m_swapchain.active.swapchain.get();
 	auto new_swapchain = get_device().createSwapchainKHRUnique(info);
 
@@ -248,10 +300,58 @@ auto RenderDevice::recreate_swapchain(vk::Extent2D framebuffer) -> bool {
 	}
 
 	m_swapchain.active.image_index.reset();
+	++m_swapchain.generation;
+
+	m_log.info("swapchain extent: [{}x{}] | images: [{}] | frames in flight: [{}] | colour space: [{}] | vsync: [{}]",
+			   m_swapchain.create_info.imageExtent.width, m_swapchain.create_info.imageExtent.height, m_swapchain.active.render_targets.size(),
+			   get_frames_in_flight(), detail::Swapchain::is_srgb_format(info.imageFormat) ? "sRGB" : "linear", to_vsync_string(info.presentMode));
+
+	return true;
+}
+
+auto RenderDevice::read_offscreen() const -> std::optional<Bitmap> {
+	if (!m_offscreen) { return {}; }
+	get_device().waitIdle();
+	return m_offscreen->read_back();
+}
+
+auto RenderDevice::acquire_offscreen(vk::Fence const wait) -> AcquireResult {
+	static constexpr auto wait_timeout_v = std::chrono::nanoseconds{std::chrono::seconds{3}};
+	if (!reset_fence(wait, wait_timeout_v.count())) { throw Error{"failed to wait for render fence"}; }
+	m_defer_queue.next_frame();
+
+	auto const framebuffer = m_wsi->get_framebuffer_extent();
+	if (framebuffer != m_swapchain.create_info.imageExtent) { recreate_offscreen(framebuffer); }
+
+	// single image: submissions are executed in order, and read_offscreen() waits for idle.
+	m_swapchain.active.image_index = 0;
+	return detail::RenderTarget{
+		.swapchain = m_offscreen->get_image_view(),
+		.extent = m_swapchain.create_info.imageExtent,
+		.format = m_swapchain.create_info.imageFormat,
+	};
+}
+
+auto RenderDevice::recreate_offscreen(vk::Extent2D const framebuffer) -> bool {
+	if (framebuffer.width <= 0 || framebuffer.height <= 0) { return false; }
+
+	if (m_offscreen) {
+		get_device().waitIdle();
+		m_offscreen->recreate(framebuffer);
+	} else {
+		auto const ici = detail::RenderImage::CreateInfo{
+			.format = m_swapchain.create_info.imageFormat,
+			.usage = vk::ImageUsageFlagBits::eColorAttachment | vk::ImageUsageFlagBits::eTransferSrc,
+			.layout = vk::ImageLayout::eTransferSrcOptimal,
+			.mip_map = false,
+		};
+		m_offscreen.emplace(this, ici, framebuffer);
+	}
+	m_swapchain.create_info.imageExtent = framebuffer;
+	++m_swapchain.generation;
 
-	m_log.info("swapchain extent: [{}x{}] | images: [{}] | colour space: [{}] | vsync: [{}]", m_swapchain.create_info.imageExtent.width,
-			   m_swapchain.create_info.imageExtent.height, m_swapchain.active.render_targets.size(),
-			   detail::Swapchain::is_srgb_format(info.imageFormat) ? "sRGB" : "linear", to_vsync_string(info.presentMode));
+	m_log.info("offscreen extent: [{}x{}] | colour space: [{}]", framebuffer.width, framebuffer.height,
+			   detail::Swapchain::is_srgb_format(m_swapchain.create_info.imageFormat) ? "sRGB" : "linear");
 
 	return true;
 }
@@ -0,0 +1,22 @@
+#include <bave/graphics/render_instance.hpp>
+#include <bave/job_system.hpp>
+
+namespace bave {
+namespace {
+// fewer instances than this per chunk are not worth the scheduling overhead.
+constexpr std::size_t bake_grain_v{1024};
+} // namespace
+
+void RenderInstance::fill_baked(std::vector<Baked>& out, std::span<RenderInstance const> instances, glm::mat4 const& parent, JobSystem& job_system) {
+	if (instances.size() <= bake_grain_v) {
+		fill_baked(out, instances, parent);
+		return;
+	}
+	auto const offset = out.size();
+	out.resize(offset + instances.size());
+	auto const baked = std::span{out}.subspan(offset);
+	job_system.parallel_for(instances.size(), [&](std::size_t const begin, std::size_t const end) {
+		for (auto index = begin; index < end; ++index) { baked[index] = instances[index].to_baked(parent); }
+	}, bake_grain_v);
+}
+} // namespace bave
@@ -0,0 +1,69 @@
+#include <bave/graphics/render_stats.hpp>
+#include <fmt/format.h>
+#include <algorithm>
+#include <iterator>
+
+namespace bave {
+namespace {
+void append_row(std::string& out, RenderStats const& stats) {
+	fmt::format_to(std::back_inserter(out), "{},{},{},{},{},{},{},{},{},{},{},{}", stats.frame, stats.draw_calls, stats.instances, stats.vertices,
+				   stats.pipeline_binds, stats.descriptor_sets, stats.descriptor_writes, stats.bytes_uploaded, stats.buffers, stats.images, stats.memory_used,
+				   stats.memory_budget);
+}
+} // namespace
+
+void RenderStats::add_counters(RenderStats const& rhs) {
+	draw_calls += rhs.draw_calls;
+	instances += rhs.instances;
+	vertices += rhs.vertices;
+	pipeline_binds += rhs.pipeline_binds;
+	descriptor_sets += rhs.descriptor_sets;
+	descriptor_writes += rhs.descriptor_writes;
+	bytes_uploaded += rhs.bytes_uploaded;
+}
+
+auto RenderStats::to_csv_row() const -> std::string {
+	auto ret = std::string{};
+	append_row(ret, *this);
+	return ret;
+}
+
+void RenderStatsHistory::set_capacity(std::size_t const capacity) {
+	std::rotate(m_frames.begin(), m_frames.begin() + static_cast<std::ptrdiff_t>(m_head), m_frames.end());
+	m_head = 0;
+	m_capacity = capacity;
+	if (m_frames.size() > m_capacity) { m_frames.erase(m_frames.begin(), m_frames.end() - static_cast<std::ptrdiff_t>(m_capacity)); }
+}
+
+void RenderStatsHistory::push(RenderStats const& stats) {
+	if (m_capacity == 0) { return; }
+	if (m_frames.size() < m_capacity) {
+		m_frames.push_back(stats);
+		return;
+	}
+	m_frames[m_head] = stats;
+	m_head = (m_head + 1) % m_frames.size();
+}
+
+auto RenderStatsHistory::get_frames() const -> std::vector<RenderStats> {
+	auto ret = std::vector<RenderStats>{};
+	ret.reserve(m_frames.size());
+	for (std::size_t i = 0; i < m_frames.size(); ++i) { ret.push_back(m_frames[(m_head + i) % m_frames.size()]); }
+	return ret;
+}
+
+void RenderStatsHistory::clear() {
+	m_frames.clear();
+	m_head = 0;
+}
+
+auto to_csv(std::span<RenderStats const> frames) -> std::string {
+	auto ret = std::string{RenderStats::csv_header_v};
+	ret += '\n';
+	for (auto const& stats : frames) {
+		append_row(ret, stats);
+		ret += '\n';
+	}
+	return ret;
+}
+} // namespace bave
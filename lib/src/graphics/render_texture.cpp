@@ -0,0 +1,69 @@
+#include <bave/core/is_positive.hpp>
+#include <bave/graphics/render_texture.hpp>
+#include <bave/graphics/renderer.hpp>
+
+namespace bave {
+namespace {
+auto make_image(RenderDevice& render_device, glm::ivec2 const size) -> std::shared_ptr<detail::RenderImage> {
+	auto const ici = detail::RenderImage::CreateInfo{
+		.format = Renderer::offscreen_format_v,
+		.usage = detail::RenderImage::CreateInfo::usage_v | vk::ImageUsageFlagBits::eColorAttachment,
+		.layout = vk::ImageLayout::eShaderReadOnlyOptimal,
+		.mip_map = false,
+	};
+	return render_device.get_image_cache().allocate(ici, detail::to_vk_extent(glm::max(size, glm::ivec2{1})));
+}
+} // namespace
+
+RenderTexture::RenderTexture(NotNull<Renderer const*> renderer, glm::ivec2 const size)
+	: Texture(&renderer->get_render_device(), make_image(renderer->get_render_device(), size)), m_renderer(renderer) {
+	sampler.wrap_s = sampler.wrap_t = Wrap::eClampEdge;
+	update_sampler();
+	render_view.viewport = get_size();
+	create_framebuffer();
+}
+
+RenderTexture::~RenderTexture() {
+	// moved-from instances have no framebuffer.
+	if (!m_framebuffer) { return; }
+	end_render();
+	m_render_device->get_defer_queue().push(std::move(m_framebuffer));
+}
+
+void RenderTexture::resize(glm::ivec2 const size) {
+	if (!is_positive(size) || size == get_size() || !m_image) { return; }
+	if (m_rendering) { end_render(); }
+
+	// the previous image and framebuffer may still be in use by in-flight frames.
+	m_render_device->get_defer_queue().push(std::move(m_image));
+	m_render_device->get_defer_queue().push(std::move(m_framebuffer));
+	m_image = make_image(*m_render_device, size);
+	render_view.viewport = get_size();
+	create_framebuffer();
+}
+
+auto RenderTexture::begin_render(Rgba const clear_colour) -> bool {
+	if (m_rendering || !m_framebuffer) { return false; }
+	m_rendering = m_renderer->begin_offscreen(**m_framebuffer, m_image->get_extent(), clear_colour, render_view);
+	return m_rendering;
+}
+
+void RenderTexture::end_render() {
+	if (!m_rendering) { return; }
+	m_renderer->end_offscreen();
+	m_rendering = false;
+}
+
+void RenderTexture::create_framebuffer() {
+	auto const image_view = m_image->get_image_view();
+	auto const extent = m_image->get_extent();
+	auto fci = vk::FramebufferCreateInfo{};
+	fci.renderPass = m_renderer->get_offscreen_render_pass();
+	fci.attachmentCount = 1;
+	fci.pAttachments = &image_view;
+	fci.width = extent.width;
+	fci.height = extent.height;
+	fci.layers = 1;
+	m_framebuffer = std::make_shared<vk::UniqueFramebuffer>(m_render_device->get_device().createFramebufferUnique(fci));
+}
+} // namespace bave
@@ -2,6 +2,10 @@
 #include <bave/core/visitor.hpp>
 #include <bave/graphics/detail/image_barrier.hpp>
 #include <bave/graphics/renderer.hpp>
+#include <bave/job_system.hpp>
+#include <bave/profiler.hpp>
+#include <algorithm>
+#include <atomic>
 
 namespace bave {
 namespace {
@@ -22,7 +26,14 @@ auto make_framebuffer(vk::Device device, vk::RenderPass render_pass, detail::Ren
 	return device.createFramebufferUnique(fci);
 }
 
-auto make_single_render_pass(vk::Device device, vk::Format colour, vk::SampleCountFlagBits samples) -> vk::UniqueRenderPass {
+void begin_secondary(vk::CommandBuffer const command_buffer, vk::RenderPass const render_pass, vk::Framebuffer const framebuffer) {
+	auto const cbii = vk::CommandBufferInheritanceInfo{render_pass, 0, framebuffer};
+	auto cbbi = vk::CommandBufferBeginInfo{vk::CommandBufferUsageFlagBits::eOneTimeSubmit | vk::CommandBufferUsageFlagBits::eRenderPassContinue};
+	cbbi.pInheritanceInfo = &cbii;
+	command_buffer.begin(cbbi);
+}
+
+auto make_single_render_pass(vk::Device device, vk::Format colour, vk::SampleCountFlagBits samples, vk::ImageLayout final_layout) -> vk::UniqueRenderPass {
 	auto rpci = vk::RenderPassCreateInfo{};
 
 	auto const attachment_refs = std::array{
@@ -40,7 +51,7 @@ auto make_single_render_pass(vk::Device device, vk::Format colour, vk::SampleCou
 	attachment_descs[0].loadOp = vk::AttachmentLoadOp::eClear;
 	attachment_descs[0].storeOp = vk::AttachmentStoreOp::eStore;
 	attachment_descs[0].initialLayout = vk::ImageLayout::eUndefined;
-	attachment_descs[0].finalLayout = vk::ImageLayout::ePresentSrcKHR;
+	attachment_descs[0].finalLayout = final_layout;
 	attachment_descs[0].samples = samples;
 
 	if (samples > vk::SampleCountFlagBits::e1) {
@@ -49,7 +60,7 @@ auto make_single_render_pass(vk::Device device, vk::Format colour, vk::SampleCou
 		attachment_descs[1].loadOp = vk::AttachmentLoadOp::eClear;
 		attachment_descs[1].storeOp = vk::AttachmentStoreOp::eStore;
 		attachment_descs[1].initialLayout = vk::ImageLayout::eUndefined;
-		attachment_descs[1].finalLayout = vk::ImageLayout::ePresentSrcKHR;
+		attachment_descs[1].finalLayout = final_layout;
 		attachment_descs[1].samples = vk::SampleCountFlagBits::e1;
 	}
 
@@ -69,6 +80,51 @@ auto make_single_render_pass(vk::Device device, vk::Format colour, vk::SampleCou
 	return device.createRenderPassUnique(rpci);
 }
 
+auto make_offscreen_render_pass(vk::Device device, vk::Format colour) -> vk::UniqueRenderPass {
+	auto const attachment_ref = vk::AttachmentReference{0, vk::ImageLayout::eColorAttachmentOptimal};
+	auto sd = vk::SubpassDescription{};
+	sd.pipelineBindPoint = vk::PipelineBindPoint::eGraphics;
+	sd.colorAttachmentCount = 1;
+	sd.pColorAttachments = &attachment_ref;
+
+	auto attachment_desc = vk::AttachmentDescription{};
+	attachment_desc.format = colour;
+	attachment_desc.loadOp = vk::AttachmentLoadOp::eClear;
+	attachment_desc.storeOp = vk::AttachmentStoreOp::eStore;
+	attachment_desc.initialLayout = vk::ImageLayout::eUndefined;
+	attachment_desc.finalLayout = vk::ImageLayout::eShaderReadOnlyOptimal;
+	attachment_desc.samples = vk::SampleCountFlagBits::e1;
+
+	// previous reads (by earlier frames) before writing, and writes before subsequent reads.
+	auto deps = std::array<vk::SubpassDependency, 2>{};
+	deps[0].srcSubpass = VK_SUBPASS_EXTERNAL;
+	deps[0].dstSubpass = 0;
+	deps[0].srcStageMask = vk::PipelineStageFlagBits::eFragmentShader;
+	deps[0].dstStageMask = vk::PipelineStageFlagBits::eColorAttachmentOutput;
+	deps[0].dstAccessMask = vk::AccessFlagBits::eColorAttachmentRead | vk::AccessFlagBits::eColorAttachmentWrite;
+	deps[1].srcSubpass = 0;
+	deps[1].dstSubpass = VK_SUBPASS_EXTERNAL;
+	deps[1].srcStageMask = vk::PipelineStageFlagBits::eColorAttachmentOutput;
+	deps[1].dstStageMask = vk::PipelineStageFlagBits::eFragmentShader;
+	deps[1].srcAccessMask = vk::AccessFlagBits::eColorAttachmentWrite;
+	deps[1].dstAccessMask = vk::AccessFlagBits::eShaderRead;
+
+	auto rpci = vk::RenderPassCreateInfo{};
+	rpci.pAttachments = &attachment_desc;
+	rpci.attachmentCount = 1;
+	rpci.pSubpasses = &sd;
+	rpci.subpassCount = 1;
+	rpci.pDependencies = deps.data();
+	rpci.dependencyCount = static_cast<std::uint32_t>(deps.size());
+
+	return device.createRenderPassUnique(rpci);
+}
+
+auto to_vk_clear_colour(Rgba const clear_colour) -> vk::ClearColorValue {
+	auto const linear = Rgba::to_linear(clear_colour.to_vec4());
+	return vk::ClearColorValue{linear.x, linear.y, linear.z, linear.w};
+}
+
 auto white_bitmap() -> BitmapView {
 	static constexpr auto pixels = std::array<std::uint8_t, 4>{0xff, 0xff, 0xff, 0xff};
 	// NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
@@ -83,7 +139,9 @@ auto Renderer::Frame::make(RenderDevice& render_device) -> Frame {
 
 	ret.make_syncs(device, render_device.get_gpu().queue_family);
 
-	ret.render_pass = make_single_render_pass(render_device.get_device(), render_device.get_swapchain_format(), render_device.get_sample_count());
+	// offscreen images are left ready to be read back.
+	auto const final_layout = render_device.is_headless() ? vk::ImageLayout::eTransferSrcOptimal : vk::ImageLayout::ePresentSrcKHR;
+	ret.render_pass = make_single_render_pass(render_device.get_device(), render_device.get_swapchain_format(), render_device.get_sample_count(), final_layout);
 
 	if (render_device.get_sample_count() > vk::SampleCountFlagBits::e1) {
 		auto const ici = detail::RenderImage::CreateInfo{
@@ -105,8 +163,11 @@ void Renderer::Frame::make_syncs(vk::Device device, std::uint32_t queue_family)
 	for (auto& sync : syncs) {
 		sync.command_pool = device.createCommandPoolUnique(
 			vk::CommandPoolCreateInfo{vk::CommandPoolCreateFlagBits::eTransient | vk::CommandPoolCreateFlagBits::eResetCommandBuffer, queue_family});
-		auto const cbai = vk::CommandBufferAllocateInfo{*sync.command_pool, vk::CommandBufferLevel::ePrimary, 1};
-		if (device.allocateCommandBuffers(&cbai, &sync.command_buffer) != vk::Result::eSuccess) { throw Error{"Failed to allocate Vulkan Command Buffer"}; }
+		auto const cbai = vk::CommandBufferAllocateInfo{*sync.command_pool, vk::CommandBufferLevel::ePrimary, 2};
+		auto command_buffers = std::array<vk::CommandBuffer, 2>{};
+		if (device.allocateCommandBuffers(&cbai, command_buffers.data()) != vk::Result::eSuccess) { throw Error{"Failed to allocate Vulkan Command Buffer"}; }
+		sync.command_buffer = command_buffers[0];
+		sync.offscreen_command_buffer = command_buffers[1];
 		sync.draw = device.createSemaphoreUnique({});
 		sync.present = device.createSemaphoreUnique({});
 		sync.drawn = device.createFenceUnique({vk::FenceCreateFlagBits::eSignaled});
@@ -116,10 +177,15 @@ void Renderer::Frame::make_syncs(vk::Device device, std::uint32_t queue_family)
 
 Renderer::Renderer(NotNull<RenderDevice*> render_device, NotNull<DataStore const*> data_store)
 	: m_render_device(render_device), m_frame(Frame::make(*m_render_device)),
-	  m_pipeline_cache(std::make_unique<detail::PipelineCache>(*m_frame.render_pass, render_device, data_store)), m_white(render_device, white_bitmap()),
-	  m_blocker(render_device->get_device()) {}
+	  m_pipeline_cache(std::make_unique<detail::PipelineCache>(*m_frame.render_pass, render_device, data_store)),
+	  m_gpu_profiler(std::make_unique<detail::GpuProfiler>(render_device)), m_white(render_device, white_bitmap()),
+	  m_blocker(render_device->get_device()) {
+	m_offscreen->render_pass = make_offscreen_render_pass(render_device->get_device(), offscreen_format_v);
+	m_recording->arenas.push_back(std::make_unique<detail::RecordArena>(render_device));
+}
 
 auto Renderer::start_render(Rgba const clear_colour) -> bool {
+	BAVE_PROFILE_SCOPE("acquire");
 	auto& sync = m_frame.syncs.at(get_frame_index());
 	auto const acquire_result = m_render_device->acquire_next_image(*sync.drawn, *sync.draw);
 	auto const visitor = Visitor{
@@ -139,21 +205,26 @@ auto Renderer::start_render(Rgba const clear_colour) -> bool {
 	}
 
 	m_pipeline_cache->get_descriptor_cache().next_frame();
+	for (auto& arena : m_recording->arenas) { arena->next_frame(); }
+	m_recording->segments.clear();
+	m_offscreen->recording = m_offscreen->active = false;
+	*m_frame_stats = RenderStats{.frame = m_stats.frame + 1};
 	sync.command_buffer.begin(vk::CommandBufferBeginInfo{vk::CommandBufferUsageFlagBits::eOneTimeSubmit});
+	m_gpu_profiler->begin_frame(sync.command_buffer);
+	m_render_pass_scope = m_gpu_profiler->begin_scope(sync.command_buffer, "render_pass");
 
-	auto& fb = m_frame.framebuffers.at(get_frame_index());
-	fb = make_framebuffer(m_render_device->get_device(), *m_frame.render_pass, *m_frame.render_target);
+	auto const framebuffer = get_framebuffer(*m_frame.render_target);
 	auto const ra = vk::Rect2D{vk::Offset2D{}, m_frame.render_target->extent};
 
-	auto const vec4_clear_colour = Rgba::to_linear(clear_colour.to_vec4());
-	auto const vk_clear_colour = vk::ClearColorValue{vec4_clear_colour.x, vec4_clear_colour.y, vec4_clear_colour.z, vec4_clear_colour.w};
 	auto const clear_values = std::array<vk::ClearValue, 2>{
-		vk_clear_colour,
+		to_vk_clear_colour(clear_colour),
 		vk::ClearDepthStencilValue{1.0f, 0},
 	};
 
-	auto const rpbi = vk::RenderPassBeginInfo{*m_frame.render_pass, *fb, ra, 2, clear_values.data()};
-	sync.command_buffer.beginRenderPass(rpbi, vk::SubpassContents::eInline);
+	auto const rpbi = vk::RenderPassBeginInfo{*m_frame.render_pass, framebuffer, ra, 2, clear_values.data()};
+	sync.command_buffer.beginRenderPass(rpbi, vk::SubpassContents::eSecondaryCommandBuffers);
+	m_recording->framebuffer = framebuffer;
+	begin_segment();
 
 	return true;
 }
@@ -161,20 +232,51 @@ auto Renderer::start_render(Rgba const clear_colour) -> bool {
 auto Renderer::finish_render() -> bool {
 	if (!m_frame.render_target) { return false; }
 
+	BAVE_PROFILE_SCOPE("submit_present");
 	auto& sync = m_frame.syncs.at(get_frame_index());
 
+	if (m_offscreen->active) {
+		m_log.warn("offscreen pass not ended before finish_render()");
+		end_offscreen();
+	}
+
+	end_segment();
+	sync.command_buffer.executeCommands(m_recording->segments);
 	sync.command_buffer.endRenderPass();
+	m_gpu_profiler->end_scope(sync.command_buffer, m_render_pass_scope);
+	m_render_pass_scope.reset();
 	sync.command_buffer.end();
 
+	// offscreen passes execute first, so their targets can be sampled by the frame.
+	auto command_buffers = std::array<vk::CommandBuffer, 2>{sync.offscreen_command_buffer, sync.command_buffer};
+	auto submit_buffers = std::span{command_buffers};
+	if (m_offscreen->recording) {
+		sync.offscreen_command_buffer.end();
+		m_offscreen->recording = false;
+	} else {
+		submit_buffers = submit_buffers.subspan(1);
+	}
+
 	auto si = vk::SubmitInfo{};
 	static constexpr vk::PipelineStageFlags wdsm = vk::PipelineStageFlagBits::eColorAttachmentOutput;
-	si.pCommandBuffers = &sync.command_buffer;
-	si.commandBufferCount = 1;
-	si.pWaitSemaphores = &*sync.draw;
-	si.waitSemaphoreCount = 1;
-	si.pWaitDstStageMask = &wdsm;
-	si.pSignalSemaphores = &*sync.present;
-	si.signalSemaphoreCount = 1;
+	si.pCommandBuffers = submit_buffers.data();
+	si.commandBufferCount = static_cast<std::uint32_t>(submit_buffers.size());
+	// headless: no image is acquired or presented.
+	if (!m_render_device->is_headless()) {
+		si.pWaitSemaphores = &*sync.draw;
+		si.waitSemaphoreCount = 1;
+		si.pWaitDstStageMask = &wdsm;
+		si.pSignalSemaphores = &*sync.present;
+		si.signalSemaphoreCount = 1;
+	}
+
+	m_frame_stats->buffers = m_render_device->get_buffer_cache().buffer_count();
+	for (auto const& arena : m_recording->arenas) { m_frame_stats->buffers += arena->buffer_cache.buffer_count(); }
+	m_frame_stats->images = m_render_device->get_image_cache().image_count();
+	auto const memory_usage = m_render_device->get_memory_usage();
+	m_frame_stats->memory_used = memory_usage.used;
+	m_frame_stats->memory_budget = memory_usage.budget;
+	m_stats = *m_frame_stats;
 
 	return m_render_device->submit_and_present(si, *sync.drawn, *sync.present);
 }
@@ -186,6 +288,142 @@ auto Renderer::get_backbuffer_extent() const -> vk::Extent2D {
 
 auto Renderer::get_command_buffer() const -> vk::CommandBuffer {
 	if (!m_frame.render_target) { return {}; }
-	return m_frame.syncs.at(get_frame_index()).command_buffer;
+	if (m_offscreen->active) { return m_frame.syncs.at(get_frame_index()).offscreen_command_buffer; }
+	return m_recording->segment;
+}
+
+auto Renderer::record_jobs(std::span<RecordFunc const> jobs, std::size_t max_threads) const -> bool {
+	if (!is_rendering()) {
+		m_log.warn("can only record jobs when rendering");
+		return false;
+	}
+	if (m_offscreen->active) {
+		m_log.warn("cannot record jobs in an offscreen pass");
+		return false;
+	}
+	if (jobs.empty()) { return true; }
+
+	BAVE_PROFILE_SCOPE("record_jobs");
+	auto const job_threads = m_job_system != nullptr ? m_job_system->get_thread_count() + 1 : std::size_t{1};
+	if (max_threads == 0) { max_threads = job_threads; }
+	auto const thread_count = std::min({max_threads, job_threads, jobs.size()});
+	auto& recording = *m_recording;
+	while (recording.arenas.size() <= thread_count) { recording.arenas.push_back(std::make_unique<detail::RecordArena>(m_render_device)); }
+
+	auto command_buffers = std::vector<vk::CommandBuffer>(jobs.size());
+	auto next = std::atomic<std::size_t>{};
+	auto const render_pass = *m_frame.render_pass;
+	auto const render_view = m_render_device->render_view;
+	// each slot records into its own arena, on whichever thread the JobSystem runs it.
+	auto const record = [&](std::size_t const slot) {
+		auto& arena = *recording.arenas.at(slot + 1);
+		for (auto index = next++; index < jobs.size(); index = next++) {
+			auto const command_buffer = arena.allocate_command_buffer();
+			begin_secondary(command_buffer, render_pass, recording.framebuffer);
+			auto job = RenderJob{command_buffer, &arena, index, render_view};
+			jobs[index](job);
+			command_buffer.end();
+			command_buffers[index] = command_buffer;
+		}
+	};
+
+	if (thread_count == 1) {
+		record(0);
+	} else {
+		m_job_system->parallel_for(thread_count, [&record](std::size_t const begin, std::size_t const end) {
+			for (auto slot = begin; slot < end; ++slot) { record(slot); }
+		}, 1);
+	}
+
+	end_segment();
+	recording.segments.insert(recording.segments.end(), command_buffers.begin(), command_buffers.end());
+	for (std::size_t slot = 0; slot < thread_count; ++slot) {
+		auto& arena = *recording.arenas.at(slot + 1);
+		m_frame_stats->add_counters(arena.stats);
+		arena.stats = {};
+	}
+	begin_segment();
+	return true;
+}
+
+void Renderer::begin_segment() const {
+	auto& recording = *m_recording;
+	recording.segment = recording.arenas.front()->allocate_command_buffer();
+	begin_secondary(recording.segment, *m_frame.render_pass, recording.framebuffer);
+}
+
+void Renderer::end_segment() const {
+	auto& recording = *m_recording;
+	if (!recording.segment) { return; }
+	recording.segment.end();
+	recording.segments.push_back(recording.segment);
+	recording.segment = vk::CommandBuffer{};
+}
+
+auto Renderer::begin_offscreen(vk::Framebuffer const framebuffer, vk::Extent2D const extent, Rgba const clear_colour, RenderView const& render_view) const
+	-> bool {
+	if (!is_rendering()) {
+		m_log.warn("can only render offscreen when rendering");
+		return false;
+	}
+	if (m_offscreen->active) {
+		m_log.warn("offscreen pass already active");
+		return false;
+	}
+	if (!framebuffer || extent.width == 0 || extent.height == 0) { return false; }
+
+	auto const command_buffer = m_frame.syncs.at(get_frame_index()).offscreen_command_buffer;
+	if (!m_offscreen->recording) {
+		command_buffer.begin(vk::CommandBufferBeginInfo{vk::CommandBufferUsageFlagBits::eOneTimeSubmit});
+		m_offscreen->recording = true;
+	}
+
+	auto const clear_value = vk::ClearValue{to_vk_clear_colour(clear_colour)};
+	auto const rpbi = vk::RenderPassBeginInfo{*m_offscreen->render_pass, framebuffer, vk::Rect2D{vk::Offset2D{}, extent}, 1, &clear_value};
+	command_buffer.beginRenderPass(rpbi, vk::SubpassContents::eInline);
+
+	m_offscreen->backbuffer_view = m_render_device->render_view;
+	m_render_device->render_view = render_view;
+	m_offscreen->extent = extent;
+	m_offscreen->active = true;
+	return true;
+}
+
+void Renderer::end_offscreen() const {
+	if (!m_offscreen->active) { return; }
+	m_frame.syncs.at(get_frame_index()).offscreen_command_buffer.endRenderPass();
+	m_render_device->render_view = m_offscreen->backbuffer_view;
+	m_offscreen->active = false;
+}
+
+auto Renderer::get_framebuffer(detail::RenderTarget const& render_target) -> vk::Framebuffer {
+	auto& framebuffers = m_frame.framebuffers;
+	auto const generation = m_render_device->get_swapchain_generation();
+	if (framebuffers.generation != generation || framebuffers.msaa != render_target.msaa) {
+		// previous frames may still be using these.
+		for (auto& entry : framebuffers.entries) {
+			m_render_device->get_defer_queue().push(std::make_shared<vk::UniqueFramebuffer>(std::move(entry.framebuffer)));
+		}
+		framebuffers.entries.clear();
+		framebuffers.generation = generation;
+		framebuffers.msaa = render_target.msaa;
+	}
+
+	auto const match = [&render_target](Frame::Framebuffers::Entry const& entry) { return entry.swapchain == render_target.swapchain; };
+	if (auto const it = std::find_if(framebuffers.entries.begin(), framebuffers.entries.end(), match); it != framebuffers.entries.end()) {
+		return *it->framebuffer;
+	}
+
+	auto framebuffer = make_framebuffer(m_render_device->get_device(), *m_frame.render_pass, render_target);
+	auto const ret = *framebuffer;
+	framebuffers.entries.push_back({.swapchain = render_target.swapchain, .framebuffer = std::move(framebuffer)});
+	return ret;
+}
+
+auto Renderer::get_target_extent() const -> vk::Extent2D { return m_offscreen->active ? m_offscreen->extent : get_backbuffer_extent(); }
+
+auto Renderer::get_target_pass() const -> detail::PipelineCache::Pass {
+	if (m_offscreen->active) { return {.render_pass = *m_offscreen->render_pass, .samples = vk::SampleCountFlagBits::e1}; }
+	return {.render_pass = *m_frame.render_pass, .samples = m_render_device->get_sample_count()};
 }
 } // namespace bave
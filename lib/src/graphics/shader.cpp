@@ -1,6 +1,9 @@
 #include <bave/core/error.hpp>
+#include <bave/graphics/detail/record_arena.hpp>
+#include <bave/graphics/render_job.hpp>
 #include <bave/graphics/renderer.hpp>
 #include <bave/graphics/shader.hpp>
+#include <bave/profiler.hpp>
 #include <glm/gtx/transform.hpp>
 
 namespace bave {
@@ -70,18 +73,17 @@ void make_image_write(ImageWrite<Size>& out, std::array<ImageBinding, Size> cons
 	}
 }
 
-auto allocate_descriptor_sets(detail::PipelineCache& pipeline_cache) -> std::array<vk::DescriptorSet, 3> {
+auto allocate_descriptor_sets(detail::PipelineCache const& pipeline_cache, detail::DescriptorCache& descriptor_cache) -> std::array<vk::DescriptorSet, 3> {
 	auto const descriptor_set_layouts = pipeline_cache.get_descriptor_set_layouts();
 	auto ret = std::array<vk::DescriptorSet, 3>{};
 	for (std::size_t i = 0; i < ret.size(); ++i) {
 		// NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-constant-array-index)
-		ret[i] = pipeline_cache.get_descriptor_cache().allocate(descriptor_set_layouts[i]);
+		ret[i] = descriptor_cache.allocate(descriptor_set_layouts[i]);
 	}
 	return ret;
 }
 
-auto make_vpi_bindings(RenderDevice const& render_device, std::span<RenderInstance::Baked const> instances) {
-	auto const& render_view = render_device.render_view;
+auto make_vpi_bindings(RenderView const& render_view, detail::BufferCache& buffer_cache, std::span<RenderInstance::Baked const> instances) {
 	auto const proj_xy = 0.5f * render_view.viewport;
 	auto const proj_z = render_view.z_plane;
 	auto const view = Transform{
@@ -93,9 +95,9 @@ auto make_vpi_bindings(RenderDevice const& render_device, std::span<RenderInstan
 		.view = view.matrix(),
 		.projection = glm::ortho(-proj_xy.x, proj_xy.x, -proj_xy.y, proj_xy.y, proj_z.near, proj_z.far),
 	};
-	auto& vp_buf = render_device.get_buffer_cache().allocate(detail::BufferType::eUniform);
+	auto& vp_buf = buffer_cache.allocate(detail::BufferType::eUniform);
 	vp_buf.write(&view_projection, sizeof(view_projection));
-	auto& instances_buf = render_device.get_buffer_cache().allocate(detail::BufferType::eStorage);
+	auto& instances_buf = buffer_cache.allocate(detail::BufferType::eStorage);
 	instances_buf.write(instances.data(), instances.size_bytes());
 	return std::array{
 		BufferBinding{.resource = vp_buf, .binding = 0},
@@ -113,7 +115,7 @@ auto make_texture_bindings(std::span<SamplerImage const, Shader::max_textures_v>
 	return ret;
 }
 
-auto make_buffer_bindings(detail::BufferCache& scratch_buffer_cache, Ptr<detail::RenderBuffer const> ubo, Ptr<detail::RenderBuffer const> ssbo) {
+auto make_buffer_bindings(detail::BufferCache const& scratch_buffer_cache, Ptr<detail::RenderBuffer const> ubo, Ptr<detail::RenderBuffer const> ssbo) {
 	auto const& custom_ubo = scratch_buffer_cache.or_empty(ubo, detail::BufferType::eUniform);
 	auto const& custom_ssbo = scratch_buffer_cache.or_empty(ssbo, detail::BufferType::eStorage);
 	return std::array{
@@ -130,7 +132,15 @@ auto make_buffer_bindings(detail::BufferCache& scratch_buffer_cache, Ptr<detail:
 }
 } // namespace
 
-Shader::Shader(NotNull<Renderer const*> renderer, vk::ShaderModule vertex, vk::ShaderModule fragment) : m_renderer(renderer), m_vert(vertex), m_frag(fragment) {
+auto RenderJob::bind(Shader shader) -> Shader {
+	shader.m_job = this;
+	shader.set_viewport();
+	return shader;
+}
+
+Shader::Shader(NotNull<Renderer const*> renderer, std::string_view const vertex, std::string_view const fragment)
+	: m_renderer(renderer), m_vert(vertex), m_frag(fragment) {
+	resolve_program();
 	set_viewport();
 }
 
@@ -148,6 +158,7 @@ auto Shader::write_ubo(void const* data, vk::DeviceSize const size) -> bool {
 
 	if (m_sets.ubo == nullptr) { m_sets.ubo = &allocate_scratch(detail::BufferType::eUniform); }
 	m_sets.ubo->write(data, size);
+	get_stats().bytes_uploaded += size;
 	return true;
 }
 
@@ -156,23 +167,37 @@ auto Shader::write_ssbo(void const* data, vk::DeviceSize const size) -> bool {
 
 	if (m_sets.ssbo == nullptr) { m_sets.ssbo = &allocate_scratch(detail::BufferType::eStorage); }
 	m_sets.ssbo->write(data, size);
+	get_stats().bytes_uploaded += size;
 	return true;
 }
 
-auto Shader::get_render_view() const -> RenderView { return m_renderer->get_render_device().render_view; }
+auto Shader::get_render_view() const -> RenderView { return m_job != nullptr ? m_job->render_view : m_renderer->get_render_device().render_view; }
 
-void Shader::set_render_view(RenderView const& render_view) { m_renderer->get_render_device().render_view = render_view; }
+void Shader::set_render_view(RenderView const& render_view) {
+	if (m_job != nullptr) {
+		m_job->render_view = render_view;
+		return;
+	}
+	m_renderer->get_render_device().render_view = render_view;
+}
 
 void Shader::draw(RenderPrimitive const& primitive, std::span<RenderInstance::Baked const> instances) {
-	auto const command_buffer = m_renderer->get_command_buffer();
+	auto const command_buffer = get_command_buffer();
 	if (!command_buffer || primitive.bytes.empty() || instances.empty()) { return; }
 
 	auto& pipeline_cache = m_renderer->get_pipeline_cache();
+	// modules may have been invalidated (and reloaded) since they were resolved.
+	if (pipeline_cache.get_shader_cache().get_generation() != m_program.generation) { resolve_program(); }
+	if (!m_program.vertex || !m_program.fragment) { return; }
+	auto const program = detail::PipelineCache::Program{.vertex = m_program.vertex, .fragment = m_program.fragment};
 	auto const topology = to_topology(primitive.topology);
 	auto const pipeline_state = detail::PipelineCache::State{.line_width = line_width, .topology = topology, .polygon_mode = polygon_mode};
-	auto pipeline = pipeline_cache.load_pipeline({.vertex = m_vert, .fragment = m_frag}, pipeline_state);
+	auto pipeline = pipeline_cache.load_pipeline(program, pipeline_state, m_renderer->get_target_pass());
 	if (!pipeline) { return; }
 
+	// the target may be offscreen: fit the viewport to it.
+	set_viewport();
+
 	update_and_bind_sets(command_buffer, instances);
 
 	auto& vbo = allocate_scratch(detail::BufferType::eVertexIndex);
@@ -180,9 +205,22 @@ void Shader::draw(RenderPrimitive const& primitive, std::span<RenderInstance::Ba
 
 	command_buffer.bindPipeline(vk::PipelineBindPoint::eGraphics, pipeline);
 	command_buffer.setViewport(0, m_viewport);
-	command_buffer.setScissor(0, get_scissor(m_renderer->get_render_device().render_view.n_scissor));
+	command_buffer.setScissor(0, get_scissor(get_render_view().n_scissor));
 	command_buffer.setLineWidth(m_renderer->get_render_device().get_line_width_limits().clamp(line_width));
 
+	auto& gpu_profiler = m_renderer->get_gpu_profiler();
+	// timestamp queries are reset in the frame's command buffer, which is submitted after offscreen passes.
+	// GpuProfiler is not thread safe: jobs are not timed.
+	auto const draw_timing = Profiler::self().is_gpu_draw_timing() && !m_renderer->is_offscreen() && m_job == nullptr;
+	auto const gpu_scope = draw_timing ? gpu_profiler.begin_scope(command_buffer, "draw") : std::nullopt;
+
+	auto& stats = get_stats();
+	++stats.draw_calls;
+	++stats.pipeline_binds;
+	stats.instances += instances.size();
+	stats.vertices += std::uint64_t{primitive.ibo_offset > 0 ? primitive.indices : primitive.vertices} * instances.size();
+	stats.bytes_uploaded += primitive.bytes.size();
+
 	auto const instance_count = static_cast<std::uint32_t>(instances.size());
 	command_buffer.bindVertexBuffers(0, vbo.get_buffer(), vk::DeviceSize{});
 	if (primitive.ibo_offset > 0) {
@@ -192,15 +230,35 @@ void Shader::draw(RenderPrimitive const& primitive, std::span<RenderInstance::Ba
 		command_buffer.draw(primitive.vertices, instance_count, 0, 0);
 	}
 
+	gpu_profiler.end_scope(command_buffer, gpu_scope);
+
 	m_sets = {}; // clear for next draw
 }
 
-auto Shader::allocate_scratch(detail::BufferType const type) const -> detail::RenderBuffer& {
-	return m_renderer->get_render_device().get_buffer_cache().allocate(type);
+void Shader::resolve_program() {
+	auto& shader_cache = m_renderer->get_pipeline_cache().get_shader_cache();
+	// read before loading: an invalidation in between is picked up on the next draw.
+	m_program.generation = shader_cache.get_generation();
+	m_program.vertex = shader_cache.load(m_vert);
+	m_program.fragment = shader_cache.load(m_frag);
 }
 
+auto Shader::allocate_scratch(detail::BufferType const type) const -> detail::RenderBuffer& { return get_buffer_cache().allocate(type); }
+
+auto Shader::get_command_buffer() const -> vk::CommandBuffer { return m_job != nullptr ? m_job->m_command_buffer : m_renderer->get_command_buffer(); }
+
+auto Shader::get_buffer_cache() const -> detail::BufferCache& {
+	return m_job != nullptr ? m_job->m_arena->buffer_cache : m_renderer->get_render_device().get_buffer_cache();
+}
+
+auto Shader::get_descriptor_cache() const -> detail::DescriptorCache& {
+	return m_job != nullptr ? m_job->m_arena->descriptor_cache : m_renderer->get_pipeline_cache().get_descriptor_cache();
+}
+
+auto Shader::get_stats() const -> RenderStats& { return m_job != nullptr ? m_job->m_arena->stats : m_renderer->get_frame_stats(); }
+
 void Shader::set_viewport() {
-	auto const fb_extent = m_renderer->get_backbuffer_extent();
+	auto const fb_extent = m_renderer->get_target_extent();
 	glm::vec2 const viewport = glm::uvec2{fb_extent.width, fb_extent.height};
 	m_viewport = vk::Viewport{0.0f, viewport.y, viewport.x, -viewport.y};
 }
@@ -208,7 +266,7 @@ void Shader::set_viewport() {
 auto Shader::get_scissor(Rect<> n_rect) const -> vk::Rect2D {
 	n_rect.lt = glm::clamp(n_rect.lt, glm::vec2{}, glm::vec2{1.0f});
 	n_rect.rb = glm::clamp(n_rect.rb, n_rect.lt, glm::vec2{1.0f});
-	auto const fb_extent = m_renderer->get_backbuffer_extent();
+	auto const fb_extent = m_renderer->get_target_extent();
 	auto const fb_size = glm::vec2{fb_extent.width, fb_extent.height};
 	glm::ivec2 const offset = n_rect.lt * fb_size;
 	glm::uvec2 const extent = (n_rect.rb - n_rect.lt) * fb_size;
@@ -224,10 +282,10 @@ void Shader::update_and_bind_sets(vk::CommandBuffer command_buffer, std::span<Re
 	static_assert(detail::set_layout_v.buffers.bindings[0] == vk::DescriptorType::eUniformBuffer);
 	static_assert(detail::set_layout_v.buffers.bindings[1] == vk::DescriptorType::eStorageBuffer);
 
-	auto descriptor_sets = allocate_descriptor_sets(m_renderer->get_pipeline_cache());
+	auto descriptor_sets = allocate_descriptor_sets(m_renderer->get_pipeline_cache(), get_descriptor_cache());
 	static_assert(descriptor_sets.size() == 3);
 
-	auto const vpi_bindings = make_vpi_bindings(m_renderer->get_render_device(), instances);
+	auto const vpi_bindings = make_vpi_bindings(get_render_view(), get_buffer_cache(), instances);
 	auto vpi_write = BufferWrite<vpi_bindings.size()>{};
 	make_buffer_write(vpi_write, vpi_bindings, descriptor_sets[0]);
 
@@ -235,7 +293,7 @@ void Shader::update_and_bind_sets(vk::CommandBuffer command_buffer, std::span<Re
 	auto texture_write = ImageWrite<texture_bindings.size()>{};
 	make_image_write(texture_write, texture_bindings, descriptor_sets[1]);
 
-	auto const buffer_bindings = make_buffer_bindings(m_renderer->get_render_device().get_buffer_cache(), m_sets.ubo, m_sets.ssbo);
+	auto const buffer_bindings = make_buffer_bindings(get_buffer_cache(), m_sets.ubo, m_sets.ssbo);
 	auto buffer_write = BufferWrite<buffer_bindings.size()>{};
 	make_buffer_write(buffer_write, buffer_bindings, descriptor_sets[2]);
 
@@ -248,6 +306,11 @@ void Shader::update_and_bind_sets(vk::CommandBuffer command_buffer, std::span<Re
 
 	m_renderer->get_render_device().get_device().updateDescriptorSets(descriptor_writes, {});
 
+	auto& stats = get_stats();
+	stats.descriptor_sets += descriptor_sets.size();
+	stats.descriptor_writes += descriptor_writes.size();
+	stats.bytes_uploaded += sizeof(Std140ViewProjection) + instances.size_bytes();
+
 	auto const pipeline_layout = m_renderer->get_pipeline_cache().get_pipeline_layout();
 	command_buffer.bindDescriptorSets(vk::PipelineBindPoint::eGraphics, pipeline_layout, 0, descriptor_sets, {});
 }
@@ -1,4 +1,5 @@
 #include <bave/core/is_positive.hpp>
+#include <bave/graphics/detail/image_uploader.hpp>
 #include <bave/graphics/image_file.hpp>
 #include <bave/graphics/render_device.hpp>
 #include <bave/graphics/texture.hpp>
@@ -8,6 +9,34 @@ Texture::Texture(NotNull<RenderDevice*> render_device, BitmapView bitmap, bool m
 	: m_render_device(render_device),
 	  m_image(render_device->get_image_cache().allocate(detail::RenderImage::CreateInfo{.mip_map = mip_map}, detail::to_vk_extent(bitmap.extent))) {
 	if (!bitmap.bytes.empty()) { m_image->overwrite(bitmap, {}); }
+	if (mip_map) { sampler.mip = Filter::eLinear; }
+	resolve_sampler();
+}
+
+Texture::Texture(NotNull<RenderDevice*> render_device, BitmapView bitmap, bool mip_map, detail::ImageUploader& uploader)
+	: m_render_device(render_device),
+	  m_image(render_device->get_image_cache().allocate(detail::RenderImage::CreateInfo{.mip_map = mip_map}, detail::to_vk_extent(bitmap.extent))) {
+	if (!bitmap.bytes.empty()) { uploader.upload(*m_image, bitmap); }
+	if (mip_map) { sampler.mip = Filter::eLinear; }
+	resolve_sampler();
+}
+
+Texture::Texture(NotNull<RenderDevice*> render_device, CompressedImage const& image)
+	: m_render_device(render_device),
+	  // allocated with the final format and level count: copy_levels() does not need to recreate it.
+	  m_image(render_device->get_image_cache().allocate(
+		  detail::RenderImage::CreateInfo{
+			  .format = image.get_format(),
+			  .mip_map = image.get_levels().size() > 1,
+			  .mip_levels = static_cast<std::uint32_t>(image.get_levels().size()),
+		  },
+		  detail::to_vk_extent(image.get_extent()))) {
+	auto levels = std::vector<detail::RenderImage::Layer>{};
+	levels.reserve(image.get_levels().size());
+	for (auto const& level : image.get_levels()) { levels.push_back(level.bytes); }
+	m_image->copy_levels(image.get_format(), detail::to_vk_extent(image.get_extent()), levels);
+	if (levels.size() > 1) { sampler.mip = Filter::eLinear; }
+	resolve_sampler();
 }
 
 Texture::~Texture() {
@@ -16,14 +45,50 @@ Texture::~Texture() {
 }
 
 auto Texture::get_size() const -> glm::ivec2 {
-	if (!m_image) { return {}; }
-	auto const extent = m_image->get_extent();
+	auto const image = get_image();
+	if (!image) { return {}; }
+	auto const extent = image->get_extent();
 	return glm::ivec2{extent.width, extent.height};
 }
 
 auto Texture::get_sampler_image() const -> SamplerImage {
+	// moved-from.
+	if (!m_binding) { return {}; }
+	// called per bound texture per draw, possibly on multiple record threads: an uncontended
+	// per-Texture lock and an equality check are cheaper than hashing and locking the cache.
+	auto lock = std::scoped_lock{m_binding->mutex};
 	if (!m_image) { return {}; }
-	return {.image_view = m_image->get_image_view(), .sampler = m_render_device->get_sampler_cache().get(sampler)};
+	return {.image_view = m_image->get_image_view(), .sampler = resolve_sampler(lock)};
+}
+
+auto Texture::get_image() const -> std::shared_ptr<detail::RenderImage> {
+	if (!m_binding) { return m_image; }
+	auto lock = std::scoped_lock{m_binding->mutex};
+	return m_image;
+}
+
+void Texture::replace_image(std::shared_ptr<detail::RenderImage> image) {
+	if (!m_binding) { return; }
+	{
+		auto lock = std::scoped_lock{m_binding->mutex};
+		std::swap(m_image, image);
+	}
+	// the previous image may still be in use by in-flight frames, or by commands recorded this frame.
+	if (image) { m_render_device->get_defer_queue().push(std::move(image)); }
+}
+
+auto Texture::resolve_sampler() const -> vk::Sampler {
+	if (!m_binding) { return {}; }
+	auto lock = std::scoped_lock{m_binding->mutex};
+	return resolve_sampler(lock);
+}
+
+auto Texture::resolve_sampler(std::scoped_lock<std::mutex> const& /*lock*/) const -> vk::Sampler {
+	if (!m_binding->handle || sampler != m_binding->sampler) {
+		m_binding->sampler = sampler;
+		m_binding->handle = m_render_device->get_sampler_cache().get(sampler);
+	}
+	return m_binding->handle;
 }
 
 auto TextureWriteable::load_from_bytes(std::span<std::byte const> compressed) -> bool {
@@ -4,6 +4,9 @@ namespace bave {
 TextureAtlas::TextureAtlas(NotNull<RenderDevice*> render_device, BitmapView bitmap, TileSheet sheet, bool mip_map)
 	: Texture(render_device, bitmap, mip_map), m_sheet(std::move(sheet)) {}
 
+TextureAtlas::TextureAtlas(NotNull<RenderDevice*> render_device, BitmapView bitmap, TileSheet sheet, bool mip_map, detail::ImageUploader& uploader)
+	: Texture(render_device, bitmap, mip_map, uploader), m_sheet(std::move(sheet)) {}
+
 auto TextureAtlas::get_uv(std::string_view const id) const -> UvRect {
 	auto const* tile = m_sheet.find_tile(id);
 	if (tile == nullptr) { return uv_rect_v; }
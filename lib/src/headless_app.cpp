@@ -0,0 +1,104 @@
+#include <bave/core/error.hpp>
+#include <bave/core/is_positive.hpp>
+#include <bave/headless_app.hpp>
+#include <bave/io/file_loader.hpp>
+#include <filesystem>
+
+namespace bave {
+namespace fs = std::filesystem;
+
+void HeadlessApp::ImGuiContext::Deleter::operator()(ImGuiContext /*context*/) const noexcept { ImGui::DestroyContext(); }
+
+HeadlessApp::HeadlessApp(CreateInfo create_info) : App("HeadlessApp"), m_create_info(std::move(create_info)) {
+	if (!is_positive(m_create_info.extent)) { m_create_info.extent = CreateInfo{}.extent; }
+	if (m_create_info.fixed_dt <= Seconds{}) { m_create_info.fixed_dt = CreateInfo{}.fixed_dt; }
+	m_fixed_dt = m_create_info.fixed_dt;
+	if (!m_create_info.persistent_dir.empty() && !fs::is_directory(m_create_info.persistent_dir)) {
+		m_log.warn("could not locate desired persistent directory '{}', using working directory", m_create_info.persistent_dir);
+		m_create_info.persistent_dir.clear();
+	}
+	if (m_create_info.persistent_dir.empty()) { m_create_info.persistent_dir = fs::current_path().generic_string(); }
+}
+
+auto HeadlessApp::read_framebuffer() const -> std::optional<Bitmap> {
+	if (!m_render_device || m_frame_count == 0) { return {}; }
+	return m_render_device->read_offscreen();
+}
+
+auto HeadlessApp::setup() -> std::optional<ErrCode> {
+	m_active_pointers.emplace_back();
+
+	if (!m_create_info.data_loader) {
+		auto const mount_point = fs::current_path().generic_string();
+		m_log.info("setting FileLoader mount point: '{}'", mount_point);
+		m_create_info.data_loader = std::make_unique<FileLoader>(mount_point);
+	}
+	set_data_loader(std::move(m_create_info.data_loader));
+
+	// a context without backends, so that Drivers can use ImGui unconditionally.
+	ImGui::CreateContext();
+	m_imgui = {ImGuiContext{.init = true}};
+	auto& io = ImGui::GetIO();
+	io.IniFilename = nullptr;
+	io.Fonts->Build();
+
+	auto const rdci = RenderDevice::CreateInfo{
+		.desired_samples = m_create_info.msaa,
+		.frames_in_flight = m_create_info.frames_in_flight,
+		.validation_layers = m_create_info.validation_layers,
+	};
+	m_render_device = std::make_unique<RenderDevice>(static_cast<detail::IWsi*>(this), rdci);
+	m_renderer = std::make_unique<Renderer>(m_render_device.get(), &get_data_store());
+	m_renderer->set_job_system(&get_job_system());
+
+	m_driver = boot_driver();
+
+	return {};
+}
+
+void HeadlessApp::poll_events() {
+	if (m_create_info.max_frames > 0 && m_frame_count >= m_create_info.max_frames) { shutdown(); }
+}
+
+void HeadlessApp::tick() {
+	auto& io = ImGui::GetIO();
+	io.DisplaySize = ImVec2{static_cast<float>(m_create_info.extent.x), static_cast<float>(m_create_info.extent.y)};
+	io.DeltaTime = get_dt().count();
+	ImGui::NewFrame();
+	if (is_shutting_down()) { return; }
+	m_driver->tick();
+}
+
+void HeadlessApp::render() {
+	ImGui::Render();
+	if (is_shutting_down()) { return; }
+	if (m_renderer->start_render(m_driver->clear_colour)) { m_driver->render(); }
+	if (m_renderer->finish_render()) { ++m_frame_count; }
+}
+
+auto HeadlessApp::do_get_render_device() const -> RenderDevice& {
+	if (!m_render_device) { throw Error{"Dereferencing null RenderDevice"}; }
+	return *m_render_device;
+}
+
+auto HeadlessApp::do_get_renderer() const -> Renderer& {
+	if (!m_renderer) { throw Error{"Dereferencing null FrameRenderer"}; }
+	return *m_renderer;
+}
+
+auto HeadlessApp::select_gpu(std::span<Gpu const> gpus) const -> Gpu {
+	if (m_create_info.select_gpu) { return m_create_info.select_gpu(gpus); }
+	return IWsi::select_gpu(gpus);
+}
+
+auto HeadlessApp::do_set_window_size(glm::ivec2 const size) -> bool {
+	if (!is_positive(size)) { return false; }
+	m_create_info.extent = size;
+	return true;
+}
+
+void HeadlessApp::do_wait_render_device_idle() {
+	if (!m_render_device) { return; }
+	m_render_device->get_device().waitIdle();
+}
+} // namespace bave
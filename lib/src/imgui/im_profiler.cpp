@@ -0,0 +1,69 @@
+#include <bave/imgui/im_profiler.hpp>
+#include <bave/imgui/im_text.hpp>
+#include <algorithm>
+#include <numeric>
+
+namespace bave {
+namespace {
+auto to_ms(Clock::duration const duration) -> float { return std::chrono::duration<float, std::milli>{duration}.count(); }
+auto to_ms(std::chrono::nanoseconds const duration) -> float { return std::chrono::duration<float, std::milli>{duration}.count(); }
+
+template <typename SampleT>
+void draw_scope_table(char const* label, std::span<SampleT const> samples) {
+	if (!ImGui::BeginTable(label, 2, ImGuiTableFlags_RowBg | ImGuiTableFlags_BordersInnerV)) { return; }
+	ImGui::TableSetupColumn("scope");
+	ImGui::TableSetupColumn("ms");
+	ImGui::TableHeadersRow();
+	for (auto const& sample : samples) {
+		ImGui::TableNextRow();
+		ImGui::TableNextColumn();
+		ImGui::Indent(static_cast<float>(sample.depth) * ImGui::GetStyle().IndentSpacing + 1.0f);
+		im_text("{}", sample.name);
+		ImGui::Unindent(static_cast<float>(sample.depth) * ImGui::GetStyle().IndentSpacing + 1.0f);
+		ImGui::TableNextColumn();
+		im_text("{:.3f}", to_ms(sample.duration));
+	}
+	ImGui::EndTable();
+}
+} // namespace
+
+void ImProfiler::draw() {
+	auto& profiler = Profiler::self();
+	if constexpr (!profiler_v) {
+		ImGui::TextUnformatted("profiler not compiled in (BAVE_USE_PROFILER)");
+		return;
+	}
+
+	auto enabled = profiler.is_enabled();
+	if (ImGui::Checkbox("record", &enabled)) { profiler.set_enabled(enabled); }
+	ImGui::SameLine();
+	auto draw_timing = profiler.is_gpu_draw_timing();
+	if (ImGui::Checkbox("GPU draw timing", &draw_timing)) { profiler.set_gpu_draw_timing(draw_timing); }
+
+	m_frame_times = profiler.get_frame_times();
+	if (!m_frame_times.empty()) {
+		auto const average = std::accumulate(m_frame_times.begin(), m_frame_times.end(), 0.0f) / static_cast<float>(m_frame_times.size());
+		auto const max = *std::max_element(m_frame_times.begin(), m_frame_times.end());
+		auto const overlay = FixedString<>{"avg: {:.2f}ms max: {:.2f}ms", average, max};
+		ImGui::PlotLines("frame time", m_frame_times.data(), static_cast<int>(m_frame_times.size()), 0, overlay.c_str(), 0.0f, max * 1.1f, graph_size);
+	}
+
+	auto const frame = profiler.get_last_frame();
+	im_text("frame {}: {:.3f}ms", frame.index, to_ms(frame.duration));
+	if (ImGui::TreeNode("CPU")) {
+		draw_scope_table<Profiler::Sample>("cpu_scopes", frame.cpu);
+		ImGui::TreePop();
+	}
+	if (ImGui::TreeNode("GPU")) {
+		if (frame.gpu.empty()) { ImGui::TextUnformatted("(pending / unsupported)"); }
+		draw_scope_table<Profiler::GpuSample>("gpu_scopes", frame.gpu);
+		ImGui::TreePop();
+	}
+
+	if (ImGui::Button("clear")) { profiler.clear(); }
+	ImGui::SameLine();
+	if (ImGui::Button("export")) { profiler.write_chrome_trace(trace_path.c_str()); }
+	ImGui::SameLine();
+	im_text<160>("-> {}", trace_path.view());
+}
+} // namespace bave
@@ -0,0 +1,152 @@
+#include <bave/data_store.hpp>
+#include <bave/io/bundle.hpp>
+#include <algorithm>
+#include <array>
+
+namespace bave {
+namespace {
+constexpr auto magic_v = std::array{std::byte{'B'}, std::byte{'V'}, std::byte{'B'}, std::byte{'N'}};
+constexpr std::size_t header_size_v{32};
+constexpr std::size_t index_entry_size_v{32};
+
+auto read_u32(std::span<std::byte const> bytes, std::size_t const offset) -> std::uint32_t {
+	auto ret = std::uint32_t{};
+	for (std::size_t i = 0; i < 4; ++i) { ret |= static_cast<std::uint32_t>(bytes[offset + i]) << (i * 8); }
+	return ret;
+}
+
+auto read_u64(std::span<std::byte const> bytes, std::size_t const offset) -> std::uint64_t {
+	return static_cast<std::uint64_t>(read_u32(bytes, offset)) | static_cast<std::uint64_t>(read_u32(bytes, offset + 4)) << 32;
+}
+
+void write_u32(std::vector<std::byte>& out, std::size_t const offset, std::uint32_t const value) {
+	for (std::size_t i = 0; i < 4; ++i) { out[offset + i] = static_cast<std::byte>((value >> (i * 8)) & 0xff); }
+}
+
+void write_u64(std::vector<std::byte>& out, std::size_t const offset, std::uint64_t const value) {
+	write_u32(out, offset, static_cast<std::uint32_t>(value & 0xffffffff));
+	write_u32(out, offset + 4, static_cast<std::uint32_t>(value >> 32));
+}
+
+constexpr auto align(std::size_t const offset) -> std::size_t { return (offset + Bundle::alignment_v - 1) & ~(Bundle::alignment_v - 1); }
+} // namespace
+
+auto Bundle::hash(std::string_view const uri) -> std::uint64_t {
+	auto ret = std::uint64_t{0xcbf29ce484222325};
+	for (auto const c : uri) {
+		ret ^= static_cast<std::uint8_t>(c);
+		ret *= 0x100000001b3;
+	}
+	return ret;
+}
+
+Bundle::Bundle(DataView bytes) : m_bytes(std::move(bytes)) {
+	auto const data = m_bytes.get_bytes();
+	if (data.size() < header_size_v || !std::equal(magic_v.begin(), magic_v.end(), data.begin())) { return; }
+	if (read_u32(data, 4) != version_v) { return; }
+
+	auto const count = static_cast<std::size_t>(read_u32(data, 8));
+	auto const strings_offset = read_u64(data, 16);
+	if (header_size_v + count * index_entry_size_v > strings_offset || strings_offset > data.size()) { return; }
+
+	m_count = count;
+	m_strings_offset = static_cast<std::size_t>(strings_offset);
+	m_valid = true;
+}
+
+auto Bundle::contains(std::string_view const uri) const -> bool {
+	auto entry = Entry{};
+	return find_entry(uri, entry);
+}
+
+auto Bundle::find(std::string_view const uri) const -> DataView {
+	auto entry = Entry{};
+	if (!find_entry(uri, entry)) { return {}; }
+	return m_bytes.subview(static_cast<std::size_t>(entry.offset), static_cast<std::size_t>(entry.size));
+}
+
+auto Bundle::find_entry(std::string_view const uri, Entry& out) const -> bool {
+	if (!m_valid) { return false; }
+	auto const data = m_bytes.get_bytes();
+	auto const target = hash(uri);
+	auto const hash_at = [data](std::size_t const index) { return read_u64(data, header_size_v + index * index_entry_size_v); };
+
+	// lower bound of target hash.
+	auto lo = std::size_t{};
+	auto hi = m_count;
+	while (lo < hi) {
+		auto const mid = lo + (hi - lo) / 2;
+		if (hash_at(mid) < target) {
+			lo = mid + 1;
+		} else {
+			hi = mid;
+		}
+	}
+
+	// resolve collisions by comparing URIs.
+	for (; lo < m_count && hash_at(lo) == target; ++lo) {
+		auto const entry_offset = header_size_v + lo * index_entry_size_v;
+		auto const uri_offset = m_strings_offset + read_u32(data, entry_offset + 24);
+		auto const uri_length = static_cast<std::size_t>(read_u32(data, entry_offset + 28));
+		if (uri_offset + uri_length > data.size()) { return false; }
+		if (DataStore::as_string_view(data.subspan(uri_offset, uri_length)) != uri) { continue; }
+
+		out = Entry{.offset = read_u64(data, entry_offset + 8), .size = read_u64(data, entry_offset + 16)};
+		return out.offset <= data.size() && out.size <= data.size() - out.offset;
+	}
+	return false;
+}
+
+auto Bundle::Builder::add(std::string uri, std::vector<std::byte> bytes) -> Builder& {
+	auto const it = std::find_if(m_entries.begin(), m_entries.end(), [&uri](Entry const& entry) { return entry.uri == uri; });
+	if (it != m_entries.end()) {
+		it->bytes = std::move(bytes);
+	} else {
+		m_entries.push_back(Entry{.uri = std::move(uri), .bytes = std::move(bytes)});
+	}
+	return *this;
+}
+
+auto Bundle::Builder::build() const -> std::vector<std::byte> {
+	struct Indexed {
+		std::uint64_t hash{};
+		Entry const* entry{};
+	};
+
+	auto indexed = std::vector<Indexed>{};
+	indexed.reserve(m_entries.size());
+	for (auto const& entry : m_entries) { indexed.push_back(Indexed{.hash = hash(entry.uri), .entry = &entry}); }
+	std::sort(indexed.begin(), indexed.end(), [](Indexed const& a, Indexed const& b) { return a.hash < b.hash; });
+
+	auto const strings_offset = header_size_v + indexed.size() * index_entry_size_v;
+	auto strings_size = std::size_t{};
+	for (auto const& entry : m_entries) { strings_size += entry.uri.size(); }
+
+	auto ret = std::vector<std::byte>(align(strings_offset + strings_size));
+	std::copy(magic_v.begin(), magic_v.end(), ret.begin());
+	write_u32(ret, 4, version_v);
+	write_u32(ret, 8, static_cast<std::uint32_t>(indexed.size()));
+	write_u64(ret, 16, strings_offset);
+
+	auto uri_offset = std::size_t{};
+	for (std::size_t i = 0; i < indexed.size(); ++i) {
+		auto const& entry = *indexed[i].entry;
+		auto const entry_offset = header_size_v + i * index_entry_size_v;
+		auto const data_offset = ret.size();
+
+		write_u64(ret, entry_offset, indexed[i].hash);
+		write_u64(ret, entry_offset + 8, data_offset);
+		write_u64(ret, entry_offset + 16, entry.bytes.size());
+		write_u32(ret, entry_offset + 24, static_cast<std::uint32_t>(uri_offset));
+		write_u32(ret, entry_offset + 28, static_cast<std::uint32_t>(entry.uri.size()));
+
+		auto const uri_bytes = std::as_bytes(std::span{entry.uri});
+		std::copy(uri_bytes.begin(), uri_bytes.end(), ret.begin() + static_cast<std::ptrdiff_t>(strings_offset + uri_offset));
+		uri_offset += entry.uri.size();
+
+		ret.insert(ret.end(), entry.bytes.begin(), entry.bytes.end());
+		ret.resize(align(ret.size()));
+	}
+	return ret;
+}
+} // namespace bave
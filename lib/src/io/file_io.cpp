@@ -1,8 +1,19 @@
+#include <bave/core/pinned.hpp>
 #include <bave/io/file_io.hpp>
 #include <array>
 #include <filesystem>
 #include <fstream>
 
+#if defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#include <Windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
 namespace bave {
 namespace {
 namespace fs = std::filesystem;
@@ -19,6 +30,60 @@ auto read_data(Type& out, bave::CString path) -> bool {
 	return true;
 }
 
+struct Mapping : Pinned {
+	void const* data{};
+	std::size_t size{};
+	// zero-byte files cannot be mapped, but are valid (empty).
+	bool empty_file{};
+
+#if defined(_WIN32)
+	HANDLE file{INVALID_HANDLE_VALUE};
+	HANDLE mapping{};
+
+	explicit Mapping(CString const path) {
+		file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+		if (file == INVALID_HANDLE_VALUE) { return; }
+		auto file_size = LARGE_INTEGER{};
+		if (GetFileSizeEx(file, &file_size) == 0) { return; }
+		if (file_size.QuadPart == 0) {
+			empty_file = true;
+			return;
+		}
+		mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+		if (mapping == nullptr) { return; }
+		data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+		if (data != nullptr) { size = static_cast<std::size_t>(file_size.QuadPart); }
+	}
+
+	~Mapping() {
+		if (data != nullptr) { UnmapViewOfFile(data); }
+		if (mapping != nullptr) { CloseHandle(mapping); }
+		if (file != INVALID_HANDLE_VALUE) { CloseHandle(file); }
+	}
+#else
+	explicit Mapping(CString const path) {
+		auto const fd = open(path.c_str(), O_RDONLY); // NOLINT(cppcoreguidelines-pro-type-vararg)
+		if (fd < 0) { return; }
+		struct stat info {};
+		if (fstat(fd, &info) == 0) {
+			empty_file = info.st_size == 0;
+			if (info.st_size > 0) {
+				auto* ret = mmap(nullptr, static_cast<std::size_t>(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+				if (ret != MAP_FAILED) { // NOLINT(cppcoreguidelines-pro-type-cstyle-cast)
+					data = ret;
+					size = static_cast<std::size_t>(info.st_size);
+				}
+			}
+		}
+		close(fd);
+	}
+
+	~Mapping() {
+		if (data != nullptr) { munmap(const_cast<void*>(data), size); } // NOLINT(cppcoreguidelines-pro-type-const-cast)
+	}
+#endif
+};
+
 struct PatternParser {
 	std::string_view remain{};
 
@@ -79,6 +144,15 @@ auto file::exists(CString const path) -> bool { return fs::exists(path.as_view()
 auto file::read_bytes(std::vector<std::byte>& out, CString const path) -> bool { return read_data(out, path); }
 auto file::read_string(std::string& out, CString const path) -> bool { return read_data(out, path); }
 
+auto file::map(CString const path) -> DataView {
+	if (path.as_view().empty()) { return {}; }
+	auto mapping = std::make_shared<Mapping const>(path);
+	if (mapping->empty_file) { return DataView{std::move(mapping), {}}; }
+	if (mapping->data == nullptr) { return {}; }
+	auto const bytes = std::span{static_cast<std::byte const*>(mapping->data), mapping->size};
+	return DataView{std::move(mapping), bytes};
+}
+
 auto file::write_bytes(CString const path, std::span<std::byte const> data) -> bool {
 	if (path.as_view().empty()) { return false; }
 	if (!ensure_parent_exists(path)) { return false; }
@@ -21,7 +21,19 @@ auto FileLoader::read_bytes(std::vector<std::byte>& out, std::string_view const
 	return file::read_bytes(out, make_full_path(uri).c_str());
 }
 
+auto FileLoader::map(std::string_view const uri) const -> DataView {
+	if (m_watched) { return IDataLoader::map(uri); }
+	return file::map(make_full_path(uri).c_str());
+}
+
 auto FileLoader::read_string(std::string& out, std::string_view const uri) const -> bool { return file::read_string(out, make_full_path(uri).c_str()); }
 
+auto FileLoader::make_watcher() const -> std::unique_ptr<FileWatcher> {
+	auto ret = std::make_unique<FileWatcher>(m_prefix);
+	if (!ret->is_active()) { return {}; }
+	m_watched = true;
+	return ret;
+}
+
 auto FileLoader::make_full_path(std::string_view uri) const -> std::string { return (fs::path{m_prefix} / uri).generic_string(); }
 } // namespace bave
@@ -0,0 +1,206 @@
+#include <bave/io/file_watcher.hpp>
+#include <bave/logger.hpp>
+#include <algorithm>
+#include <filesystem>
+#include <unordered_map>
+#include <utility>
+
+#if defined(__linux__)
+#include <sys/inotify.h>
+#include <unistd.h>
+#include <array>
+#include <cerrno>
+#include <cstring>
+#endif
+
+namespace bave {
+namespace fs = std::filesystem;
+
+namespace {
+auto const g_log = Logger{"FileWatcher"};
+} // namespace
+
+#if defined(__linux__)
+struct FileWatcher::Impl {
+	// IN_IGNORED is always reported.
+	static constexpr std::uint32_t mask_v{IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE | IN_DELETE_SELF | IN_MOVE_SELF};
+
+	int fd{-1};
+	// watch descriptor => directory path relative to root.
+	std::unordered_map<int, std::string> directories{};
+	// file path relative to root => time of last event.
+	std::unordered_map<std::string, Clock::time_point> pending{};
+	// directories whose watches were lost and whose parents are not watched (eg root): re-armed once they exist again.
+	std::vector<std::string> lost{};
+
+	Impl(Impl const&) = delete;
+	Impl(Impl&&) = delete;
+	auto operator=(Impl const&) -> Impl& = delete;
+	auto operator=(Impl&&) -> Impl& = delete;
+
+	explicit Impl(int const fd) : fd(fd) {}
+
+	~Impl() { close(fd); }
+
+	void watch(fs::path const& root, fs::path const& relative) {
+		auto const wd = inotify_add_watch(fd, (root / relative).c_str(), mask_v);
+		if (wd < 0) {
+			g_log.warn("failed to watch directory: '{}'", (root / relative).generic_string());
+			return;
+		}
+		directories.insert_or_assign(wd, relative.generic_string());
+	}
+
+	void add_directory(fs::path const& root, fs::path const& relative, Clock::time_point const now) {
+		watch(root, relative);
+		// files may have been written before the watch was added.
+		auto ec = std::error_code{};
+		for (auto it = fs::recursive_directory_iterator{root / relative, ec}; !ec && it != fs::recursive_directory_iterator{}; it.increment(ec)) {
+			auto const path = fs::relative(it->path(), root);
+			if (it->is_directory()) {
+				watch(root, path);
+			} else {
+				pending.insert_or_assign(path.generic_string(), now);
+			}
+		}
+	}
+
+	[[nodiscard]] static auto is_within(std::string_view const path, std::string_view const directory) -> bool {
+		if (directory.empty()) { return true; }
+		return path.starts_with(directory) && (path.size() == directory.size() || path[directory.size()] == '/');
+	}
+
+	[[nodiscard]] auto is_watched(std::string_view const relative) const -> bool {
+		return std::any_of(directories.begin(), directories.end(), [relative](auto const& it) { return it.second == relative; });
+	}
+
+	// the watched directory was deleted / moved, or its watch removed: a moved directory's watch (and those of its
+	// subdirectories) would keep following it, so all are dropped and re-armed on the path.
+	void unwatch(fs::path const& root, int const wd, Clock::time_point const now) {
+		auto const it = directories.find(wd);
+		if (it == directories.end()) { return; }
+		auto const relative = it->second;
+		for (auto dir = directories.begin(); dir != directories.end();) {
+			if (!is_within(dir->second, relative)) {
+				++dir;
+				continue;
+			}
+			// fails harmlessly if the kernel already removed the watch.
+			inotify_rm_watch(fd, dir->first);
+			dir = directories.erase(dir);
+		}
+
+		if (fs::is_directory(root / relative)) {
+			add_directory(root, relative, now);
+			return;
+		}
+		// a re-created subdirectory is reported by its parent's watch.
+		auto const parent = fs::path{relative}.parent_path().generic_string();
+		if (relative.empty() || !is_watched(parent)) { lost.push_back(relative); }
+	}
+
+	void rearm_lost(fs::path const& root, Clock::time_point const now) {
+		if (lost.empty()) { return; }
+		auto const restore = std::exchange(lost, {});
+		for (auto const& relative : restore) {
+			if (fs::is_directory(root / relative)) {
+				add_directory(root, relative, now);
+			} else {
+				lost.push_back(relative);
+			}
+		}
+	}
+
+	// returns false if there was nothing to read.
+	auto drain(fs::path const& root) -> bool {
+		rearm_lost(root, Clock::now());
+		alignas(inotify_event) auto buffer = std::array<char, 4096>{};
+		auto ret = false;
+		while (true) {
+			auto const length = read(fd, buffer.data(), buffer.size());
+			if (length <= 0) { break; }
+			ret = true;
+			auto const now = Clock::now();
+			// NOLINTBEGIN(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+			for (auto offset = std::size_t{}; offset < static_cast<std::size_t>(length);) {
+				auto event = inotify_event{};
+				std::memcpy(&event, buffer.data() + offset, sizeof(inotify_event));
+				auto const name = event.len > 0 ? std::string_view{buffer.data() + offset + sizeof(inotify_event)} : std::string_view{};
+				offset += sizeof(inotify_event) + event.len;
+
+				if ((event.mask & (IN_IGNORED | IN_DELETE_SELF | IN_MOVE_SELF)) != 0) {
+					unwatch(root, event.wd, now);
+					continue;
+				}
+				if (name.empty()) { continue; }
+
+				auto const it = directories.find(event.wd);
+				if (it == directories.end()) { continue; }
+				auto const path = (fs::path{it->second} / name).generic_string();
+
+				if ((event.mask & IN_ISDIR) != 0) {
+					if ((event.mask & (IN_CREATE | IN_MOVED_TO)) != 0) { add_directory(root, path, now); }
+					continue;
+				}
+				// IN_CREATE alone is followed by IN_CLOSE_WRITE once the file is written.
+				if ((event.mask & IN_CREATE) != 0) { continue; }
+				pending.insert_or_assign(path, now);
+			}
+			// NOLINTEND(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+		}
+		return ret;
+	}
+};
+
+FileWatcher::FileWatcher(std::string root, Seconds const debounce) : m_root(std::move(root)), m_debounce(debounce) {
+	if (!fs::is_directory(m_root)) {
+		g_log.warn("not a directory: '{}'", m_root);
+		return;
+	}
+
+	auto const fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+	if (fd < 0) {
+		g_log.warn("failed to initialize inotify: {}", std::strerror(errno)); // NOLINT(concurrency-mt-unsafe)
+		return;
+	}
+
+	auto impl = std::unique_ptr<Impl, Deleter>{new Impl{fd}};
+	auto const root_path = fs::path{m_root};
+	impl->watch(root_path, {});
+	auto ec = std::error_code{};
+	for (auto it = fs::recursive_directory_iterator{root_path, ec}; !ec && it != fs::recursive_directory_iterator{}; it.increment(ec)) {
+		if (it->is_directory()) { impl->watch(root_path, fs::relative(it->path(), root_path)); }
+	}
+
+	m_impl = std::move(impl);
+	g_log.info("watching '{}' ({} directories)", m_root, m_impl->directories.size());
+}
+
+auto FileWatcher::poll() -> std::vector<std::string> {
+	if (!m_impl) { return {}; }
+	if (!m_impl->drain(m_root) && m_impl->pending.empty()) { return {}; }
+
+	auto ret = std::vector<std::string>{};
+	auto const now = Clock::now();
+	for (auto it = m_impl->pending.begin(); it != m_impl->pending.end();) {
+		if (now - it->second < m_debounce) {
+			++it;
+			continue;
+		}
+		ret.push_back(it->first);
+		it = m_impl->pending.erase(it);
+	}
+	return ret;
+}
+#else
+struct FileWatcher::Impl {};
+
+FileWatcher::FileWatcher(std::string root, Seconds const debounce) : m_root(std::move(root)), m_debounce(debounce) {
+	g_log.warn("file watching not supported on this platform");
+}
+
+auto FileWatcher::poll() -> std::vector<std::string> { return {}; }
+#endif
+
+void FileWatcher::Deleter::operator()(Impl* ptr) const { std::default_delete<Impl>{}(ptr); }
+} // namespace bave
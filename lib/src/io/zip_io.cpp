@@ -1,101 +1,234 @@
-#include <physfs.h>
+#include <stb/stb_image.h>
 #include <bave/core/ptr.hpp>
-#include <bave/core/scoped_resource.hpp>
 #include <bave/core/string_hash.hpp>
+#include <bave/data_store.hpp>
 #include <bave/io/zip_io.hpp>
 #include <bave/logger.hpp>
-#include <src/io/zip_io_reinit.hpp>
+#include <algorithm>
+#include <cstring>
+#include <limits>
 #include <memory>
 #include <mutex>
-#include <optional>
+#include <shared_mutex>
 #include <unordered_map>
 
 namespace bave {
 namespace {
-struct ZipFs {
-	struct Deleter {
-		void operator()(Ptr<PHYSFS_File> file) const noexcept { PHYSFS_close(file); }
-		void operator()(int /*i*/) const noexcept { PHYSFS_deinit(); }
+constexpr std::uint32_t eocd_signature_v{0x06054b50};
+constexpr std::uint32_t cd_signature_v{0x02014b50};
+constexpr std::uint32_t local_signature_v{0x04034b50};
+constexpr std::size_t eocd_size_v{22};
+constexpr std::size_t cd_header_size_v{46};
+constexpr std::size_t local_header_size_v{30};
+constexpr std::size_t max_comment_size_v{0xffff};
+constexpr std::uint32_t zip64_marker_v{0xffffffff};
+
+enum class Method : std::uint16_t { eStored = 0, eDeflate = 8 };
+
+auto read_u16(std::span<std::byte const> bytes, std::size_t const offset) -> std::uint16_t {
+	if (offset + 2 > bytes.size()) { return {}; }
+	return static_cast<std::uint16_t>(static_cast<std::uint16_t>(bytes[offset]) | static_cast<std::uint16_t>(bytes[offset + 1]) << 8);
+}
+
+auto read_u32(std::span<std::byte const> bytes, std::size_t const offset) -> std::uint32_t {
+	if (offset + 4 > bytes.size()) { return {}; }
+	auto ret = std::uint32_t{};
+	for (std::size_t i = 0; i < 4; ++i) { ret |= static_cast<std::uint32_t>(bytes[offset + i]) << (i * 8); }
+	return ret;
+}
+
+/// \brief Immutable index of a ZIP archive's central directory.
+///
+/// All member functions are const and safe to call concurrently.
+class ZipArchive {
+  public:
+	struct Entry {
+		std::size_t data_offset{};
+		std::size_t compressed_size{};
+		std::size_t size{};
+		Method method{};
 	};
 
-	explicit ZipFs(char const* arg0 = nullptr) : m_instance(PHYSFS_init(arg0)) {
-		if (m_instance == 0) { m_log.warn("failed to initialize ZipFs"); }
+	explicit ZipArchive(DataView bytes) : m_bytes(std::move(bytes)) { build_index(); }
+
+	[[nodiscard]] auto is_valid() const -> bool { return m_valid; }
+
+	[[nodiscard]] auto find(std::string_view const path) const -> Ptr<Entry const> {
+		if (auto const it = m_entries.find(path); it != m_entries.end()) { return &it->second; }
+		return {};
+	}
+
+	[[nodiscard]] auto read(std::vector<std::byte>& out, Entry const& entry) const -> bool {
+		auto const compressed = m_bytes.get_bytes().subspan(entry.data_offset, entry.compressed_size);
+		switch (entry.method) {
+		case Method::eStored: out.assign(compressed.begin(), compressed.end()); return true;
+		case Method::eDeflate: return inflate(out, compressed, entry.size);
+		default: return false;
+		}
 	}
 
-	[[nodiscard]] auto is_init() const -> bool { return m_instance != 0; }
+	[[nodiscard]] auto view(Entry const& entry) const -> std::span<std::byte const> {
+		auto const bytes = m_bytes.get_bytes();
+		if (entry.method != Method::eStored || entry.size != entry.compressed_size) { return {}; }
+		if (entry.data_offset > bytes.size() || entry.size > bytes.size() - entry.data_offset) { return {}; }
+		return bytes.subspan(entry.data_offset, entry.size);
+	}
 
   private:
-	Logger m_log{"ZipFs"};
-	ScopedResource<int, Deleter> m_instance{};
+	static auto inflate(std::vector<std::byte>& out, std::span<std::byte const> compressed, std::size_t const size) -> bool {
+		static constexpr auto max_size_v = static_cast<std::size_t>(std::numeric_limits<int>::max());
+		if (size > max_size_v || compressed.size() > max_size_v) { return false; }
+		out.resize(size);
+		if (size == 0) { return true; }
+		// NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+		auto const length = stbi_zlib_decode_noheader_buffer(reinterpret_cast<char*>(out.data()), static_cast<int>(size),
+															   reinterpret_cast<char const*>(compressed.data()), static_cast<int>(compressed.size()));
+		return length == static_cast<int>(size);
+	}
+
+	void build_index() {
+		auto const bytes = m_bytes.get_bytes();
+		if (bytes.size() < eocd_size_v) { return; }
+
+		auto const search_end = bytes.size() > eocd_size_v + max_comment_size_v ? bytes.size() - eocd_size_v - max_comment_size_v : std::size_t{};
+		auto eocd = bytes.size() - eocd_size_v;
+		while (read_u32(bytes, eocd) != eocd_signature_v) {
+			if (eocd == search_end) { return; }
+			--eocd;
+		}
+
+		auto const count = read_u16(bytes, eocd + 10);
+		auto offset = static_cast<std::size_t>(read_u32(bytes, eocd + 16));
+		m_entries.reserve(count);
+
+		for (std::uint16_t i = 0; i < count; ++i) {
+			if (read_u32(bytes, offset) != cd_signature_v) { return; }
+			auto const flags = read_u16(bytes, offset + 8);
+			auto const method = static_cast<Method>(read_u16(bytes, offset + 10));
+			auto const compressed_size = read_u32(bytes, offset + 20);
+			auto const size = read_u32(bytes, offset + 24);
+			auto const name_length = read_u16(bytes, offset + 28);
+			auto const extra_length = read_u16(bytes, offset + 30);
+			auto const comment_length = read_u16(bytes, offset + 32);
+			auto const local_offset = static_cast<std::size_t>(read_u32(bytes, offset + 42));
+			auto const name_start = offset + cd_header_size_v;
+			if (name_start + name_length > bytes.size()) { return; }
+			auto const name = DataStore::as_string_view(bytes.subspan(name_start, name_length));
+			offset = name_start + name_length + extra_length + comment_length;
+
+			if (name.empty() || name.back() == '/') { continue; }
+			if ((flags & 0x1) != 0) {
+				m_log.warn("skipping encrypted entry: '{}'", name);
+				continue;
+			}
+			if (compressed_size == zip64_marker_v || size == zip64_marker_v) {
+				m_log.warn("skipping ZIP64 entry: '{}'", name);
+				continue;
+			}
+			if (method != Method::eStored && method != Method::eDeflate) {
+				m_log.warn("skipping entry with unsupported compression method ({}): '{}'", static_cast<int>(method), name);
+				continue;
+			}
+			if (method == Method::eStored && size != compressed_size) {
+				m_log.warn("skipping stored entry with mismatched sizes ({} / {}): '{}'", size, compressed_size, name);
+				continue;
+			}
+
+			if (read_u32(bytes, local_offset) != local_signature_v) { return; }
+			auto const data_offset =
+				local_offset + local_header_size_v + read_u16(bytes, local_offset + 26) + static_cast<std::size_t>(read_u16(bytes, local_offset + 28));
+			if (data_offset + compressed_size > bytes.size()) { return; }
+
+			m_entries.insert_or_assign(std::string{name}, Entry{
+															  .data_offset = data_offset,
+															  .compressed_size = compressed_size,
+															  .size = size,
+															  .method = method,
+														  });
+		}
+
+		m_valid = true;
+	}
+
+	Logger m_log{"ZipArchive"};
+	DataView m_bytes{};
+	std::unordered_map<std::string, Entry, StringHash, std::equal_to<>> m_entries{};
+	bool m_valid{};
+};
+
+struct Mount {
+	std::string name{};
+	std::shared_ptr<ZipArchive const> archive{};
 };
 
 struct {
-	std::optional<ZipFs> zip_fs{};
-	std::mutex mutex{};
-	std::unordered_map<std::string, std::vector<std::byte>, StringHash, std::equal_to<>> zips{};
-
-	auto ensure_init() -> bool {
-		auto lock = std::scoped_lock{mutex};
-		if (!zip_fs) { zip_fs.emplace(); }
-		return zip_fs->is_init();
-	}
+	// only guards the list of mounts: reads and inflation run without holding it.
+	std::shared_mutex mutex{};
+	std::vector<Mount> mounts{};
 
 	// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
 } g_state{};
 
-auto open_read(CString const path) { return std::unique_ptr<PHYSFS_File, ZipFs::Deleter>{PHYSFS_openRead(path.c_str())}; }
-} // namespace
+struct Found {
+	std::shared_ptr<ZipArchive const> archive{};
+	Ptr<ZipArchive::Entry const> entry{};
 
-auto zip::reinit(CString const arg0) -> bool {
-	auto lock = std::scoped_lock{g_state.mutex};
-	if (g_state.zip_fs) { g_state.zip_fs.reset(); }
-	g_state.zip_fs.emplace(arg0.c_str());
-	return g_state.zip_fs->is_init();
+	explicit operator bool() const { return entry != nullptr; }
+};
+
+auto find(std::string_view const path) -> Found {
+	auto lock = std::shared_lock{g_state.mutex};
+	for (auto const& mount : g_state.mounts) {
+		if (auto const* entry = mount.archive->find(path)) { return Found{.archive = mount.archive, .entry = entry}; }
+	}
+	return {};
 }
+} // namespace
 
-auto zip::mount(std::string name, std::vector<std::byte> zip_bytes) -> bool {
-	if (!g_state.ensure_init()) { return false; }
+auto zip::mount(std::string name, std::vector<std::byte> zip_bytes) -> bool { return mount(std::move(name), DataView::from(std::move(zip_bytes))); }
 
-	if (PHYSFS_mountMemory(zip_bytes.data(), zip_bytes.size(), nullptr, name.c_str(), "", 1) == 0) { return false; }
+auto zip::mount(std::string name, DataView zip_bytes) -> bool {
+	auto archive = std::make_shared<ZipArchive const>(std::move(zip_bytes));
+	if (!archive->is_valid()) { return false; }
 
-	auto lock = std::scoped_lock{g_state.mutex};
-	g_state.zips.insert_or_assign(std::move(name), std::move(zip_bytes));
+	auto lock = std::unique_lock{g_state.mutex};
+	if (std::any_of(g_state.mounts.begin(), g_state.mounts.end(), [&name](Mount const& mount) { return mount.name == name; })) { return false; }
+	g_state.mounts.push_back(Mount{.name = std::move(name), .archive = std::move(archive)});
 	return true;
 }
 
 auto zip::unmount(std::string const& name) -> bool {
-	if (!g_state.ensure_init()) { return false; }
-
-	if (PHYSFS_unmount(name.c_str()) == 0) { return false; }
-
-	auto lock = std::scoped_lock{g_state.mutex};
-	g_state.zips.erase(name);
+	auto lock = std::unique_lock{g_state.mutex};
+	auto const it = std::find_if(g_state.mounts.begin(), g_state.mounts.end(), [&name](Mount const& mount) { return mount.name == name; });
+	if (it == g_state.mounts.end()) { return false; }
+	g_state.mounts.erase(it);
 	return true;
 }
 
 auto zip::is_mounted(std::string_view const name) -> bool {
-	auto lock = std::scoped_lock{g_state.mutex};
-	return g_state.zips.contains(name);
+	auto lock = std::shared_lock{g_state.mutex};
+	return std::any_of(g_state.mounts.begin(), g_state.mounts.end(), [name](Mount const& mount) { return mount.name == name; });
 }
 
-auto zip::exists(CString const path) -> bool {
-	if (!g_state.ensure_init()) { return false; }
-
-	return open_read(path) != nullptr;
-}
+auto zip::exists(CString const path) -> bool { return static_cast<bool>(find(path.as_view())); }
 
 auto zip::read_bytes(std::vector<std::byte>& out, CString const path) -> bool {
-	if (!g_state.ensure_init()) { return false; }
+	auto const found = find(path.as_view());
+	if (!found) { return false; }
+	return found.archive->read(out, *found.entry);
+}
 
-	auto file = open_read(path);
-	if (!file) { return false; }
+auto zip::map(CString const path) -> DataView {
+	auto const found = find(path.as_view());
+	if (!found) { return {}; }
 
-	auto const length = PHYSFS_fileLength(file.get());
-	if (length < 0) { return false; }
+	if (auto const bytes = found.archive->view(*found.entry); !bytes.empty()) {
+		// stored entry: view into the archive, keeping it alive.
+		return DataView{found.archive, bytes};
+	}
 
-	auto const size = static_cast<std::size_t>(length);
-	out.resize(size);
-	PHYSFS_readBytes(file.get(), out.data(), size);
-	return true;
+	auto ret = std::vector<std::byte>{};
+	if (!found.archive->read(ret, *found.entry)) { return {}; }
+	return DataView::from(std::move(ret));
 }
 } // namespace bave
@@ -1,6 +0,0 @@
-#pragma once
-#include <bave/core/c_string.hpp>
-
-namespace bave::zip {
-auto reinit(CString arg0) -> bool;
-}
@@ -0,0 +1,304 @@
+#include <bave/core/ptr.hpp>
+#include <bave/job_system.hpp>
+#include <algorithm>
+#include <deque>
+#include <optional>
+
+namespace bave {
+namespace {
+// identifies the JobSystem and worker index of the current thread, if it is a worker.
+thread_local auto t_system = Ptr<JobSystem const>{}; // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+thread_local auto t_worker = std::size_t{};			 // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+} // namespace
+
+struct JobSystem::Job {
+	Func func{};
+	// unfinished dependencies, +1 while being scheduled.
+	std::atomic<std::size_t> remaining{1};
+	std::mutex mutex{};
+	std::vector<std::shared_ptr<Job>> dependents{};
+	// immutable once scheduled: waiters help with unfinished ones (which are kept alive by their queue or dependencies).
+	std::vector<std::weak_ptr<Job>> dependencies{};
+	std::atomic<bool> done{};
+	// in the deque of worker (guarded by its mutex).
+	std::atomic<bool> queued{};
+	std::size_t worker{};
+	bool main_thread{};
+};
+
+struct JobSystem::Worker {
+	std::mutex mutex{};
+	std::deque<std::shared_ptr<Job>> jobs{};
+	std::thread thread{};
+};
+
+auto JobSystem::Handle::is_done() const -> bool { return !m_job || m_job->done; }
+
+JobSystem::JobSystem(std::size_t thread_count) : m_main_thread(std::this_thread::get_id()) {
+	if (thread_count == 0) { thread_count = std::max(std::thread::hardware_concurrency(), 2u) - 1; }
+	m_workers.reserve(thread_count);
+	for (std::size_t index = 0; index < thread_count; ++index) { m_workers.push_back(std::make_unique<Worker>()); }
+	// workers are only started once all deques exist, as they steal from each other.
+	for (std::size_t index = 0; index < thread_count; ++index) { m_workers[index]->thread = std::thread{&JobSystem::run_worker, this, index}; }
+	m_log.info("{} worker threads", thread_count);
+}
+
+JobSystem::~JobSystem() {
+	{
+		auto lock = std::scoped_lock{m_sleep_mutex};
+		m_stop = true;
+	}
+	m_work_cv.notify_all();
+	for (auto& worker : m_workers) { worker->thread.join(); }
+}
+
+auto JobSystem::schedule(Func func, std::span<Handle const> dependencies) -> Handle { return schedule_job(std::move(func), dependencies, false); }
+
+auto JobSystem::schedule_on_main(Func func, std::span<Handle const> dependencies) -> Handle { return schedule_job(std::move(func), dependencies, true); }
+
+void JobSystem::wait(Handle const& handle) {
+	if (handle.is_done()) { return; }
+	auto const& job = *handle.m_job;
+	if (job.main_thread && is_main_thread()) {
+		m_log.error("cannot wait for a main thread job on the main thread");
+		return;
+	}
+
+	// whether job or any of its unfinished dependencies can be taken and executed here.
+	auto const can_help = [](auto const& self, Job const& target) -> bool {
+		if (target.done || target.main_thread) { return false; }
+		if (target.queued) { return true; }
+		return std::any_of(target.dependencies.begin(), target.dependencies.end(), [&](auto const& weak) {
+			auto const dependency = weak.lock();
+			return dependency && self(self, *dependency);
+		});
+	};
+	while (!job.done) {
+		if (try_help(job)) { continue; }
+		++m_waiters;
+		{
+			auto lock = std::unique_lock{m_sleep_mutex};
+			m_done_cv.wait(lock, [&] { return job.done || can_help(can_help, job); });
+		}
+		--m_waiters;
+	}
+}
+
+void JobSystem::wait_idle() {
+	++m_waiters;
+	{
+		auto lock = std::unique_lock{m_sleep_mutex};
+		m_done_cv.wait(lock, [this] { return m_queued == 0 && m_running == 0; });
+	}
+	--m_waiters;
+}
+
+void JobSystem::parallel_for(std::size_t const count, RangeFunc const& func, std::size_t grain) {
+	if (count == 0) { return; }
+	// a few chunks per thread, so that uneven chunks balance out.
+	if (grain == 0) { grain = std::max(count / ((get_thread_count() + 1) * 4), std::size_t{1}); }
+	auto const chunks = (count + grain - 1) / grain;
+	if (chunks == 1) {
+		func(0, count);
+		return;
+	}
+
+	auto next = std::atomic<std::size_t>{};
+	auto error = std::exception_ptr{};
+	auto error_mutex = std::mutex{};
+	auto const run_chunks = [&] {
+		for (auto chunk = next++; chunk < chunks; chunk = next++) {
+			auto const begin = chunk * grain;
+			try {
+				func(begin, std::min(begin + grain, count));
+			} catch (...) {
+				auto lock = std::scoped_lock{error_mutex};
+				if (!error) { error = std::current_exception(); }
+			}
+		}
+	};
+
+	auto const helper_count = std::min(chunks - 1, get_thread_count());
+	auto helpers = std::vector<Handle>{};
+	helpers.reserve(helper_count);
+	for (std::size_t i = 0; i < helper_count; ++i) { helpers.push_back(schedule(run_chunks)); }
+	run_chunks();
+	// helpers that have not started yet are taken and run (finding no chunks left) by the calling thread.
+	for (auto const& helper : helpers) { wait(helper); }
+
+	if (error) { std::rethrow_exception(error); }
+}
+
+auto JobSystem::run_main_jobs() -> std::size_t {
+	auto ret = std::size_t{};
+	for (auto job = pop_main(); job; job = pop_main()) {
+		execute(*job);
+		++ret;
+	}
+	return ret;
+}
+
+auto JobSystem::schedule_job(Func func, std::span<Handle const> dependencies, bool const main_thread) -> Handle {
+	auto job = std::make_shared<Job>();
+	job->func = std::move(func);
+	job->main_thread = main_thread;
+	for (auto const& dependency : dependencies) {
+		if (!dependency.m_job) { continue; }
+		auto lock = std::scoped_lock{dependency.m_job->mutex};
+		if (dependency.m_job->done) { continue; }
+		dependency.m_job->dependents.push_back(job);
+		job->dependencies.push_back(dependency.m_job);
+		++job->remaining;
+	}
+	release(job);
+	return Handle{std::move(job)};
+}
+
+void JobSystem::release(std::shared_ptr<Job> const& job) {
+	if (--job->remaining == 0) { enqueue(job); }
+}
+
+void JobSystem::enqueue(std::shared_ptr<Job> job) {
+	if (job->main_thread) {
+		auto lock = std::scoped_lock{m_main_mutex};
+		m_main_jobs.push_back(std::move(job));
+		return;
+	}
+
+	// workers push to their own deque, other threads distribute round-robin.
+	auto const index = t_system == this ? t_worker : m_next_worker++ % m_workers.size();
+	// count before pushing, so that a thief never decrements below zero.
+	++m_queued;
+	{
+		auto& worker = *m_workers[index];
+		auto lock = std::scoped_lock{worker.mutex};
+		job->worker = index;
+		job->queued = true;
+		worker.jobs.push_back(std::move(job));
+	}
+	if (m_sleeping > 0) {
+		// synchronize with workers about to sleep, else the notification could be lost.
+		{ auto lock = std::scoped_lock{m_sleep_mutex}; }
+		m_work_cv.notify_one();
+	}
+	notify_waiters();
+}
+
+void JobSystem::execute(Job& job) {
+	try {
+		job.func();
+	} catch (std::exception const& e) {
+		m_log.error("job threw: {}", e.what());
+	} catch (...) { m_log.error("job threw unknown exception"); }
+	job.func = {};
+	complete(job);
+}
+
+void JobSystem::complete(Job& job) {
+	auto dependents = std::vector<std::shared_ptr<Job>>{};
+	{
+		auto lock = std::scoped_lock{job.mutex};
+		job.done = true;
+		std::swap(dependents, job.dependents);
+	}
+	// dependents are queued before this job stops counting as running: wait_idle() never observes a gap.
+	for (auto const& dependent : dependents) { release(dependent); }
+	if (!job.main_thread) { --m_running; }
+	notify_waiters();
+}
+
+auto JobSystem::pop() -> std::shared_ptr<Job> {
+	auto ret = std::shared_ptr<Job>{};
+	auto const is_worker = t_system == this;
+	if (is_worker) {
+		// own deque: LIFO, most recently pushed jobs are likely still hot in cache.
+		auto& worker = *m_workers[t_worker];
+		auto lock = std::scoped_lock{worker.mutex};
+		if (!worker.jobs.empty()) {
+			ret = std::move(worker.jobs.back());
+			worker.jobs.pop_back();
+			ret->queued = false;
+		}
+	}
+	if (!ret) {
+		// steal: FIFO, oldest jobs are likely the largest.
+		auto const start = is_worker ? t_worker + 1 : m_next_worker.load();
+		for (std::size_t offset = 0; offset < m_workers.size() && !ret; ++offset) {
+			auto& victim = *m_workers[(start + offset) % m_workers.size()];
+			auto lock = std::scoped_lock{victim.mutex};
+			if (victim.jobs.empty()) { continue; }
+			ret = std::move(victim.jobs.front());
+			victim.jobs.pop_front();
+			ret->queued = false;
+		}
+	}
+	if (ret) {
+		// count as running before no longer being queued.
+		++m_running;
+		--m_queued;
+	}
+	return ret;
+}
+
+auto JobSystem::pop_main() -> std::shared_ptr<Job> {
+	auto lock = std::scoped_lock{m_main_mutex};
+	if (m_main_jobs.empty()) { return {}; }
+	auto ret = std::move(m_main_jobs.front());
+	m_main_jobs.pop_front();
+	return ret;
+}
+
+auto JobSystem::take(Job const& job) -> std::shared_ptr<Job> {
+	if (job.main_thread || !job.queued) { return {}; }
+	auto& worker = *m_workers[job.worker];
+	auto lock = std::scoped_lock{worker.mutex};
+	// may have been popped since queued was read.
+	auto const it = std::find_if(worker.jobs.begin(), worker.jobs.end(), [&job](auto const& queued) { return queued.get() == &job; });
+	if (it == worker.jobs.end()) { return {}; }
+	auto ret = std::move(*it);
+	worker.jobs.erase(it);
+	ret->queued = false;
+	++m_running;
+	--m_queued;
+	return ret;
+}
+
+auto JobSystem::try_run_one() -> bool {
+	auto job = pop();
+	if (!job) { return false; }
+	execute(*job);
+	return true;
+}
+
+auto JobSystem::try_help(Job const& job) -> bool {
+	if (job.done) { return false; }
+	if (auto taken = take(job)) {
+		execute(*taken);
+		return true;
+	}
+	// not ready (or already started): help with its unfinished dependencies instead.
+	return std::any_of(job.dependencies.begin(), job.dependencies.end(), [this](auto const& weak) {
+		auto const dependency = weak.lock();
+		return dependency && try_help(*dependency);
+	});
+}
+
+void JobSystem::notify_waiters() {
+	if (m_waiters == 0) { return; }
+	{ auto lock = std::scoped_lock{m_sleep_mutex}; }
+	m_done_cv.notify_all();
+}
+
+void JobSystem::run_worker(std::size_t const index) {
+	t_system = this;
+	t_worker = index;
+	while (true) {
+		if (try_run_one()) { continue; }
+		auto lock = std::unique_lock{m_sleep_mutex};
+		++m_sleeping;
+		m_work_cv.wait(lock, [this] { return m_queued > 0 || m_stop; });
+		--m_sleeping;
+		if (m_stop && m_queued == 0) { break; }
+	}
+}
+} // namespace bave
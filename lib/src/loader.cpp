@@ -1,3 +1,4 @@
+#include <bave/graphics/detail/image_uploader.hpp>
 #include <bave/graphics/image_file.hpp>
 #include <bave/io/json_io.hpp>
 #include <bave/loader.hpp>
@@ -13,6 +14,12 @@ constexpr auto get_compression(std::string_view const extension) {
 	if (extension == ".flac") { return Compression::eFlac; }
 	return Compression::eUnknown;
 }
+
+auto make_texture(NotNull<RenderDevice*> render_device, BitmapView const bitmap, bool const mip_map, Ptr<detail::ImageUploader> uploader)
+	-> std::shared_ptr<Texture> {
+	if (uploader == nullptr) { return std::make_shared<Texture>(render_device, bitmap, mip_map); }
+	return std::make_shared<Texture>(render_device, bitmap, mip_map, *uploader);
+}
 } // namespace
 
 Loader::Loader(NotNull<DataStore const*> data_store, NotNull<RenderDevice*> render_device) : m_data_store(data_store), m_render_device(render_device) {}
@@ -30,6 +37,19 @@ auto Loader::load_bytes(std::string_view const uri) const -> std::vector<std::by
 	return ret;
 }
 
+auto Loader::map_bytes(std::string_view const uri) const -> DataView {
+	if (uri.empty()) {
+		m_log.warn("empty URI");
+		return {};
+	}
+	auto ret = m_data_store->map(uri);
+	if (!ret) {
+		m_log.warn("failed to map bytes: '{}'", uri);
+		return {};
+	}
+	return ret;
+}
+
 auto Loader::load_json(std::string_view const uri) const -> dj::Json {
 	if (uri.empty()) {
 		m_log.warn("empty URI");
@@ -67,8 +87,8 @@ auto Loader::load_json_asset(std::string_view const uri, std::string_view const
 }
 
 auto Loader::load_image_file(std::string_view uri) const -> std::optional<ImageFile> {
-	auto const bytes = load_bytes(uri);
-	if (bytes.empty()) { return {}; }
+	auto const bytes = map_bytes(uri);
+	if (!bytes) { return {}; }
 
 	auto ret = ImageFile{};
 	if (!ret.load_from_bytes(bytes)) {
@@ -80,9 +100,27 @@ auto Loader::load_image_file(std::string_view uri) const -> std::optional<ImageF
 	return ret;
 }
 
-auto Loader::load_texture(std::string_view const uri, bool const mip_map) const -> std::shared_ptr<Texture> {
-	auto const bytes = load_bytes(uri);
-	if (bytes.empty()) { return {}; }
+auto Loader::load_texture(std::string_view const uri, bool const mip_map) const -> std::shared_ptr<Texture> { return load_texture(uri, mip_map, {}); }
+
+auto Loader::load_textures(std::span<std::string_view const> uris, bool const mip_map) const -> std::vector<std::shared_ptr<Texture>> {
+	auto ret = std::vector<std::shared_ptr<Texture>>{};
+	ret.reserve(uris.size());
+	auto uploader = detail::ImageUploader{m_render_device};
+	for (auto const uri : uris) { ret.push_back(load_texture(uri, mip_map, &uploader)); }
+	uploader.submit();
+	return ret;
+}
+
+auto Loader::load_texture(std::string_view const uri, bool const mip_map, Ptr<detail::ImageUploader> uploader) const -> std::shared_ptr<Texture> {
+	auto const ktx2_uri = fs::path{uri}.replace_extension(CompressedImage::extension_v).generic_string();
+	if (ktx2_uri == uri || (prefer_compressed && m_data_store->exists(ktx2_uri))) {
+		if (auto ret = load_compressed_texture(ktx2_uri, mip_map, uploader)) { return ret; }
+		if (ktx2_uri == uri) { return {}; }
+		m_log.info("falling back to decoding: '{}'", uri);
+	}
+
+	auto const bytes = map_bytes(uri);
+	if (!bytes) { return {}; }
 
 	auto image_file = ImageFile{};
 	if (!image_file.load_from_bytes(bytes)) {
@@ -90,12 +128,43 @@ auto Loader::load_texture(std::string_view const uri, bool const mip_map) const
 		return {};
 	}
 
-	auto ret = std::make_shared<Texture>(m_render_device, image_file.get_bitmap_view(), mip_map);
+	auto ret = make_texture(m_render_device, image_file.get_bitmap_view(), mip_map, uploader);
 	m_log.info("loaded Texture: '{}'", uri);
 	return ret;
 }
 
-auto Loader::load_texture_9slice(std::string_view const uri) const -> std::shared_ptr<Texture9Slice> {
+auto Loader::load_compressed_texture(std::string_view const uri, bool const mip_map, Ptr<detail::ImageUploader> uploader) const -> std::shared_ptr<Texture> {
+	auto bytes = map_bytes(uri);
+	if (!bytes) { return {}; }
+
+	auto image = CompressedImage{};
+	if (!image.load_from_ktx2(std::move(bytes))) {
+		m_log.warn("failed to load KTX2 (unsupported or supercompressed): '{}'", uri);
+		return {};
+	}
+
+	if (m_render_device->is_sampled_format_supported(image.get_format())) {
+		// block-compressed levels cannot be blitted: only precomputed mips are available.
+		if (mip_map && image.get_levels().size() < 2) { m_log.info("mip_map ignored for KTX2 without precomputed mip levels: '{}'", uri); }
+		auto ret = std::make_shared<Texture>(m_render_device, image);
+		m_log.info("loaded Texture: '{}' (format: {}, {} level(s))", uri, static_cast<int>(image.get_format()), image.get_levels().size());
+		return ret;
+	}
+
+	// uncompressed payloads can be uploaded as a bitmap instead.
+	if (auto const bitmap = image.get_rgba_bitmap(); !bitmap.bytes.empty()) {
+		auto ret = make_texture(m_render_device, bitmap, mip_map, uploader);
+		m_log.info("loaded Texture: '{}'", uri);
+		return ret;
+	}
+
+	m_log.warn("KTX2 format not supported by device: '{}' (format: {})", uri, static_cast<int>(image.get_format()));
+	return {};
+}
+
+auto Loader::load_texture_9slice(std::string_view const uri) const -> std::shared_ptr<Texture9Slice> { return load_texture_9slice(uri, {}); }
+
+auto Loader::load_texture_9slice(std::string_view const uri, Ptr<detail::ImageUploader> uploader) const -> std::shared_ptr<Texture9Slice> {
 	auto json = load_json_asset<Texture9Slice>(uri);
 	if (!json) { return {}; }
 
@@ -105,12 +174,17 @@ auto Loader::load_texture_9slice(std::string_view const uri) const -> std::share
 	auto slice = NineSlice{};
 	from_json(json["nine_slice"], slice);
 
-	auto ret = std::make_shared<Texture9Slice>(m_render_device, image->get_bitmap_view(), slice);
+	auto ret = uploader == nullptr ? std::make_shared<Texture9Slice>(m_render_device, image->get_bitmap_view(), slice)
+								   : std::make_shared<Texture9Slice>(m_render_device, image->get_bitmap_view(), slice, *uploader);
 	m_log.info("loaded Texture9Slice: '{}'", uri);
 	return ret;
 }
 
-auto Loader::load_texture_atlas(std::string_view uri, bool mip_map) const -> std::shared_ptr<TextureAtlas> {
+auto Loader::load_texture_atlas(std::string_view const uri, bool const mip_map) const -> std::shared_ptr<TextureAtlas> {
+	return load_texture_atlas(uri, mip_map, {});
+}
+
+auto Loader::load_texture_atlas(std::string_view const uri, bool const mip_map, Ptr<detail::ImageUploader> uploader) const -> std::shared_ptr<TextureAtlas> {
 	auto json = load_json_asset<TextureAtlas>(uri);
 	if (!json) { return {}; }
 
@@ -120,21 +194,52 @@ auto Loader::load_texture_atlas(std::string_view uri, bool mip_map) const -> std
 	auto sheet = TileSheet{};
 	from_json(json["tile_sheet"], sheet);
 
-	auto ret = std::make_shared<TextureAtlas>(m_render_device, image->get_bitmap_view(), sheet, mip_map);
+	auto ret = uploader == nullptr ? std::make_shared<TextureAtlas>(m_render_device, image->get_bitmap_view(), std::move(sheet), mip_map)
+								   : std::make_shared<TextureAtlas>(m_render_device, image->get_bitmap_view(), std::move(sheet), mip_map, *uploader);
 	m_log.info("loaded TextureAtlas: '{}'", uri);
 	return ret;
 }
 
 auto Loader::load_font(std::string_view const uri, std::span<TextHeight const> preload) const -> std::shared_ptr<Font> {
-	auto const bytes = load_bytes(uri);
-	if (bytes.empty()) { return {}; }
+	return load_font(uri, load_font_bytes(uri), preload);
+}
+
+auto Loader::load_font_bytes(std::string_view const uri) const -> std::vector<std::byte> {
+	// a baked font can be used without the font file.
+	if (fs::path{uri}.extension() == BakedFont::extension_v) { return {}; }
+	if (prefer_baked_fonts && !m_data_store->exists(uri)) { return {}; }
+	return load_bytes(uri);
+}
 
+auto Loader::load_font(std::string_view const uri, std::vector<std::byte> file_bytes, std::span<TextHeight const> preload) const -> std::shared_ptr<Font> {
 	auto ret = std::make_shared<Font>(m_render_device);
-	if (!ret->load_from_bytes(bytes)) {
+
+	auto baked = BakedFont{};
+	auto const baked_uri = fs::path{uri}.replace_extension(BakedFont::extension_v).generic_string();
+	// probe only if opted in: most fonts have no baked sibling.
+	if (baked_uri == uri || (prefer_baked_fonts && m_data_store->exists(baked_uri))) {
+		if (baked.deserialize(m_data_store->map(baked_uri))) {
+			m_log.info("loaded BakedFont: '{}'", baked_uri);
+		} else {
+			m_log.warn("failed to load BakedFont: '{}'", baked_uri);
+		}
+	}
+
+	if (file_bytes.empty() && baked.atlases.empty()) {
 		m_log.warn("failed to load Font: '{}'", uri);
 		return {};
 	}
 
+	if (!file_bytes.empty()) {
+		auto const scale = baked.atlases.empty() ? Font::scale_v : baked.scale;
+		if (!ret->load_from_bytes(std::move(file_bytes), scale)) {
+			m_log.warn("failed to load Font: '{}'", uri);
+			return {};
+		}
+	}
+
+	if (!baked.atlases.empty()) { ret->load_baked(std::move(baked)); }
+
 	for (auto const height : preload) { [[maybe_unused]] auto const glyph = ret->glyph_for(height, {}); }
 
 	m_log.info("loaded Font: '{}'", uri);
@@ -144,7 +249,10 @@ auto Loader::load_font(std::string_view const uri, std::span<TextHeight const> p
 auto Loader::load_audio_clip(std::string_view const uri) const -> std::shared_ptr<AudioClip> {
 	auto const bytes = load_bytes(uri);
 	if (bytes.empty()) { return {}; }
+	return load_audio_clip(uri, bytes);
+}
 
+auto Loader::load_audio_clip(std::string_view const uri, std::span<std::byte const> bytes) const -> std::shared_ptr<AudioClip> {
 	auto const compression = get_compression(fs::path{uri}.extension().string());
 	auto ret = std::make_shared<AudioClip>();
 	if (!ret->load_from_bytes(bytes, compression)) {
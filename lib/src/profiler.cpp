@@ -0,0 +1,177 @@
+#include <bave/io/file_io.hpp>
+#include <bave/logger.hpp>
+#include <bave/profiler.hpp>
+#include <fmt/format.h>
+#include <algorithm>
+#include <iterator>
+
+namespace bave {
+namespace {
+auto const g_log = Logger{"Profiler"};
+
+// log::get_thread_id() locks a mutex: cache it per thread.
+auto get_thread_id() -> int {
+	thread_local auto const s_id = log::get_thread_id();
+	return s_id;
+}
+
+thread_local auto t_depth = int{}; // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+
+auto to_us(Clock::duration const duration) -> double { return std::chrono::duration<double, std::micro>{duration}.count(); }
+
+void append_escaped(std::string& out, std::string_view const name) {
+	for (auto const c : name) {
+		if (c == '"' || c == '\\') { out += '\\'; }
+		out += c;
+	}
+}
+
+void append_event(std::string& out, std::string_view const name, double const ts, double const dur, int const pid, int const tid) {
+	if (out.back() != '[') { out += ",\n"; }
+	out += R"({"name":")";
+	append_escaped(out, name);
+	fmt::format_to(std::back_inserter(out), R"(","ph":"X","ts":{:.3f},"dur":{:.3f},"pid":{},"tid":{}}})", ts, dur, pid, tid);
+}
+} // namespace
+
+auto Profiler::self() -> Profiler& {
+	static auto ret = Profiler{};
+	return ret;
+}
+
+void Profiler::set_enabled(bool const enabled) {
+	auto lock = std::scoped_lock{m_mutex};
+	m_enabled = profiler_v && enabled;
+	// drop the partial frame: it would otherwise span the time spent disabled.
+	m_current.start = {};
+	m_current.cpu.clear();
+	m_current.gpu.clear();
+}
+
+void Profiler::set_max_frames(std::size_t const count) {
+	auto lock = std::scoped_lock{m_mutex};
+	m_max_frames = std::max(count, std::size_t{1});
+	// order oldest first, so frames can be pushed back until full again.
+	std::rotate(m_frames.begin(), m_frames.begin() + static_cast<std::ptrdiff_t>(m_head), m_frames.end());
+	m_head = 0;
+	if (m_frames.size() > m_max_frames) { m_frames.erase(m_frames.begin(), m_frames.end() - static_cast<std::ptrdiff_t>(m_max_frames)); }
+}
+
+auto Profiler::get_max_frames() const -> std::size_t {
+	auto lock = std::scoped_lock{m_mutex};
+	return m_max_frames;
+}
+
+void Profiler::next_frame() {
+	if (!is_enabled()) { return; }
+	auto const now = Clock::now();
+	auto lock = std::scoped_lock{m_mutex};
+	auto const index = m_current.index;
+	if (m_current.start != Clock::time_point{}) {
+		m_current.duration = now - m_current.start;
+		if (m_frames.size() < m_max_frames) {
+			m_frames.push_back(std::move(m_current));
+			m_current = {};
+		} else {
+			// reuse the evicted frame's storage.
+			std::swap(m_frames[m_head], m_current);
+			m_head = (m_head + 1) % m_frames.size();
+			m_current.cpu.clear();
+			m_current.gpu.clear();
+		}
+	}
+	m_current.index = index + 1;
+	m_current.start = now;
+}
+
+auto Profiler::get_frame_index() const -> std::uint64_t {
+	auto lock = std::scoped_lock{m_mutex};
+	return m_current.index;
+}
+
+void Profiler::record(Sample const& sample) {
+	auto lock = std::scoped_lock{m_mutex};
+	m_current.cpu.push_back(sample);
+}
+
+void Profiler::add_gpu_samples(std::uint64_t const frame_index, std::span<GpuSample const> samples) {
+	auto lock = std::scoped_lock{m_mutex};
+	auto* frame = frame_index == m_current.index ? &m_current : nullptr;
+	if (frame == nullptr) {
+		auto const it = std::find_if(m_frames.begin(), m_frames.end(), [frame_index](Frame const& f) { return f.index == frame_index; });
+		if (it == m_frames.end()) { return; }
+		frame = &*it;
+	}
+	frame->gpu.insert(frame->gpu.end(), samples.begin(), samples.end());
+}
+
+auto Profiler::get_frames() const -> std::vector<Frame> {
+	auto lock = std::scoped_lock{m_mutex};
+	auto ret = std::vector<Frame>{};
+	ret.reserve(m_frames.size());
+	for (std::size_t i = 0; i < m_frames.size(); ++i) { ret.push_back(m_frames[(m_head + i) % m_frames.size()]); }
+	return ret;
+}
+
+auto Profiler::get_last_frame() const -> Frame {
+	auto lock = std::scoped_lock{m_mutex};
+	if (m_frames.empty()) { return {}; }
+	return m_frames[(m_head + m_frames.size() - 1) % m_frames.size()];
+}
+
+auto Profiler::get_frame_times() const -> std::vector<float> {
+	auto lock = std::scoped_lock{m_mutex};
+	auto ret = std::vector<float>{};
+	ret.reserve(m_frames.size());
+	for (std::size_t i = 0; i < m_frames.size(); ++i) {
+		auto const& frame = m_frames[(m_head + i) % m_frames.size()];
+		ret.push_back(std::chrono::duration<float, std::milli>{frame.duration}.count());
+	}
+	return ret;
+}
+
+void Profiler::clear() {
+	auto lock = std::scoped_lock{m_mutex};
+	m_frames.clear();
+	m_head = 0;
+}
+
+auto Profiler::to_chrome_trace() const -> std::string {
+	auto const frames = get_frames();
+	auto ret = std::string{R"({"displayTimeUnit":"ms","traceEvents":[)"};
+	ret += R"({"name":"process_name","ph":"M","pid":0,"args":{"name":"CPU"}},)";
+	ret += "\n";
+	ret += R"({"name":"process_name","ph":"M","pid":1,"args":{"name":"GPU"}})";
+	for (auto const& frame : frames) {
+		auto const frame_start = to_us(frame.start - m_epoch);
+		append_event(ret, "frame", frame_start, to_us(frame.duration), 0, 0);
+		for (auto const& sample : frame.cpu) { append_event(ret, sample.name, to_us(sample.start - m_epoch), to_us(sample.duration), 0, sample.thread); }
+		// GPU timelines are aligned to the start of their frame, on a single track: nesting is expressed by start and duration.
+		for (auto const& sample : frame.gpu) { append_event(ret, sample.name, frame_start + to_us(sample.offset), to_us(sample.duration), 1, 0); }
+	}
+	ret += "\n]}\n";
+	return ret;
+}
+
+auto Profiler::write_chrome_trace(CString const path) const -> bool {
+	if (!file::write_string(path, to_chrome_trace())) {
+		g_log.warn("failed to write Chrome trace: '{}'", path.c_str());
+		return false;
+	}
+	g_log.info("Chrome trace written to '{}'", path.c_str());
+	return true;
+}
+
+ProfileScope::ProfileScope(std::string_view const name) : m_name(name), m_active(Profiler::self().is_enabled()) {
+	if (!m_active) { return; }
+	++t_depth;
+	m_start = Clock::now();
+}
+
+ProfileScope::~ProfileScope() {
+	if (!m_active) { return; }
+	auto const duration = Clock::now() - m_start;
+	--t_depth;
+	Profiler::self().record(Profiler::Sample{.name = m_name, .start = m_start, .duration = duration, .depth = t_depth, .thread = get_thread_id()});
+}
+} // namespace bave
@@ -0,0 +1,69 @@
+#include <bave/font/baked_font.hpp>
+#include <test/test.hpp>
+#include <cstdint>
+#include <vector>
+
+namespace {
+using bave::BakedFont;
+using bave::Codepoint;
+using bave::TextHeight;
+
+// every codepoint has a 4x4 glyph.
+struct FakeSlotFactory : bave::detail::GlyphSlot::Factory {
+	auto set_height(TextHeight const height) -> bool final {
+		m_height = height;
+		return true;
+	}
+	[[nodiscard]] auto height() const -> TextHeight final { return m_height; }
+	[[nodiscard]] auto slot_for(Codepoint const codepoint) const -> bave::detail::GlyphSlot final {
+		return bave::detail::GlyphSlot{
+			.pixmap = bave::Pixmap{glm::ivec2{4}, bave::white_v},
+			.advance = {5 << 6, 0},
+			.codepoint = codepoint,
+		};
+	}
+
+	TextHeight m_height{TextHeight::eDefault};
+};
+
+auto make_baked() -> BakedFont {
+	auto factory = FakeSlotFactory{};
+	auto const heights = std::vector<TextHeight>{TextHeight::eDefault};
+	return BakedFont::bake(factory, heights, BakedFont::default_codepoints_v, 1.0f);
+}
+
+void set_i32(std::vector<std::byte>& bytes, std::size_t const offset, std::int32_t const value) {
+	for (std::size_t i = 0; i < 4; ++i) { bytes[offset + i] = static_cast<std::byte>((static_cast<std::uint32_t>(value) >> (i * 8)) & 0xff); }
+}
+
+ADD_TEST(BakedFont_IncludesLastCodepoint) {
+	auto const baked = make_baked();
+	auto const* atlas = baked.find_atlas(TextHeight::eDefault);
+	ASSERT(atlas != nullptr);
+	// ASCII range (inclusive) and tofu.
+	EXPECT(atlas->glyphs.size() == 96);
+	EXPECT(atlas->find_glyph(Codepoint::eTofu) != nullptr);
+	EXPECT(atlas->find_glyph(Codepoint::eAsciiFirst) != nullptr);
+	EXPECT(atlas->find_glyph(Codepoint::eAsciiLast) != nullptr);
+}
+
+ADD_TEST(BakedFont_DeserializeExtent) {
+	auto const bytes = make_baked().serialize();
+	auto baked = BakedFont{};
+	ASSERT(baked.deserialize(bytes));
+	EXPECT(baked.atlases.size() == 1);
+
+	// header: magic, version, scale, atlas count; atlas: height, codepoint range, extent.
+	static constexpr std::size_t extent_offset_v{28};
+
+	auto corrupt = bytes;
+	set_i32(corrupt, extent_offset_v, -1);
+	EXPECT(!baked.deserialize(corrupt));
+
+	// 65536 * 65536 overflows int: must not wrap around to a zero byte alpha read.
+	corrupt = bytes;
+	set_i32(corrupt, extent_offset_v, 65536);
+	set_i32(corrupt, extent_offset_v + 4, 65536);
+	EXPECT(!baked.deserialize(corrupt));
+}
+} // namespace
@@ -0,0 +1,88 @@
+#include <bave/graphics/image_decoder.hpp>
+#include <test/test.hpp>
+#include <array>
+#include <cstdint>
+#include <initializer_list>
+#include <string_view>
+#include <vector>
+
+namespace {
+using namespace bave;
+
+void put(std::vector<std::byte>& out, std::initializer_list<int> const bytes) {
+	for (auto const byte : bytes) { out.push_back(static_cast<std::byte>(byte)); }
+}
+
+void put_u32_be(std::vector<std::byte>& out, std::uint32_t const value) {
+	for (int shift = 24; shift >= 0; shift -= 8) { out.push_back(static_cast<std::byte>((value >> shift) & 0xff)); }
+}
+
+// 1x1 RGBA PNG with the given row filter type, stored (uncompressed) in a single zlib block.
+// chunk CRCs are not verified by PngDecoder, and are left zero.
+auto make_png(std::uint8_t const filter) -> std::vector<std::byte> {
+	auto const row = std::array<std::uint8_t, 5>{filter, 0x10, 0x20, 0x30, 0x40};
+	auto a = std::uint32_t{1};
+	auto b = std::uint32_t{};
+	for (auto const byte : row) {
+		a = (a + byte) % 65521;
+		b = (b + a) % 65521;
+	}
+
+	auto ret = std::vector<std::byte>{};
+	put(ret, {0x89, 'P', 'N', 'G', '\r', '\n', 0x1a, '\n'});
+	put_u32_be(ret, 13);
+	put(ret, {'I', 'H', 'D', 'R', 0, 0, 0, 1, 0, 0, 0, 1, 8, 6, 0, 0, 0, 0, 0, 0, 0});
+	put_u32_be(ret, 17);
+	put(ret, {'I', 'D', 'A', 'T', 0x78, 0x01, 0x01, 0x05, 0x00, 0xfa, 0xff});
+	for (auto const byte : row) { ret.push_back(static_cast<std::byte>(byte)); }
+	put_u32_be(ret, b << 16 | a);
+	put(ret, {0, 0, 0, 0});
+	put_u32_be(ret, 0);
+	put(ret, {'I', 'E', 'N', 'D', 0, 0, 0, 0});
+	return ret;
+}
+
+// 2x1 RGB QOI: one QOI_OP_RGB per pixel, optionally missing the last byte of the second op.
+auto make_qoi(bool const truncated) -> std::vector<std::byte> {
+	auto ret = std::vector<std::byte>{};
+	put(ret, {'q', 'o', 'i', 'f'});
+	put_u32_be(ret, 2);
+	put_u32_be(ret, 1);
+	put(ret, {3, 0});
+	put(ret, {0xfe, 0x10, 0x20, 0x30});
+	if (truncated) {
+		put(ret, {0xfe, 0x40, 0x50});
+	} else {
+		put(ret, {0xfe, 0x40, 0x50, 0x60});
+	}
+	put(ret, {0, 0, 0, 0, 0, 0, 0, 1});
+	return ret;
+}
+
+ADD_TEST(ImageDecoder_PngFilterType) {
+	auto const decoder = PngDecoder{};
+
+	auto const valid = make_png(0);
+	auto const result = decoder.decode(valid);
+	ASSERT(result != nullptr);
+	auto const bitmap = result->get_bitmap_view();
+	ASSERT(bitmap.bytes.size() == 4);
+	EXPECT(bitmap.bytes[0] == std::byte{0x10} && bitmap.bytes[3] == std::byte{0x40});
+
+	// filter types are 0-4.
+	EXPECT(decoder.decode(make_png(5)) == nullptr);
+}
+
+ADD_TEST(ImageDecoder_QoiTruncated) {
+	auto const decoder = QoiDecoder{};
+
+	auto const result = decoder.decode(make_qoi(false));
+	ASSERT(result != nullptr);
+	auto const bitmap = result->get_bitmap_view();
+	ASSERT(bitmap.bytes.size() == 8);
+	EXPECT(bitmap.bytes[4] == std::byte{0x40} && bitmap.bytes[6] == std::byte{0x60} && bitmap.bytes[7] == std::byte{0xff});
+
+	// stream ends within the last op.
+	EXPECT(decoder.decode(make_qoi(true)) == nullptr);
+}
+} // namespace
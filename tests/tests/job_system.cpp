@@ -0,0 +1,126 @@
+#include <bave/job_system.hpp>
+#include <test/test.hpp>
+#include <atomic>
+#include <cstdint>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace {
+using bave::JobSystem;
+
+// occupies a worker until released.
+struct Blocker {
+	std::atomic<bool> started{};
+	std::atomic<bool> released{};
+
+	void block(JobSystem& job_system) {
+		job_system.schedule([this] {
+			started = true;
+			while (!released) { std::this_thread::yield(); }
+		});
+		while (!started) { std::this_thread::yield(); }
+	}
+};
+
+ADD_TEST(JobSystem_WaitRunsOnlyWaitedJob) {
+	auto job_system = JobSystem{1};
+	auto blocker = Blocker{};
+	blocker.block(job_system);
+
+	auto unrelated = std::atomic<bool>{};
+	auto target_thread = std::thread::id{};
+	job_system.schedule([&unrelated] { unrelated = true; });
+	auto const target = job_system.schedule([&target_thread] { target_thread = std::this_thread::get_id(); });
+
+	// the only worker is busy: the target is taken and run here, the unrelated job is left queued.
+	job_system.wait(target);
+	EXPECT(target.is_done());
+	EXPECT(target_thread == std::this_thread::get_id());
+	EXPECT(!unrelated);
+
+	blocker.released = true;
+	job_system.wait_idle();
+	EXPECT(unrelated);
+}
+
+ADD_TEST(JobSystem_WaitRunsDependencies) {
+	auto job_system = JobSystem{1};
+	auto blocker = Blocker{};
+	blocker.block(job_system);
+
+	auto order = std::vector<int>{};
+	auto const first = job_system.schedule([&order] { order.push_back(1); });
+	auto const second = job_system.schedule([&order] { order.push_back(2); }, std::span{&first, 1});
+	auto const third = job_system.schedule([&order] { order.push_back(3); }, std::span{&second, 1});
+
+	// third is not ready: its dependencies are run here first.
+	job_system.wait(third);
+	ASSERT(order.size() == 3);
+	EXPECT(order[0] == 1 && order[1] == 2 && order[2] == 3);
+
+	blocker.released = true;
+	job_system.wait_idle();
+}
+
+ADD_TEST(JobSystem_MainJobs) {
+	auto job_system = JobSystem{2};
+	auto order = std::vector<int>{};
+	auto const worker = job_system.schedule([] {});
+	job_system.schedule_on_main([&order] { order.push_back(1); });
+	// queued once worker completes.
+	job_system.schedule_on_main([&order] { order.push_back(2); }, std::span{&worker, 1});
+
+	// waiting never runs main thread jobs.
+	job_system.wait(worker);
+	job_system.wait_idle();
+	EXPECT(order.empty());
+
+	// in order of readiness.
+	EXPECT(job_system.run_main_jobs() == 2);
+	ASSERT(order.size() == 2);
+	EXPECT(order[0] == 1 && order[1] == 2);
+	EXPECT(job_system.run_main_jobs() == 0);
+}
+
+ADD_TEST(JobSystem_WaitIdle) {
+	auto job_system = JobSystem{3};
+	auto count = std::atomic<int>{};
+	auto previous = JobSystem::Handle{};
+	for (int i = 0; i < 100; ++i) {
+		job_system.schedule([&count] { ++count; });
+		// dependents are queued by the job they depend on.
+		previous = job_system.schedule([&count] { ++count; }, std::span{&previous, 1});
+	}
+	job_system.wait_idle();
+	EXPECT(count == 200);
+	EXPECT(previous.is_done());
+}
+
+ADD_TEST(JobSystem_ParallelFor) {
+	auto job_system = JobSystem{3};
+	auto values = std::vector<int>(10'000);
+	job_system.parallel_for(values.size(), [&values](std::size_t const begin, std::size_t const end) {
+		for (auto i = begin; i < end; ++i) { values[i] = static_cast<int>(i); }
+	});
+	auto sum = std::int64_t{};
+	for (auto const value : values) { sum += value; }
+	EXPECT(sum == std::int64_t{9'999} * 10'000 / 2);
+
+	// nested: a job running parallel_for waits on its own helpers only.
+	auto nested = std::atomic<std::size_t>{};
+	auto const outer = job_system.schedule([&] {
+		job_system.parallel_for(1'000, [&nested](std::size_t const begin, std::size_t const end) { nested += end - begin; }, 10);
+	});
+	job_system.wait(outer);
+	EXPECT(nested == 1'000);
+
+	auto threw = false;
+	try {
+		job_system.parallel_for(100, [](std::size_t const begin, std::size_t /*end*/) {
+			if (begin == 50) { throw std::runtime_error{"test"}; }
+		}, 1);
+	} catch (std::runtime_error const&) { threw = true; }
+	EXPECT(threw);
+}
+} // namespace
@@ -0,0 +1,37 @@
+#include <bave/graphics/particle_system.hpp>
+#include <test/test.hpp>
+
+namespace {
+using bave::ParticleEmitter;
+using bave::ParticleSystem;
+using bave::UvRect;
+
+auto make_emitter(UvRect const& uv) -> ParticleEmitter {
+	auto ret = ParticleEmitter{};
+	ret.config.count = 4;
+	ret.set_uv(uv);
+	return ret;
+}
+
+ADD_TEST(ParticleSystem_BatchesByUv) {
+	auto const left = UvRect{.lt = {0.0f, 0.0f}, .rb = {0.5f, 1.0f}};
+	auto const right = UvRect{.lt = {0.5f, 0.0f}, .rb = {1.0f, 1.0f}};
+
+	// same (null) textures, different regions: drawn separately.
+	auto system = ParticleSystem{};
+	system.emitters.push_back(make_emitter(left));
+	system.emitters.push_back(make_emitter(right));
+	system.tick(bave::Seconds{0.01f});
+	EXPECT(system.get_batch_count() == 2);
+	EXPECT(system.get_baked_instances().size() == 8);
+	// ticking does not reset emitters' UVs.
+	EXPECT(system.emitters[0].get_uv() == left);
+	EXPECT(system.emitters[1].get_uv() == right);
+
+	// same textures and region: one batch.
+	system.emitters[1].set_uv(left);
+	system.tick(bave::Seconds{0.01f});
+	EXPECT(system.get_batch_count() == 1);
+	EXPECT(system.get_baked_instances().size() == 8);
+}
+} // namespace
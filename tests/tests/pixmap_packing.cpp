@@ -0,0 +1,125 @@
+#include <bave/graphics/pixmap.hpp>
+#include <test/test.hpp>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+namespace {
+using namespace bave;
+
+using Packing = Pixmap::Builder::Packing;
+using Layout = Pixmap::Builder::Layout;
+
+constexpr auto pad_v = glm::ivec2{2, 3};
+
+struct Placed {
+	glm::ivec2 lt{};
+	glm::ivec2 rb{};
+};
+
+// deterministic sizes with a spread of aspect ratios.
+auto make_sizes(std::size_t const count) -> std::vector<glm::ivec2> {
+	auto ret = std::vector<glm::ivec2>{};
+	ret.reserve(count);
+	auto state = std::uint32_t{42};
+	auto const next = [&state](int const lo, int const hi) {
+		state = state * 1664525u + 1013904223u;
+		return lo + static_cast<int>((state >> 8) % static_cast<std::uint32_t>(hi - lo + 1));
+	};
+	for (std::size_t i = 0; i < count; ++i) { ret.emplace_back(next(1, 40), next(1, 40)); }
+	return ret;
+}
+
+auto make_rgba(std::size_t const index) -> Rgba {
+	return Rgba{.channels = {static_cast<std::uint8_t>(index + 1), static_cast<std::uint8_t>(index >> 8), 0x80, 0xff}};
+}
+
+auto is_pot(int const size) -> bool { return size > 0 && (size & (size - 1)) == 0; }
+
+auto to_placed(UvRect const& uv, glm::ivec2 const extent) -> Placed {
+	auto const fextent = glm::vec2{extent};
+	auto const lt = glm::ivec2{static_cast<int>(std::lround(uv.lt.x * fextent.x)), static_cast<int>(std::lround(uv.lt.y * fextent.y))};
+	auto const rb = glm::ivec2{static_cast<int>(std::lround(uv.rb.x * fextent.x)), static_cast<int>(std::lround(uv.rb.y * fextent.y))};
+	return Placed{.lt = lt, .rb = rb};
+}
+
+// a's right / bottom padding does not overlap b, or vice versa.
+auto is_separated(Placed const& a, Placed const& b) -> bool {
+	return a.rb.x + pad_v.x <= b.lt.x || b.rb.x + pad_v.x <= a.lt.x || a.rb.y + pad_v.y <= b.lt.y || b.rb.y + pad_v.y <= a.lt.y;
+}
+
+constexpr auto layouts_v = std::array{
+	Layout{.packing = Packing::eShelf},
+	Layout{.packing = Packing::eShelf, .sort_by_height = true},
+	Layout{.packing = Packing::eSkyline},
+	Layout{.packing = Packing::eSkyline, .sort_by_height = true},
+	Layout{.packing = Packing::eMaxRects},
+	Layout{.packing = Packing::eMaxRects, .sort_by_height = true},
+};
+
+ADD_TEST(PixmapPacking_Layouts) {
+	auto const check_layout = [](Layout const& layout, int const max_width) {
+		auto const sizes = make_sizes(96);
+		auto builder = Pixmap::Builder{max_width, pad_v, layout};
+		for (std::size_t i = 0; i < sizes.size(); ++i) { builder.add(static_cast<Pixmap::Builder::Id>(i), Pixmap{sizes[i], make_rgba(i)}); }
+		auto const atlas = builder.build();
+
+		auto const extent = atlas.pixmap.get_extent();
+		ASSERT(atlas.uvs.size() == sizes.size());
+		EXPECT(is_pot(extent.x) && is_pot(extent.y));
+		EXPECT(atlas.stats.count == sizes.size());
+		EXPECT(atlas.stats.total_pixels == std::int64_t{extent.x} * extent.y);
+
+		auto placed = std::vector<Placed>{};
+		auto used_pixels = std::int64_t{};
+		for (std::size_t i = 0; i < sizes.size(); ++i) {
+			auto const it = atlas.uvs.find(static_cast<Pixmap::Atlas::Id>(i));
+			ASSERT(it != atlas.uvs.end());
+			auto const rect = to_placed(it->second, extent);
+			ASSERT(rect.rb - rect.lt == sizes[i]);
+			EXPECT(rect.lt.x >= pad_v.x && rect.lt.y >= pad_v.y);
+			EXPECT(rect.rb.x <= extent.x && rect.rb.y <= extent.y);
+			EXPECT(atlas.pixmap.at({rect.lt.x, rect.lt.y}) == make_rgba(i));
+			EXPECT(atlas.pixmap.at({rect.rb.x - 1, rect.rb.y - 1}) == make_rgba(i));
+			used_pixels += std::int64_t{sizes[i].x} * sizes[i].y;
+			placed.push_back(rect);
+		}
+		EXPECT(atlas.stats.used_pixels == used_pixels);
+
+		for (std::size_t a = 0; a < placed.size(); ++a) {
+			for (std::size_t b = a + 1; b < placed.size(); ++b) { EXPECT(is_separated(placed[a], placed[b])); }
+		}
+	};
+
+	for (auto const& layout : layouts_v) {
+		check_layout(layout, 256);
+		check_layout(layout, 64);
+	}
+}
+
+ADD_TEST(PixmapPacking_ShelfRows) {
+	// two sub-images do not fit in one row of a 16 wide atlas.
+	auto builder = Pixmap::Builder{16, {1, 1}};
+	builder.add(0, Pixmap{{10, 4}, white_v});
+	builder.add(1, Pixmap{{10, 4}, white_v});
+	auto const atlas = builder.build();
+	ASSERT(atlas.uvs.size() == 2);
+	auto const extent = atlas.pixmap.get_extent();
+	auto const first = to_placed(atlas.uvs.at(0), extent);
+	auto const second = to_placed(atlas.uvs.at(1), extent);
+	// rows are separated by 2 * pad.y.
+	auto const expected = std::array{glm::ivec2{1, 1}, glm::ivec2{1, 7}, glm::ivec2{16, 16}};
+	EXPECT(first.lt == expected[0]);
+	EXPECT(second.lt == expected[1]);
+	EXPECT(extent == expected[2]);
+}
+
+ADD_TEST(PixmapPacking_Empty) {
+	auto builder = Pixmap::Builder{64, {1, 1}, Layout{.packing = Packing::eMaxRects}};
+	builder.add(0, Pixmap{glm::ivec2{}});
+	auto const atlas = builder.build();
+	EXPECT(atlas.uvs.empty());
+	EXPECT(atlas.stats.count == 0);
+}
+} // namespace
@@ -0,0 +1,61 @@
+#include <bave/graphics/render_stats.hpp>
+#include <test/test.hpp>
+
+namespace {
+using bave::RenderStats;
+using bave::RenderStatsHistory;
+
+auto make_stats(std::uint64_t const frame) -> RenderStats { return RenderStats{.frame = frame, .draw_calls = frame * 2}; }
+
+ADD_TEST(RenderStatsHistory_Disabled) {
+	auto history = RenderStatsHistory{};
+	history.push(make_stats(1));
+	EXPECT(history.size() == 0);
+	EXPECT(history.get_frames().empty());
+}
+
+ADD_TEST(RenderStatsHistory_Wrap) {
+	auto history = RenderStatsHistory{3};
+	for (std::uint64_t frame = 1; frame <= 5; ++frame) { history.push(make_stats(frame)); }
+	auto const frames = history.get_frames();
+	ASSERT(frames.size() == 3);
+	EXPECT(frames[0].frame == 3);
+	EXPECT(frames[1].frame == 4);
+	EXPECT(frames[2].frame == 5);
+	EXPECT(frames[2].draw_calls == 10);
+}
+
+ADD_TEST(RenderStatsHistory_Resize) {
+	auto history = RenderStatsHistory{4};
+	for (std::uint64_t frame = 1; frame <= 6; ++frame) { history.push(make_stats(frame)); }
+
+	// shrinking keeps the most recent frames.
+	history.set_capacity(2);
+	auto frames = history.get_frames();
+	ASSERT(frames.size() == 2);
+	EXPECT(frames[0].frame == 5);
+	EXPECT(frames[1].frame == 6);
+
+	history.set_capacity(3);
+	history.push(make_stats(7));
+	history.push(make_stats(8));
+	frames = history.get_frames();
+	ASSERT(frames.size() == 3);
+	EXPECT(frames[0].frame == 6);
+	EXPECT(frames[2].frame == 8);
+
+	history.clear();
+	EXPECT(history.size() == 0);
+}
+
+ADD_TEST(RenderStatsHistory_Csv) {
+	auto history = RenderStatsHistory{2};
+	history.push(make_stats(1));
+	history.push(make_stats(2));
+	auto const frames = history.get_frames();
+	auto const csv = bave::to_csv(frames);
+	EXPECT(csv.starts_with(RenderStats::csv_header_v));
+	EXPECT(csv.find("\n1,2,") != std::string::npos);
+	EXPECT(csv.find("\n2,4,") != std::string::npos);
+}
+} // namespace
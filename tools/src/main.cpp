@@ -1,9 +1,14 @@
 #include <bave/desktop_app.hpp>
+#include <tools/bundler.hpp>
+#include <tools/font_baker.hpp>
 #include <tools/runner.hpp>
 
 auto main(int argc, char** argv) -> int {
 	using namespace bave::tools;
 
+	if (argc > 1 && argv[1] == FontBaker::command_v) { return FontBaker{}.run(argc - 1, argv + 1); } // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+	if (argc > 1 && argv[1] == Bundler::command_v) { return Bundler{}.run(argc - 1, argv + 1); }	 // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+
 	auto const dlb = bave::DataLoaderBuilder{argc, argv};
 	auto assets_path = dlb.upfind("assets,example/assets");
 	auto daci = bave::DesktopApp::CreateInfo{
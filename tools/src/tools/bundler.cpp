@@ -0,0 +1,86 @@
+#include <fmt/format.h>
+#include <bave/build_version.hpp>
+#include <bave/clap/clap.hpp>
+#include <bave/graphics/image_file.hpp>
+#include <bave/graphics/raw_image.hpp>
+#include <bave/io/file_io.hpp>
+#include <tools/bundler.hpp>
+#include <algorithm>
+#include <array>
+#include <filesystem>
+
+namespace bave::tools {
+namespace fs = std::filesystem;
+
+namespace {
+constexpr auto image_extensions_v = std::array<std::string_view, 6>{".png", ".qoi", ".jpg", ".jpeg", ".bmp", ".tga"};
+
+auto is_image(fs::path const& path) -> bool {
+	auto const extension = path.extension().string();
+	return std::find(image_extensions_v.begin(), image_extensions_v.end(), extension) != image_extensions_v.end();
+}
+} // namespace
+
+auto Bundler::run(int const argc, char const* const* argv) -> int {
+	auto options = clap::Options{
+		fmt::format("bave-tools {}", command_v),
+		"Pack an assets directory into a bundle, pre-decoding images",
+		to_string(build_version_v),
+	};
+	options.flag(m_keep_images, "keep-images", "store images as-is instead of pre-decoded RGBA")
+		.positional(m_assets_path, "assets", "assets directory")
+		.positional(m_output_path, "output", fmt::format("output file (default: <assets>{})", Bundle::extension_v));
+
+	auto const result = options.parse(argc, argv);
+	if (clap::should_quit(result)) { return clap::return_code(result); }
+
+	if (m_assets_path.empty() || !fs::is_directory(m_assets_path)) {
+		m_log.error("assets directory not specified / found: '{}'", m_assets_path);
+		return EXIT_FAILURE;
+	}
+	if (m_output_path.empty()) {
+		auto assets = fs::path{m_assets_path}.lexically_normal();
+		// "assets/" has an empty filename: use "assets".
+		if (assets.filename().empty()) { assets = assets.parent_path(); }
+		m_output_path = assets.replace_extension(Bundle::extension_v).string();
+	}
+
+	return build() ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+auto Bundler::build() const -> bool {
+	auto builder = Bundle::Builder{};
+	auto decoded = std::size_t{};
+	auto const root = fs::path{m_assets_path};
+	for (auto const& it : fs::recursive_directory_iterator{root}) {
+		if (!it.is_regular_file()) { continue; }
+		auto const path = it.path().generic_string();
+		auto bytes = std::vector<std::byte>{};
+		if (!file::read_bytes(bytes, path.c_str())) {
+			m_log.error("failed to read file: '{}'", path);
+			return false;
+		}
+
+		if (!m_keep_images && is_image(it.path())) {
+			auto image = ImageFile{};
+			if (image.load_from_bytes(std::span<std::byte const>{bytes})) {
+				bytes = RawImage::encode(image.get_bitmap_view());
+				++decoded;
+			} else {
+				m_log.warn("failed to decode image, storing as-is: '{}'", path);
+			}
+		}
+
+		builder.add(fs::relative(it.path(), root).generic_string(), std::move(bytes));
+	}
+
+	auto const bytes = builder.build();
+	if (!file::write_bytes(m_output_path.c_str(), bytes)) {
+		m_log.error("failed to write Bundle: '{}'", m_output_path);
+		return false;
+	}
+
+	m_log.info("saved Bundle to '{}': {} entries ({} images pre-decoded), {} KiB", m_output_path, builder.get_count(), decoded, bytes.size() / 1024);
+	return true;
+}
+} // namespace bave::tools
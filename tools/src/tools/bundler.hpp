@@ -0,0 +1,25 @@
+#pragma once
+#include <bave/io/bundle.hpp>
+#include <bave/logger.hpp>
+#include <string>
+
+namespace bave::tools {
+/// \brief Command line mode that packs an assets directory into a Bundle.
+///
+/// Usage: bave-tools bundle [OPTION]... <assets> [output]
+class Bundler {
+  public:
+	static constexpr std::string_view command_v{"bundle"};
+
+	auto run(int argc, char const* const* argv) -> int;
+
+  private:
+	auto build() const -> bool;
+
+	Logger m_log{"Bundler"};
+
+	std::string m_assets_path{};
+	std::string m_output_path{};
+	bool m_keep_images{};
+};
+} // namespace bave::tools
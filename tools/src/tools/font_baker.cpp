@@ -0,0 +1,71 @@
+#include <fmt/format.h>
+#include <bave/build_version.hpp>
+#include <bave/clap/clap.hpp>
+#include <bave/font/detail/font_library.hpp>
+#include <bave/io/file_io.hpp>
+#include <tools/font_baker.hpp>
+#include <filesystem>
+
+namespace bave::tools {
+namespace fs = std::filesystem;
+
+auto FontBaker::run(int const argc, char const* const* argv) -> int {
+	auto was_passed = bool{};
+	auto options = clap::Options{
+		fmt::format("bave-tools {}", command_v),
+		"Bake font atlases for a set of text heights into a binary file",
+		to_string(build_version_v),
+	};
+	options.optional(m_heights, was_passed, "height", fmt::format("text height to bake (repeatable, default: {})", static_cast<int>(TextHeight::eDefault)), "int")
+		.optional(m_first, was_passed, "first", "first codepoint to bake", "int")
+		.optional(m_last, was_passed, "last", "last codepoint to bake", "int")
+		.optional(m_scale, was_passed, "scale", "scale factor for glyph rasterization", "float")
+		.positional(m_font_path, "font", "font file (TTF / OTF)")
+		.positional(m_output_path, "output", fmt::format("output file (default: <font>{})", BakedFont::extension_v));
+
+	auto const result = options.parse(argc, argv);
+	if (clap::should_quit(result)) { return clap::return_code(result); }
+
+	if (m_font_path.empty()) {
+		m_log.error("font file not specified");
+		return EXIT_FAILURE;
+	}
+	if (m_output_path.empty()) { m_output_path = fs::path{m_font_path}.replace_extension(BakedFont::extension_v).string(); }
+	if (m_heights.empty()) { m_heights.push_back(static_cast<int>(TextHeight::eDefault)); }
+
+	return bake() ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+auto FontBaker::bake() const -> bool {
+	auto bytes = std::vector<std::byte>{};
+	if (!file::read_bytes(bytes, m_font_path.c_str())) {
+		m_log.error("failed to read font file: '{}'", m_font_path);
+		return false;
+	}
+
+	auto const library = detail::FontLibrary::make();
+	auto const slot_factory = library->load(std::move(bytes));
+	if (!slot_factory) {
+		m_log.error("failed to load font: '{}'", m_font_path);
+		return false;
+	}
+
+	auto heights = std::vector<TextHeight>{};
+	heights.reserve(m_heights.size());
+	for (auto const height : m_heights) { heights.push_back(static_cast<TextHeight>(height)); }
+	auto const codepoints = InclusiveRange<Codepoint>{.lo = static_cast<Codepoint>(m_first), .hi = static_cast<Codepoint>(m_last)};
+
+	auto const baked = BakedFont::bake(*slot_factory, heights, codepoints, m_scale);
+	for (auto const& atlas : baked.atlases) {
+		m_log.info("baked height {}: {} glyphs, {}x{} atlas", static_cast<int>(atlas.height), atlas.glyphs.size(), atlas.extent.x, atlas.extent.y);
+	}
+
+	if (!file::write_bytes(m_output_path.c_str(), baked.serialize())) {
+		m_log.error("failed to write BakedFont: '{}'", m_output_path);
+		return false;
+	}
+
+	m_log.info("saved BakedFont to '{}'", m_output_path);
+	return true;
+}
+} // namespace bave::tools
@@ -0,0 +1,29 @@
+#pragma once
+#include <bave/font/baked_font.hpp>
+#include <bave/logger.hpp>
+#include <string>
+#include <vector>
+
+namespace bave::tools {
+/// \brief Command line mode that bakes font atlases into a BakedFont file.
+///
+/// Usage: bave-tools bake-font [OPTION]... <font> [output]
+class FontBaker {
+  public:
+	static constexpr std::string_view command_v{"bake-font"};
+
+	auto run(int argc, char const* const* argv) -> int;
+
+  private:
+	auto bake() const -> bool;
+
+	Logger m_log{"FontBaker"};
+
+	std::string m_font_path{};
+	std::string m_output_path{};
+	std::vector<int> m_heights{};
+	int m_first{static_cast<int>(BakedFont::default_codepoints_v.lo)};
+	int m_last{static_cast<int>(BakedFont::default_codepoints_v.hi)};
+	float m_scale{BakedFont::default_scale_v};
+};
+} // namespace bave::tools